@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+// Copy a timeline before every edit, like an undo stack does.
+const { bench, largeTimelineJSON } = require('./utils')
+
+module.exports = async function (lib) {
+    const trackCount = 4
+    const clipsPerTrack = 2500
+    const timeline = lib.SerializableObject.from_json_string(largeTimelineJSON(trackCount, clipsPerTrack))
+
+    bench(`JSON round trip (${trackCount}x${clipsPerTrack} clips)`, 3, () => {
+        lib.SerializableObject.from_json_string(timeline.to_json_string(0)).delete()
+    })
+    bench(`clone_otio (${trackCount}x${clipsPerTrack} clips)`, 3, () => {
+        timeline.clone_otio().delete()
+    })
+
+    const tracks = timeline.tracks().get_children()
+    const clip = tracks.get(0).get_children().get(0)
+    const store = new lib.SnapshotStore()
+    const snapshots = [store.take(timeline)]
+    let edits = 0
+    bench('SnapshotStore.take (one change)', 20, () => {
+        clip.name = `edit ${edits++}`
+        snapshots.push(store.take(timeline))
+    })
+    // Every snapshot after the first one only adds the path to the clip.
+    console.log(`  ${snapshots.length} snapshots share ${store.node_count()} copies`)
+
+    snapshots.forEach(snapshot => snapshot.delete())
+    store.delete()
+    tracks.delete()
+    lib.clear_content_hash_cache()
+    timeline.delete()
+}
@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+// Compare two copies of a timeline, field by field and through their hashes.
+const { bench, largeTimelineJSON } = require('./utils')
+
+module.exports = async function (lib) {
+    const trackCount = 4
+    const clipsPerTrack = 500
+    const json = largeTimelineJSON(trackCount, clipsPerTrack)
+    const timeline = lib.SerializableObject.from_json_string(json)
+    const other = lib.SerializableObject.from_json_string(json)
+
+    // Equal hashes make the timelines equivalent without comparing them.
+    bench(`is_equivalent_to (${trackCount}x${clipsPerTrack} clips)`, 5, () => {
+        timeline.is_equivalent_to(other)
+    })
+    bench(`content_hash (${trackCount}x${clipsPerTrack} clips, cached)`, 5, () => {
+        timeline.content_hash()
+    })
+
+    const tracks = other.tracks().get_children()
+    const clip = tracks.get(0).get_children().get(clipsPerTrack - 1)
+    let renames = 0
+    bench('content_hash (one change)', 5, () => {
+        clip.name = `renamed ${renames++}`
+        other.content_hash()
+    })
+    bench('is_equivalent_to (one change)', 5, () => {
+        timeline.is_equivalent_to(other)
+    })
+
+    tracks.delete()
+    lib.clear_content_hash_cache()
+    timeline.delete()
+    other.delete()
+}
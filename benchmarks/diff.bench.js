@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+// Diff two versions of a large timeline, natively and as JSON text.
+const { bench, largeTimelineJSON } = require('./utils')
+
+module.exports = async function (lib) {
+    const trackCount = 10
+    const clipsPerTrack = 10000
+    const json = largeTimelineJSON(trackCount, clipsPerTrack)
+    const timeline = lib.SerializableObject.from_json_string(json)
+    const other = lib.SerializableObject.from_json_string(json)
+
+    const tracks = other.tracks().get_children()
+    const track = tracks.get(3)
+    const clip = track.get_children().get(clipsPerTrack / 2)
+    clip.name = 'renamed'
+    track.remove_child(10)
+
+    bench(`JSON text (${trackCount}x${clipsPerTrack} clips)`, 1, () => {
+        const lhs = timeline.to_json_string(0).split('\n')
+        const rhs = other.to_json_string(0).split('\n')
+        let changed = 0
+        for (let i = 0; i < Math.min(lhs.length, rhs.length); i++) {
+            if (lhs[i] !== rhs[i]) {
+                changed++
+            }
+        }
+        void changed
+    })
+    // The first diff computes every content hash, the next ones reuse them.
+    bench(`diff (${trackCount}x${clipsPerTrack} clips, first)`, 1, () => {
+        lib.diff(timeline, other)
+    })
+    bench(`diff (${trackCount}x${clipsPerTrack} clips, cached)`, 5, () => {
+        lib.diff(timeline, other)
+    })
+
+    tracks.delete()
+    lib.clear_content_hash_cache()
+    timeline.delete()
+    other.delete()
+}
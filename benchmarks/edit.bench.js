@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+// Editorial operations in the middle of a long track. Each one is undone so
+// that every run edits the same track.
+const { bench, largeTimelineJSON } = require('./utils')
+
+module.exports = async function (lib) {
+    const clipsPerTrack = 10000
+    // A quarter of the way, a clip is replaced by a gap for fill().
+    const gapIndex = clipsPerTrack / 4
+    const json = JSON.parse(largeTimelineJSON(1, clipsPerTrack))
+    const clips = json.tracks.children[0].children
+    const gapStart = clips.slice(0, gapIndex).reduce((sum, clip) => sum + clip.source_range.duration.value, 0)
+    clips[gapIndex] = {
+        'OTIO_SCHEMA': 'Gap.1',
+        'metadata': {},
+        'name': '',
+        'source_range': clips[gapIndex].source_range,
+        'effects': [],
+        'markers': [],
+        'enabled': true
+    }
+    const timeline = lib.SerializableObject.from_json_string(JSON.stringify(json))
+    const tracks = timeline.tracks().get_children()
+    const track = tracks.get(0)
+    const children = track.get_children()
+    const middle = children.get(clipsPerTrack / 2)
+    const time = track.trimmed_range().duration.value / 2
+    const at = new lib.RationalTime(time + 0.5, 24)
+    const delta = new lib.RationalTime(6, 24)
+    const zero = new lib.RationalTime(0, 24)
+    const inGap = new lib.RationalTime(gapStart + 6, 24)
+
+    function makeClip(name) {
+        const clip = new lib.Clip(name)
+        clip.source_range = new lib.TimeRange(zero, new lib.RationalTime(240, 24))
+        return clip
+    }
+
+    const journal = new lib.Journal()
+    journal.start()
+    function run(name, edit) {
+        bench(`${name} (${clipsPerTrack} clips)`, 20, () => {
+            edit().delete()
+            journal.undo()
+        })
+    }
+
+    run('slice', () => track.slice(at))
+    run('insert', () => track.insert(makeClip('inserted'), at))
+    run('overwrite', () => track.overwrite(makeClip('overwritten'), at))
+    run('slip', () => track.slip(middle, delta))
+    run('slide', () => track.slide(middle, delta))
+    run('ripple', () => track.ripple(middle, delta, delta))
+    run('roll', () => track.roll(middle, delta, delta))
+    run('fill', () => track.fill(makeClip('filled'), inGap, lib.ReferencePoint.source))
+    journal.stop()
+
+    journal.delete()
+    children.delete()
+    tracks.delete()
+    timeline.delete()
+}
@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+// Compare to_json_file/from_json_file between a default (MEMFS) build and a
+// NODERAWFS build (make build NODERAWFS=ON). With MEMFS, files have to be
+// copied between the host and the in-memory filesystem, which is included in
+// the timings so that both modes measure a real save/load to disk.
+const fs = require('fs')
+const os = require('os')
+const path = require('path')
+const { bench, heapSizeMiB, largeTimelineJSON } = require('./utils')
+
+module.exports = async function (lib) {
+    const backend = lib.filesystem_backend()
+    const hostPath = path.join(os.tmpdir(), 'otio_file_io_bench.otio')
+    const memfsPath = '/tmp/otio_file_io_bench.otio'
+
+    const timeline = lib.SerializableObject.from_json_string(largeTimelineJSON(8, 5000))
+
+    let save
+    let load
+    if (backend === 'NODERAWFS') {
+        save = () => timeline.to_json_file(hostPath, 4)
+        load = () => lib.SerializableObject.from_json_file(hostPath).delete()
+    } else {
+        save = () => {
+            timeline.to_json_file(memfsPath, 4)
+            fs.writeFileSync(hostPath, lib.FS.readFile(memfsPath))
+            lib.FS.unlink(memfsPath)
+        }
+        load = () => {
+            lib.FS.writeFile(memfsPath, fs.readFileSync(hostPath))
+            lib.SerializableObject.from_json_file(memfsPath).delete()
+            lib.FS.unlink(memfsPath)
+        }
+    }
+
+    save()
+    const sizeMiB = fs.statSync(hostPath).size / (1024 * 1024)
+
+    const saveMs = bench(`${backend}: to_json_file`, 3, save)
+    const loadMs = bench(`${backend}: from_json_file`, 3, load)
+
+    console.log(`File size: ${sizeMiB.toFixed(1)} MiB`)
+    console.log(`Save throughput: ${(sizeMiB / (saveMs / 1000)).toFixed(1)} MiB/s`)
+    console.log(`Load throughput: ${(sizeMiB / (loadMs / 1000)).toFixed(1)} MiB/s`)
+    console.log(`WASM heap: ${heapSizeMiB(lib)} MiB`)
+
+    fs.unlinkSync(hostPath)
+    timeline.delete()
+}
@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+// Ownership of the objects held by JS: wrappers and plain handles.
+const { bench, largeTimelineJSON } = require('./utils')
+
+module.exports = async function (lib) {
+    const clipsPerTrack = 10000
+    const timeline = lib.SerializableObject.from_json_string(largeTimelineJSON(1, clipsPerTrack))
+    const tracks = timeline.tracks().get_children()
+    const children = tracks.get(0).get_children()
+    const clips = []
+    for (let i = 0; i < children.size(); i++) {
+        clips.push(children.get(i))
+    }
+
+    bench(`new Clip + delete (${clipsPerTrack} clips)`, 5, () => {
+        for (let i = 0; i < clipsPerTrack; i++) {
+            new lib.Clip('clip').delete()
+        }
+    })
+
+    const handles = new Uint32Array(clipsPerTrack)
+    bench(`acquire + release handles (${clipsPerTrack} clips)`, 5, () => {
+        for (let i = 0; i < clipsPerTrack; i++) {
+            handles[i] = clips[i].acquire_handle()
+        }
+        for (let i = 0; i < clipsPerTrack; i++) {
+            lib.release_handle(handles[i])
+        }
+    })
+
+    children.delete()
+    tracks.delete()
+    timeline.delete()
+}
@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+// Generate the URLs of a 2000 frame image sequence one by one and in a batch.
+const { bench } = require('./utils')
+
+module.exports = async function (lib) {
+    const count = 2000
+    const range = new lib.TimeRange(new lib.RationalTime(0, 24), new lib.RationalTime(count, 24))
+    const bounds = new lib.Box2d()
+    const ref = new lib.ImageSequenceReference(
+        'file:///shots/sh010', 'sh010.', '.exr', 1001, 1, 24, 4,
+        lib.MissingFramePolicy.error, range, {}, bounds
+    )
+
+    bench(`target_url_for_image_number x${count}`, 5, () => {
+        for (let i = 0; i < count; i++) {
+            ref.target_url_for_image_number(i)
+        }
+    })
+    bench(`target_urls_for_range(0, ${count})`, 5, () => {
+        ref.target_urls_for_range(0, count)
+    })
+
+    const times = new Float64Array(count)
+    for (let i = 0; i < count; i++) {
+        times[i] = i
+    }
+    bench(`frame_for_time x${count}`, 5, () => {
+        for (const value of times) {
+            const time = new lib.RationalTime(value, 24)
+            ref.frame_for_time(time)
+            time.delete()
+        }
+    })
+    bench(`frames_for_times (${count})`, 5, () => {
+        ref.frames_for_times(times, 24)
+    })
+
+    ref.delete()
+    bounds.delete()
+    range.delete()
+}
@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+// Undo and redo an edit of every clip of a track, like a ripple does.
+const { bench, largeTimelineJSON } = require('./utils')
+
+module.exports = async function (lib) {
+    const clipsPerTrack = 10000
+    const timeline = lib.SerializableObject.from_json_string(largeTimelineJSON(1, clipsPerTrack))
+    const tracks = timeline.tracks().get_children()
+    const children = tracks.get(0).get_children()
+    const clips = []
+    for (let i = 0; i < children.size(); i++) {
+        clips.push(children.get(i))
+    }
+
+    const journal = new lib.Journal()
+    journal.start()
+    let edits = 0
+    bench(`record (${clipsPerTrack} source ranges)`, 5, () => {
+        journal.begin_group()
+        const offset = new lib.RationalTime(edits++ % 24, 24)
+        for (const clip of clips) {
+            const range = clip.source_range
+            clip.source_range = new lib.TimeRange(offset, range.duration)
+        }
+        journal.end_group()
+    })
+    console.log(`  ${journal.undo_count()} steps use ${journal.memory_usage()} bytes`)
+    bench(`undo + redo (${clipsPerTrack} source ranges)`, 20, () => {
+        journal.undo()
+        journal.redo()
+    })
+    journal.stop()
+
+    journal.delete()
+    children.delete()
+    tracks.delete()
+    timeline.delete()
+}
@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+const { bench } = require('./utils')
+
+module.exports = async function (lib) {
+    const count = 100000
+    const step = new lib.RationalTime(1, 24)
+    const limit = new lib.RationalTime(count * 2, 24)
+
+    function run(add, lessThan) {
+        let time = new lib.RationalTime(0, 24)
+        for (let i = 0; i < count; i++) {
+            const next = add.call(time, step)
+            time.delete()
+            time = next
+            lessThan.call(time, limit)
+        }
+        time.delete()
+    }
+
+    const proto = lib.RationalTime.prototype
+    bench('RationalTime add + lessThan (dispatch)', 3, () => run(proto.add, proto.lessThan))
+    bench('RationalTime add + lessThan (typed)', 3, () => run(proto._add_typed, proto._lessThan_typed))
+    bench('RationalTime add + lessThan (dynamic)', 3, () => run(proto._add_dynamic, proto._lessThan_dynamic))
+
+    step.delete()
+    limit.delete()
+}
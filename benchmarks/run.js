@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+/* global process, __dirname */
+
+// Run every *.bench.js file of this directory, or the ones given on the
+// command line: node benchmarks/run.js serialization
+const fs = require('fs')
+const path = require('path')
+const opentimelineioFactory = require('../install/opentimelineio')
+
+async function main() {
+    const filters = process.argv.slice(2)
+    const files = fs.readdirSync(__dirname)
+        .filter(file => file.endsWith('.bench.js'))
+        .filter(file => filters.length === 0 || filters.some(filter => file.includes(filter)))
+        .sort()
+
+    for (const file of files) {
+        console.log(`\n# ${file}`)
+        // Use a fresh module per file so that heap sizes are comparable.
+        const lib = await opentimelineioFactory()
+        await require(path.join(__dirname, file))(lib)
+    }
+}
+
+main()
@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+const { bench, heapSizeMiB, largeTimelineJSON } = require('./utils')
+
+module.exports = async function (lib) {
+    const json = largeTimelineJSON(8, 5000)
+    const timeline = lib.SerializableObject.from_json_string(json)
+
+    const binary = timeline.to_binary()
+    const bytes = binary.copy()
+    binary.delete()
+    console.log(`JSON size: ${json.length} bytes, binary size: ${bytes.length} bytes`)
+
+    bench('save: to_json_string', 5, () => {
+        timeline.to_json_string(4)
+    })
+    bench('save: to_json_bytes', 5, () => {
+        timeline.to_json_bytes(4).delete()
+    })
+    bench('save: serialize_json_to_sink', 5, () => {
+        lib.serialize_json_to_sink(timeline, () => {}, { indent: 4 })
+    })
+    bench('save: to_binary', 5, () => {
+        timeline.to_binary().delete()
+    })
+    bench('load: from_json_string', 5, () => {
+        lib.SerializableObject.from_json_string(json).delete()
+    })
+    bench('load: from_binary', 5, () => {
+        lib.SerializableObject.from_binary(bytes).delete()
+    })
+
+    console.log(`WASM heap: ${heapSizeMiB(lib)} MiB`)
+    timeline.delete()
+}
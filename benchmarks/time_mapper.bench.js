@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+// Map a second of playback (per frame) through a track with a time warp, by
+// hand in JS and with TimeMapper.
+const { bench } = require('./utils')
+
+module.exports = async function (lib) {
+    const range = new lib.TimeRange(new lib.RationalTime(100, 24), new lib.RationalTime(48, 24))
+    const item = new lib.Item('item', range)
+    const track = new lib.Track()
+    track.append_child(item)
+    const warp = new lib.LinearTimeWarp('speed', 2)
+    const effects = item.get_effects()
+    effects.push(warp)
+    effects.delete()
+
+    const frames = new Float64Array(24)
+    for (let i = 0; i < frames.length; i++) {
+        frames[i] = i
+    }
+
+    const iterations = 1000
+    bench(`walk the effects in JS x${iterations}`, 5, () => {
+        for (let n = 0; n < iterations; n++) {
+            const start = item.trimmed_range().start_time.value
+            const offset = start - item.range_in_parent().start_time.value
+            const effects = item.get_effects()
+            for (const frame of frames) {
+                let time = frame + offset
+                for (let e = 0; e < effects.length; e++) {
+                    const effect = effects.at(e)
+                    if (effect instanceof lib.LinearTimeWarp) {
+                        time = start + (time - start) * effect.time_scalar
+                    }
+                }
+            }
+            effects.delete()
+        }
+    })
+
+    const mapper = new lib.TimeMapper(item)
+    const output = new Float64Array(frames.length)
+    bench(`TimeMapper.map_into x${iterations}`, 5, () => {
+        for (let n = 0; n < iterations; n++) {
+            mapper.map_into(frames, 24, 24, output)
+        }
+    })
+
+    mapper.delete()
+    item.delete()
+    track.delete()
+    range.delete()
+}
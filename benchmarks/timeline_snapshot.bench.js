@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+// Read what a timeline view draws, property by property and as columns.
+const { bench, largeTimelineJSON } = require('./utils')
+
+module.exports = async function (lib) {
+    const trackCount = 4
+    const clipsPerTrack = 500
+    const timeline = lib.SerializableObject.from_json_string(largeTimelineJSON(trackCount, clipsPerTrack))
+    const tracks = timeline.tracks().get_children()
+
+    bench(`getters (${trackCount}x${clipsPerTrack} clips)`, 5, () => {
+        for (let t = 0; t < tracks.size(); t++) {
+            const children = tracks.get(t).get_children()
+            let position = 0
+            for (let c = 0; c < children.size(); c++) {
+                const child = children.get(c)
+                const range = child.trimmed_range()
+                void [t, child.name, child.enabled, child.media_reference().schema_name(), position]
+                position += range.duration.value
+                range.delete()
+            }
+            children.delete()
+        }
+    })
+    bench(`snapshot_columns (${trackCount}x${clipsPerTrack} clips)`, 5, () => {
+        timeline.snapshot_columns()
+    })
+
+    const generation = timeline.snapshot_columns().generation
+    tracks.get(0).get_children().get(clipsPerTrack - 1).name = 'renamed'
+    bench('snapshot_columns_since (one change)', 5, () => {
+        timeline.snapshot_columns_since(generation)
+    })
+
+    tracks.delete()
+    timeline.delete()
+}
@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+const { bench } = require('./utils')
+
+module.exports = async function (lib) {
+    const count = 5000
+    const starts = []
+    const durations = []
+    for (let i = 0; i < count; i++) {
+        starts.push(i * 10)
+        durations.push(5 + (i % 20))
+    }
+
+    const buffer = lib.TimeRangeBuffer.from_arrays(starts, durations, 24)
+    const ranges = []
+    for (let i = 0; i < count; i++) {
+        ranges.push(buffer.at(i))
+    }
+    const probe = new lib.TimeRange(new lib.RationalTime(20000, 24), new lib.RationalTime(500, 24))
+
+    bench(`overlaps with one range, TimeRange x${count}`, 5, () => {
+        for (const range of ranges) {
+            range.overlaps(probe, 0)
+        }
+    })
+    bench(`overlaps with one range, TimeRangeBuffer x${count}`, 5, () => {
+        buffer.overlaps_range(probe, 0)
+    })
+
+    bench(`all pairs overlaps, TimeRange ${count}x${count}`, 1, () => {
+        for (let i = 0; i < count; i++) {
+            for (let j = i + 1; j < count; j++) {
+                ranges[i].overlaps(ranges[j], 0)
+            }
+        }
+    })
+    bench(`all pairs overlaps, TimeRangeBuffer ${count}x${count}`, 5, () => {
+        buffer.overlapping_pairs(buffer, 0)
+    })
+    bench(`merge, TimeRangeBuffer x${count}`, 5, () => {
+        buffer.merged(0).delete()
+    })
+
+    ranges.forEach((range) => range.delete())
+    probe.delete()
+    buffer.delete()
+}
@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+// Ripple-like edit of 2000 clips, with and without a transaction.
+const { bench, largeTimelineJSON } = require('./utils')
+
+module.exports = async function (lib) {
+    const clipsPerTrack = 2000
+    const timeline = lib.SerializableObject.from_json_string(largeTimelineJSON(1, clipsPerTrack))
+    const tracks = timeline.tracks().get_children()
+    const children = tracks.get(0).get_children()
+    const clips = []
+    for (let i = 0; i < children.size(); i++) {
+        clips.push(children.get(i))
+    }
+
+    let edits = 0
+    function edit() {
+        const offset = new lib.RationalTime(edits++ % 24, 24)
+        for (const clip of clips) {
+            clip.source_range = new lib.TimeRange(offset, clip.source_range.duration)
+        }
+    }
+
+    bench(`${clipsPerTrack} source ranges`, 10, () => {
+        edit()
+        timeline.content_hash()
+    })
+    bench(`${clipsPerTrack} source ranges (transaction)`, 10, () => {
+        timeline.begin_transaction()
+        edit()
+        timeline.commit().delete()
+        timeline.content_hash()
+    })
+    bench(`${clipsPerTrack} source ranges (rollback)`, 10, () => {
+        timeline.begin_transaction()
+        edit()
+        timeline.rollback()
+    })
+
+    children.delete()
+    tracks.delete()
+    lib.clear_content_hash_cache()
+    timeline.delete()
+}
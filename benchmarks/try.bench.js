@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+// Compare the throwing bindings with their try_* variants when most calls fail.
+const { bench } = require('./utils')
+
+module.exports = async function (lib) {
+    const count = 100000
+    const timecodes = []
+    for (let i = 0; i < count; i++) {
+        // One out of two timecodes is invalid (frame number too high).
+        const frames = i % 2 === 0 ? i % 24 : 30
+        timecodes.push(`00:00:${String(i % 60).padStart(2, '0')}:${String(frames).padStart(2, '0')}`)
+    }
+
+    bench('from_timecode (throws)', 3, () => {
+        for (const timecode of timecodes) {
+            try {
+                lib.RationalTime.from_timecode(timecode, 24)
+            } catch (err) {
+                // Expected.
+            }
+        }
+    })
+    bench('try_from_timecode', 3, () => {
+        for (const timecode of timecodes) {
+            lib.RationalTime.try_from_timecode(timecode, 24)
+        }
+    })
+    const values = new Float64Array(count)
+    const statuses = new Int32Array(count)
+    bench('try_from_timecodes (batch)', 3, () => {
+        lib.RationalTime.try_from_timecodes(timecodes, 24, values, statuses)
+    })
+
+    const item = new lib.Item('no source range')
+    bench('trimmed_range (throws) x10000', 3, () => {
+        for (let i = 0; i < 10000; i++) {
+            try {
+                item.trimmed_range()
+            } catch (err) {
+                // Expected.
+            }
+        }
+    })
+    bench('try_trimmed_range x10000', 3, () => {
+        for (let i = 0; i < 10000; i++) {
+            item.try_trimmed_range()
+        }
+    })
+    item.delete()
+}
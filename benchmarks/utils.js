@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+/* global process */
+
+/**
+ * Run callback `iterations` times and print the average duration.
+ *
+ * @param {string} name Name printed in the report.
+ * @param {number} iterations Number of timed runs (after one warmup run).
+ * @param {() => void} callback Code to benchmark.
+ * @returns {number} Average duration in milliseconds.
+ */
+function bench(name, iterations, callback) {
+    callback()
+
+    const start = process.hrtime.bigint()
+    for (let i = 0; i < iterations; i++) {
+        callback()
+    }
+    const average = Number(process.hrtime.bigint() - start) / 1e6 / iterations
+
+    console.log(`${name.padEnd(48)} ${average.toFixed(3).padStart(12)} ms`)
+    return average
+}
+
+/**
+ * Size of the WASM heap in MiB. Useful to compare peak memory usage.
+ *
+ * @param {object} lib Module returned by the OpenTimelineIO factory.
+ */
+function heapSizeMiB(lib) {
+    return (lib.HEAPU8.length / (1024 * 1024)).toFixed(1)
+}
+
+function rationalTime(value, rate) {
+    return { 'OTIO_SCHEMA': 'RationalTime.1', 'rate': rate, 'value': value }
+}
+
+function timeRange(start, duration, rate) {
+    return {
+        'OTIO_SCHEMA': 'TimeRange.1',
+        'duration': rationalTime(duration, rate),
+        'start_time': rationalTime(start, rate)
+    }
+}
+
+/**
+ * Build the JSON of a timeline with `trackCount` video tracks containing
+ * `clipsPerTrack` clips each.
+ *
+ * The timeline is built as JSON because Timeline, Track and Stack can't be
+ * fully constructed from JS yet.
+ */
+function largeTimelineJSON(trackCount, clipsPerTrack) {
+    const tracks = []
+    for (let t = 0; t < trackCount; t++) {
+        const children = []
+        for (let c = 0; c < clipsPerTrack; c++) {
+            children.push({
+                'OTIO_SCHEMA': 'Clip.2',
+                'metadata': { 'bench': { 'track': t, 'clip': c, 'tag': `shot_${c % 97}` } },
+                'name': `clip_${t}_${c}`,
+                'source_range': timeRange(c * 3, 48 + (c % 24), 24),
+                'effects': [],
+                'markers': [],
+                'enabled': true,
+                'media_references': {
+                    'DEFAULT_MEDIA': {
+                        'OTIO_SCHEMA': 'ExternalReference.1',
+                        'metadata': {},
+                        'name': '',
+                        'available_range': timeRange(0, 1000, 24),
+                        'available_image_bounds': null,
+                        'target_url': `/mnt/media/shot_${c}.mov`
+                    }
+                },
+                'active_media_reference_key': 'DEFAULT_MEDIA'
+            })
+        }
+        tracks.push({
+            'OTIO_SCHEMA': 'Track.1',
+            'metadata': {},
+            'name': `V${t + 1}`,
+            'source_range': null,
+            'effects': [],
+            'markers': [],
+            'enabled': true,
+            'children': children,
+            'kind': 'Video'
+        })
+    }
+
+    return JSON.stringify({
+        'OTIO_SCHEMA': 'Timeline.1',
+        'metadata': {},
+        'name': 'benchmark',
+        'global_start_time': null,
+        'tracks': {
+            'OTIO_SCHEMA': 'Stack.1',
+            'metadata': {},
+            'name': 'tracks',
+            'source_range': null,
+            'effects': [],
+            'markers': [],
+            'enabled': true,
+            'children': tracks
+        }
+    })
+}
+
+module.exports = { bench, heapSizeMiB, largeTimelineJSON }
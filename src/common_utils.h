@@ -4,7 +4,10 @@
 #ifndef JS_COMMON_UTILS_H
 #define JS_COMMON_UTILS_H
 
+#include <vector>
+
 #include <emscripten.h>
+#include <emscripten/val.h>
 
 /**
  * Adds the toStringTag property so that objects are rendered as [object TYPE].
@@ -19,4 +22,44 @@
             enumerable : false                                                 \
         }););
 
+/**
+ * Install the operator functions added with ADD_COMPARISON_OPERATOR. For each
+ * _NAME_typed function, NAME calls it directly when the operand is an instance
+ * of TYPE and falls back to _NAME_dynamic otherwise. Functions are looked up
+ * on each call because embind only finalizes them once their argument types
+ * are registered. The generated TypeScript declarations only list the bound
+ * functions, so NAME must also be declared in pre.d.ts.
+ * @param TYPE Type of the object.
+*/
+#define ADD_OPERATOR_DISPATCH(TYPE)                                            \
+    EM_ASM(                                                                    \
+        var klass = Module[#TYPE];                                             \
+        Object.getOwnPropertyNames(klass.prototype).forEach(function(key) {    \
+            var match = /^_(.+)_typed$/.exec(key);                             \
+            if (!match) {                                                      \
+                return;                                                        \
+            }                                                                  \
+            var typed   = key;                                                 \
+            var dynamic = '_' + match[1] + '_dynamic';                         \
+            klass.prototype[match[1]] = function(rhs) {                        \
+                return rhs instanceof klass ? this[typed](rhs)                 \
+                                            : this[dynamic](rhs);              \
+            };                                                                 \
+        }););
+
+/**
+ * Copy a vector of numbers into a new JS typed array of the matching type
+ * (Float64Array for double, Uint32Array for uint32_t, etc). Unlike a
+ * typed_memory_view, the result stays valid when the WASM memory grows.
+ * @param values Values to copy.
+*/
+template <typename T>
+emscripten::val
+to_js_typed_array(std::vector<T> const& values)
+{
+    return emscripten::val(
+               emscripten::typed_memory_view(values.size(), values.data()))
+        .call<emscripten::val>("slice");
+}
+
 #endif // JS_COMMON_UTILS_H
@@ -4,8 +4,10 @@
 #include <format>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <emscripten/bind.h>
+#include <emscripten/val.h>
 #include <opentime/errorStatus.h>
 #include <opentime/rationalTime.h>
 #include <opentime/timeRange.h>
@@ -14,30 +16,15 @@
 #include <opentimelineio/serialization.h>
 
 #include "common_utils.h"
+#include "errorStatusConverter.h"
 #include "errorStatusHandler.h"
 #include "exceptions.h"
+#include "timeArrays.h"
+#include "tryResult.h"
 
 namespace ems = emscripten;
 using namespace opentime;
 
-namespace {
-
-struct ErrorStatusConverter
-{
-    operator ErrorStatus*() { return &error_status; }
-
-    ~ErrorStatusConverter() noexcept(false)
-    {
-        if (is_error(error_status))
-        {
-            throw ValueError(error_status.details);
-        }
-    }
-
-    ErrorStatus error_status;
-};
-} // namespace
-
 template <typename T>
 T
 _type_checked(ems::val const& rhs, char const* op)
@@ -57,14 +44,22 @@ _type_checked(ems::val const& rhs, char const* op)
 }
 
 /**
- * Add a comparison operator function on a JS class.
+ * Add a comparison operator function on a JS class. Two functions are bound:
+ * _NAME_typed takes a TYPE and skips any conversion, and _NAME_dynamic accepts
+ * anything and raises a TypeError for unsupported operands. NAME itself is
+ * installed by ADD_OPERATOR_DISPATCH, which picks one of them with instanceof.
  * @param TYPE Type of the object.
  * @param NAME Name of the function to add
  * @param OPERATOR C++ operator
 */
 #define ADD_COMPARISON_OPERATOR(TYPE, NAME, OPERATOR)                          \
     .function(                                                                 \
-        NAME,                                                                  \
+        "_" NAME "_typed",                                                     \
+        ems::optional_override([](TYPE const& lhs, TYPE const& rhs) {          \
+            return lhs OPERATOR rhs;                                           \
+        }))                                                                    \
+    .function(                                                                 \
+        "_" NAME "_dynamic",                                                   \
         ems::optional_override([](TYPE const& lhs, ems::val const& rhs) {      \
             return lhs OPERATOR _type_checked<TYPE>(rhs, #OPERATOR);           \
         }))
@@ -99,6 +94,17 @@ EMSCRIPTEN_BINDINGS(opentime)
         .value("ForceYes", IsDropFrameRate::ForceYes)
         .value("InferFromRate", IsDropFrameRate::InferFromRate);
 
+    ems::function("time_representation", ems::optional_override([]() {
+#ifdef OTIO_JS_TIME_VALUE_TYPES
+                      return std::string("value");
+#else
+                      return std::string("class");
+#endif
+                  }));
+
+#ifndef OTIO_JS_TIME_VALUE_TYPES
+    // When OTIO_JS_TIME_VALUE_TYPES is defined, these types are bound as
+    // plain JS values instead. See valueBindings.cpp.
     ems::class_<RationalTime>("RationalTime")
         .constructor<>()
         .constructor<double>()
@@ -193,6 +199,86 @@ EMSCRIPTEN_BINDINGS(opentime)
                     rate,
                     ErrorStatusConverter());
             }))
+        .function(
+            "try_to_timecode",
+            ems::optional_override([](RationalTime const& rt) {
+                ErrorStatus error_status;
+                std::string timecode = rt.to_timecode(
+                    rt.rate(),
+                    IsDropFrameRate::InferFromRate,
+                    &error_status);
+                return try_result(ems::val(timecode), error_status);
+            }))
+        .function(
+            "try_to_timecode",
+            ems::optional_override([](RationalTime const& rt,
+                                      double              rate,
+                                      IsDropFrameRate     drop_frame) {
+                ErrorStatus error_status;
+                std::string timecode =
+                    rt.to_timecode(rate, drop_frame, &error_status);
+                return try_result(ems::val(timecode), error_status);
+            }))
+        .class_function(
+            "try_from_timecode",
+            ems::optional_override([](std::string timecode, double rate) {
+                ErrorStatus  error_status;
+                RationalTime rt =
+                    RationalTime::from_timecode(timecode, rate, &error_status);
+                return try_result(ems::val(rt), error_status);
+            }))
+        .class_function(
+            "try_from_time_string",
+            ems::optional_override([](std::string time_string, double rate) {
+                ErrorStatus  error_status;
+                RationalTime rt = RationalTime::from_time_string(
+                    time_string,
+                    rate,
+                    &error_status);
+                return try_result(ems::val(rt), error_status);
+            }))
+        // Batch version of try_from_timecode. The value (in frames at rate) and
+        // the status of each timecode are written into the given Float64Array
+        // and Int32Array. Returns the number of invalid timecodes.
+        .class_function(
+            "try_from_timecodes",
+            ems::optional_override([](ems::val const& timecodes,
+                                      double          rate,
+                                      ems::val        values,
+                                      ems::val        statuses) {
+                size_t length = timecodes["length"].as<size_t>();
+                if (values["length"].as<size_t>() < length
+                    || statuses["length"].as<size_t>() < length)
+                {
+                    throw ValueError(
+                        "values and statuses must be at least as long as "
+                        "timecodes");
+                }
+
+                std::vector<double>  out_values(length);
+                std::vector<int32_t> out_statuses(length);
+                int                  errors = 0;
+                for (size_t i = 0; i < length; ++i)
+                {
+                    ErrorStatus  error_status;
+                    RationalTime rt = RationalTime::from_timecode(
+                        timecodes[i].as<std::string>(),
+                        rate,
+                        &error_status);
+                    out_values[i]   = rt.value();
+                    out_statuses[i] = static_cast<int32_t>(error_status.outcome);
+                    errors += is_error(error_status) ? 1 : 0;
+                }
+
+                values.call<void>(
+                    "set",
+                    ems::val(ems::typed_memory_view(length, out_values.data())));
+                statuses.call<void>(
+                    "set",
+                    ems::val(
+                        ems::typed_memory_view(length, out_statuses.data())));
+                return errors;
+            }))
         // clang-format off
         ADD_TO_JSON_STRING(opentime::RationalTime)
         ADD_COMPARISON_OPERATOR(RationalTime, "equal", ==)
@@ -205,16 +291,29 @@ EMSCRIPTEN_BINDINGS(opentime)
         ADD_COMPARISON_OPERATOR(RationalTime, "subtract", -)
         // clang-format on
         .function(
-            "compoundAdd",
+            "_compoundAdd_typed",
+            ems::optional_override(
+                [](RationalTime lhs, RationalTime const& rhs) {
+                    return lhs += rhs;
+                }))
+        .function(
+            "_compoundAdd_dynamic",
             ems::optional_override([](RationalTime lhs, ems::val const& rhs) {
                 return lhs += _type_checked<RationalTime>(rhs, "+=");
             }))
         .function(
-            "compoundSubstract",
+            "_compoundSubstract_typed",
+            ems::optional_override(
+                [](RationalTime lhs, RationalTime const& rhs) {
+                    return lhs -= rhs;
+                }))
+        .function(
+            "_compoundSubstract_dynamic",
             ems::optional_override([](RationalTime lhs, ems::val const& rhs) {
                 return lhs -= _type_checked<RationalTime>(rhs, "-=");
             }));
 
+    ADD_OPERATOR_DISPATCH(RationalTime);
     ADD_TO_STRING_TAG_PROPERTY(RationalTime);
 
     ems::class_<TimeRange>("TimeRange")
@@ -289,6 +388,7 @@ EMSCRIPTEN_BINDINGS(opentime)
         ADD_COMPARISON_OPERATOR(TimeRange, "notEqual", !=);
     // clang-format on
 
+    ADD_OPERATOR_DISPATCH(TimeRange);
     ADD_TO_STRING_TAG_PROPERTY(TimeRange);
 
     ems::class_<TimeTransform>("TimeTransform")
@@ -312,11 +412,43 @@ EMSCRIPTEN_BINDINGS(opentime)
             "applied_to",
             ems::select_overload<RationalTime(RationalTime) const>(
                 &TimeTransform::applied_to))
+        .function(
+            "applied_to_many",
+            ems::optional_override([](TimeTransform const& tt,
+                                      ems::val const&      values,
+                                      double               rate) {
+                return time_arrays::applied_to_many(
+                    tt,
+                    values,
+                    rate,
+                    ems::val::undefined());
+            }))
+        .function("applied_to_many", &time_arrays::applied_to_many)
+        .class_function(
+            "compose",
+            ems::optional_override([](ems::val const& transforms) {
+                return time_arrays::compose(
+                    ems::vecFromJSArray<TimeTransform>(transforms));
+            }))
+        .class_function(
+            "applied_to_many_composed",
+            ems::optional_override([](ems::val const& transforms,
+                                      ems::val const& values,
+                                      double          rate) {
+                return time_arrays::applied_to_many(
+                    time_arrays::compose(
+                        ems::vecFromJSArray<TimeTransform>(transforms)),
+                    values,
+                    rate,
+                    ems::val::undefined());
+            }))
         // clang-format off
         ADD_TO_JSON_STRING(opentime::TimeTransform)
         ADD_COMPARISON_OPERATOR(TimeTransform, "equal", ==)
         ADD_COMPARISON_OPERATOR(TimeTransform, "notEqual", !=);
     // clang-format on
 
+    ADD_OPERATOR_DISPATCH(TimeTransform);
     ADD_TO_STRING_TAG_PROPERTY(TimeTransform);
+#endif
 }
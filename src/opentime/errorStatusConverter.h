@@ -0,0 +1,26 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include <opentime/errorStatus.h>
+
+#include "exceptions.h"
+
+/**
+ * Convert an opentime ErrorStatus into a ValueError when it goes out of scope.
+*/
+struct ErrorStatusConverter
+{
+    operator opentime::ErrorStatus*() { return &error_status; }
+
+    ~ErrorStatusConverter() noexcept(false)
+    {
+        if (opentime::is_error(error_status))
+        {
+            throw ValueError(error_status.details);
+        }
+    }
+
+    opentime::ErrorStatus error_status;
+};
@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+#include <opentime/rationalTime.h>
+#include <opentime/timeTransform.h>
+
+#include "exceptions.h"
+
+/**
+ * Helpers to apply time operations to arrays of time values that all share
+ * the same rate. They are shared by the class and the value bindings.
+ */
+namespace time_arrays {
+
+/**
+ * Collapse a chain of transforms into a single one that is equivalent to
+ * applying them one after the other: compose([a, b, c]) applied to t gives
+ * a.applied_to(b.applied_to(c.applied_to(t))). Unlike
+ * TimeTransform::applied_to(TimeTransform), the inner offsets are scaled by
+ * the outer transforms. The rate is the one of the outermost transform that
+ * has one. An empty chain gives the identity transform.
+ */
+inline opentime::TimeTransform
+compose(std::vector<opentime::TimeTransform> const& transforms)
+{
+    opentime::TimeTransform result;
+    for (auto it = transforms.rbegin(); it != transforms.rend(); ++it)
+    {
+        if (it == transforms.rbegin())
+        {
+            result = *it;
+            continue;
+        }
+
+        opentime::RationalTime inner_offset = result.offset();
+        result = opentime::TimeTransform(
+            it->offset()
+                + opentime::RationalTime(
+                    inner_offset.value() * it->scale(),
+                    inner_offset.rate()),
+            it->scale() * result.scale(),
+            it->rate() > 0 ? it->rate() : result.rate());
+    }
+    return result;
+}
+
+/**
+ * Apply transform to each value (at rate) like TimeTransform::applied_to does
+ * for a single RationalTime. The results are in the rate of the transform, or
+ * if the transform doesn't have one in the larger of rate and the rate of its
+ * offset (adding two RationalTimes gives the larger rate). in and out can be
+ * the same.
+ */
+inline void
+applied_to(
+    opentime::TimeTransform const& transform,
+    double const*                  in,
+    double*                        out,
+    size_t                         size,
+    double                         rate)
+{
+    // Fold the offset and the rescaling into a single multiply-add, so that
+    // the loop only works on doubles.
+    double const target =
+        transform.rate() > 0 ? transform.rate()
+                             : std::max(rate, transform.offset().rate());
+    double const factor = target > 0 ? target / rate : 1;
+    double const scale  = transform.scale() * factor;
+    double const offset =
+        transform.offset().value_rescaled_to(rate) * factor;
+    for (size_t i = 0; i < size; ++i)
+    {
+        out[i] = in[i] * scale + offset;
+    }
+}
+
+/**
+ * Apply transform to a JS array of values. When output is undefined, the
+ * results are returned in a new Float64Array, otherwise they are written into
+ * output (which can be values itself) and output is returned.
+ */
+inline emscripten::val
+applied_to_many(
+    opentime::TimeTransform const& transform,
+    emscripten::val const&         values,
+    double                         rate,
+    emscripten::val                output)
+{
+    std::vector<double> data =
+        emscripten::convertJSArrayToNumberVector<double>(values);
+    applied_to(transform, data.data(), data.data(), data.size(), rate);
+
+    emscripten::val view =
+        emscripten::val(emscripten::typed_memory_view(data.size(), data.data()));
+    if (output.isUndefined())
+    {
+        return view.call<emscripten::val>("slice");
+    }
+
+    if (output["length"].as<size_t>() < data.size())
+    {
+        throw ValueError("output is shorter than values");
+    }
+    output.call<void>("set", view);
+    return output;
+}
+
+} // namespace time_arrays
@@ -0,0 +1,388 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+#include <opentime/rationalTime.h>
+#include <opentime/timeRange.h>
+
+#include "common_utils.h"
+#include "exceptions.h"
+#include "timeRangeBuffer.h"
+
+using namespace opentime;
+
+namespace {
+
+// Extra margin (in seconds) used when pruning candidates in
+// overlapping_pairs. Candidates are always confirmed with TimeRange::overlaps,
+// so it only needs to be larger than rounding errors.
+constexpr double pruning_margin = 1e-9;
+
+void
+_check_same_size(TimeRangeBuffer const& lhs, TimeRangeBuffer const& rhs)
+{
+    if (lhs.size() != rhs.size())
+    {
+        throw ValueError("TimeRangeBuffers must have the same length");
+    }
+}
+
+} // namespace
+
+TimeRangeBuffer
+TimeRangeBuffer::from_arrays(
+    ems::val const& starts,
+    ems::val const& durations,
+    ems::val const& rates)
+{
+    TimeRangeBuffer buffer;
+    buffer._starts    = ems::convertJSArrayToNumberVector<double>(starts);
+    buffer._durations = ems::convertJSArrayToNumberVector<double>(durations);
+    if (rates.isNumber())
+    {
+        buffer._rates.assign(buffer._starts.size(), rates.as<double>());
+    }
+    else
+    {
+        buffer._rates = ems::convertJSArrayToNumberVector<double>(rates);
+    }
+
+    if (buffer._durations.size() != buffer._starts.size()
+        || buffer._rates.size() != buffer._starts.size())
+    {
+        throw ValueError("starts, durations and rates must have the same length");
+    }
+    return buffer;
+}
+
+void
+TimeRangeBuffer::push(TimeRange const& range)
+{
+    double rate = range.start_time().rate();
+    _starts.push_back(range.start_time().value());
+    _durations.push_back(range.duration().value_rescaled_to(rate));
+    _rates.push_back(rate);
+}
+
+void
+TimeRangeBuffer::clear()
+{
+    _starts.clear();
+    _durations.clear();
+    _rates.clear();
+}
+
+ems::val
+TimeRangeBuffer::starts() const
+{
+    return ems::val(ems::typed_memory_view(_starts.size(), _starts.data()));
+}
+
+ems::val
+TimeRangeBuffer::durations() const
+{
+    return ems::val(
+        ems::typed_memory_view(_durations.size(), _durations.data()));
+}
+
+ems::val
+TimeRangeBuffer::rates() const
+{
+    return ems::val(ems::typed_memory_view(_rates.size(), _rates.data()));
+}
+
+ems::val
+TimeRangeBuffer::overlaps_pairwise(
+    TimeRangeBuffer const& other,
+    double                 epsilon) const
+{
+    _check_same_size(*this, other);
+    std::vector<uint8_t> result(size());
+    for (size_t i = 0; i < result.size(); ++i)
+    {
+        result[i] = at(i).overlaps(other.at(i), epsilon);
+    }
+    return to_js_typed_array(result);
+}
+
+ems::val
+TimeRangeBuffer::intersects_pairwise(
+    TimeRangeBuffer const& other,
+    double                 epsilon) const
+{
+    _check_same_size(*this, other);
+    std::vector<uint8_t> result(size());
+    for (size_t i = 0; i < result.size(); ++i)
+    {
+        result[i] = at(i).intersects(other.at(i), epsilon);
+    }
+    return to_js_typed_array(result);
+}
+
+ems::val
+TimeRangeBuffer::contains_pairwise(
+    TimeRangeBuffer const& other,
+    double                 epsilon) const
+{
+    _check_same_size(*this, other);
+    std::vector<uint8_t> result(size());
+    for (size_t i = 0; i < result.size(); ++i)
+    {
+        result[i] = at(i).contains(other.at(i), epsilon);
+    }
+    return to_js_typed_array(result);
+}
+
+TimeRangeBuffer
+TimeRangeBuffer::clamped_pairwise(TimeRangeBuffer const& other) const
+{
+    _check_same_size(*this, other);
+    TimeRangeBuffer result;
+    for (size_t i = 0; i < size(); ++i)
+    {
+        result.push(at(i).clamped(other.at(i)));
+    }
+    return result;
+}
+
+TimeRangeBuffer
+TimeRangeBuffer::intersection_pairwise(TimeRangeBuffer const& other) const
+{
+    _check_same_size(*this, other);
+    TimeRangeBuffer result;
+    for (size_t i = 0; i < size(); ++i)
+    {
+        TimeRange    lhs   = at(i);
+        TimeRange    rhs   = other.at(i);
+        RationalTime start = std::max(lhs.start_time(), rhs.start_time());
+        RationalTime end =
+            std::min(lhs.end_time_exclusive(), rhs.end_time_exclusive());
+        result.push(
+            TimeRange::range_from_start_end_time(start, std::max(start, end)));
+    }
+    return result;
+}
+
+ems::val
+TimeRangeBuffer::overlaps_range(TimeRange const& range, double epsilon) const
+{
+    std::vector<uint8_t> result(size());
+    for (size_t i = 0; i < result.size(); ++i)
+    {
+        result[i] = at(i).overlaps(range, epsilon);
+    }
+    return to_js_typed_array(result);
+}
+
+ems::val
+TimeRangeBuffer::contains_time(RationalTime const& time) const
+{
+    std::vector<uint8_t> result(size());
+    for (size_t i = 0; i < result.size(); ++i)
+    {
+        result[i] = at(i).contains(time);
+    }
+    return to_js_typed_array(result);
+}
+
+TimeRangeBuffer
+TimeRangeBuffer::clamped_to(TimeRange const& range) const
+{
+    TimeRangeBuffer result;
+    for (size_t i = 0; i < size(); ++i)
+    {
+        result.push(at(i).clamped(range));
+    }
+    return result;
+}
+
+ems::val
+TimeRangeBuffer::overlapping_pairs(
+    TimeRangeBuffer const& other,
+    double                 epsilon) const
+{
+    // Sweep over the starts of both buffers. Each range is compared with the
+    // ranges of the other buffer that are still active, so the cost is
+    // O(n log n + number of candidates) instead of O(n * m).
+    std::vector<uint32_t> lhs_order = _sorted_indices();
+    std::vector<uint32_t> rhs_order = other._sorted_indices();
+    double                margin    = std::abs(epsilon) + pruning_margin;
+
+    auto start = [](TimeRangeBuffer const& b, uint32_t i) {
+        return b._starts[i] / b._rates[i];
+    };
+    auto end = [](TimeRangeBuffer const& b, uint32_t i) {
+        return (b._starts[i] + b._durations[i]) / b._rates[i];
+    };
+    auto prune = [&](std::vector<uint32_t>& active,
+                     TimeRangeBuffer const& b,
+                     double                 position) {
+        active.erase(
+            std::remove_if(
+                active.begin(),
+                active.end(),
+                [&](uint32_t i) { return end(b, i) + margin < position; }),
+            active.end());
+    };
+
+    std::vector<uint32_t> lhs_active;
+    std::vector<uint32_t> rhs_active;
+    std::vector<uint32_t> pairs;
+    size_t                l = 0;
+    size_t                r = 0;
+    while (l < lhs_order.size() || r < rhs_order.size())
+    {
+        bool take_lhs =
+            r == rhs_order.size()
+            || (l < lhs_order.size()
+                && start(*this, lhs_order[l]) <= start(other, rhs_order[r]));
+
+        if (take_lhs)
+        {
+            uint32_t  i     = lhs_order[l++];
+            TimeRange range = at(i);
+            prune(rhs_active, other, start(*this, i));
+            for (uint32_t j: rhs_active)
+            {
+                if (range.overlaps(other.at(j), epsilon))
+                {
+                    pairs.push_back(i);
+                    pairs.push_back(j);
+                }
+            }
+            lhs_active.push_back(i);
+        }
+        else
+        {
+            uint32_t  j     = rhs_order[r++];
+            TimeRange range = other.at(j);
+            prune(lhs_active, *this, start(other, j));
+            for (uint32_t i: lhs_active)
+            {
+                if (at(i).overlaps(range, epsilon))
+                {
+                    pairs.push_back(i);
+                    pairs.push_back(j);
+                }
+            }
+            rhs_active.push_back(j);
+        }
+    }
+    return to_js_typed_array(pairs);
+}
+
+std::vector<uint32_t>
+TimeRangeBuffer::_sorted_indices() const
+{
+    std::vector<double> seconds(size());
+    for (size_t i = 0; i < seconds.size(); ++i)
+    {
+        seconds[i] = _starts[i] / _rates[i];
+    }
+
+    std::vector<uint32_t> indices(size());
+    std::iota(indices.begin(), indices.end(), 0);
+    std::stable_sort(
+        indices.begin(),
+        indices.end(),
+        [&seconds](uint32_t lhs, uint32_t rhs) {
+            return seconds[lhs] < seconds[rhs];
+        });
+    return indices;
+}
+
+ems::val
+TimeRangeBuffer::sorted_indices() const
+{
+    return to_js_typed_array(_sorted_indices());
+}
+
+void
+TimeRangeBuffer::sort()
+{
+    std::vector<uint32_t> indices = _sorted_indices();
+    TimeRangeBuffer       sorted;
+    sorted._starts.reserve(size());
+    sorted._durations.reserve(size());
+    sorted._rates.reserve(size());
+    for (uint32_t i: indices)
+    {
+        sorted._starts.push_back(_starts[i]);
+        sorted._durations.push_back(_durations[i]);
+        sorted._rates.push_back(_rates[i]);
+    }
+    *this = std::move(sorted);
+}
+
+TimeRangeBuffer
+TimeRangeBuffer::merged(double epsilon) const
+{
+    TimeRangeBuffer result;
+    if (size() == 0)
+    {
+        return result;
+    }
+
+    std::vector<uint32_t> indices = _sorted_indices();
+    TimeRange             current = at(indices[0]);
+    for (size_t k = 1; k < indices.size(); ++k)
+    {
+        TimeRange range = at(indices[k]);
+        if (range.start_time().to_seconds()
+            <= current.end_time_exclusive().to_seconds() + epsilon)
+        {
+            current = current.extended_by(range);
+        }
+        else
+        {
+            result.push(current);
+            current = range;
+        }
+    }
+    result.push(current);
+    return result;
+}
+
+EMSCRIPTEN_BINDINGS(opentime_timeRangeBuffer)
+{
+    ems::class_<TimeRangeBuffer>("TimeRangeBuffer")
+        .constructor<>()
+        .class_function("from_arrays", &TimeRangeBuffer::from_arrays)
+        .property("length", &TimeRangeBuffer::size)
+        .function("push", &TimeRangeBuffer::push)
+        .function("clear", &TimeRangeBuffer::clear)
+        .function(
+            "at",
+            ems::optional_override([](TimeRangeBuffer const& b, int index) {
+                if (index < 0 || size_t(index) >= b.size())
+                {
+                    throw IndexError("TimeRangeBuffer index out of range");
+                }
+                return b.at(index);
+            }))
+        .function("starts", &TimeRangeBuffer::starts)
+        .function("durations", &TimeRangeBuffer::durations)
+        .function("rates", &TimeRangeBuffer::rates)
+        .function("overlaps_pairwise", &TimeRangeBuffer::overlaps_pairwise)
+        .function("intersects_pairwise", &TimeRangeBuffer::intersects_pairwise)
+        .function("contains_pairwise", &TimeRangeBuffer::contains_pairwise)
+        .function("clamped_pairwise", &TimeRangeBuffer::clamped_pairwise)
+        .function(
+            "intersection_pairwise",
+            &TimeRangeBuffer::intersection_pairwise)
+        .function("overlaps_range", &TimeRangeBuffer::overlaps_range)
+        .function("contains_time", &TimeRangeBuffer::contains_time)
+        .function("clamped_to", &TimeRangeBuffer::clamped_to)
+        .function("overlapping_pairs", &TimeRangeBuffer::overlapping_pairs)
+        .function("sorted_indices", &TimeRangeBuffer::sorted_indices)
+        .function("sort", &TimeRangeBuffer::sort)
+        .function("merged", &TimeRangeBuffer::merged);
+
+    ADD_TO_STRING_TAG_PROPERTY(TimeRangeBuffer);
+}
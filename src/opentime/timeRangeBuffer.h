@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <emscripten/val.h>
+#include <opentime/rationalTime.h>
+#include <opentime/timeRange.h>
+
+namespace ems = emscripten;
+
+/**
+ * A list of TimeRanges stored as a struct of arrays (start values, duration
+ * values and rates). Durations are stored in the rate of their start time,
+ * which is how TimeRange computes its end time.
+ *
+ * Operations work on whole buffers and return typed arrays, so checking
+ * thousands of ranges crosses the JS/WASM boundary once instead of once per
+ * pair. Each element behaves exactly like the TimeRange it was created from.
+ */
+class TimeRangeBuffer
+{
+public:
+    TimeRangeBuffer() = default;
+
+    static TimeRangeBuffer from_arrays(
+        ems::val const& starts,
+        ems::val const& durations,
+        ems::val const& rates);
+
+    size_t size() const { return _starts.size(); }
+
+    void push(opentime::TimeRange const& range);
+    void clear();
+
+    opentime::TimeRange at(size_t index) const
+    {
+        return opentime::TimeRange(
+            opentime::RationalTime(_starts[index], _rates[index]),
+            opentime::RationalTime(_durations[index], _rates[index]));
+    }
+
+    // Views into the WASM memory. They are invalidated by any modification
+    // of the buffer or growth of the memory.
+    ems::val starts() const;
+    ems::val durations() const;
+    ems::val rates() const;
+
+    // Compare element i of this buffer with element i of other.
+    ems::val overlaps_pairwise(TimeRangeBuffer const& other, double epsilon)
+        const;
+    ems::val intersects_pairwise(TimeRangeBuffer const& other, double epsilon)
+        const;
+    ems::val contains_pairwise(TimeRangeBuffer const& other, double epsilon)
+        const;
+    TimeRangeBuffer clamped_pairwise(TimeRangeBuffer const& other) const;
+    // Overlapping part of each pair of ranges. Disjoint pairs give an empty
+    // range starting at the latest start time.
+    TimeRangeBuffer intersection_pairwise(TimeRangeBuffer const& other) const;
+
+    // Compare every element with a single range or time.
+    ems::val overlaps_range(opentime::TimeRange const& range, double epsilon)
+        const;
+    ems::val contains_time(opentime::RationalTime const& time) const;
+    TimeRangeBuffer clamped_to(opentime::TimeRange const& range) const;
+
+    // Pairs (i, j) for which element i of this buffer overlaps element j of
+    // other, flattened as [i0, j0, i1, j1, ...].
+    ems::val overlapping_pairs(TimeRangeBuffer const& other, double epsilon)
+        const;
+
+    // Indices that sort the buffer by start time (stable).
+    ems::val sorted_indices() const;
+    void     sort();
+
+    // Union of the ranges: overlapping or adjacent ranges are merged. The
+    // result is sorted by start time.
+    TimeRangeBuffer merged(double epsilon) const;
+
+private:
+    std::vector<uint32_t> _sorted_indices() const;
+
+    std::vector<double> _starts;
+    std::vector<double> _durations;
+    std::vector<double> _rates;
+};
@@ -0,0 +1,450 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+// Bindings used when building with OTIO_JS_TIME_VALUE_TYPES. RationalTime,
+// TimeRange and TimeTransform are converted to and from plain JS objects
+// ({value, rate}, {start_time, duration} and {offset, scale, rate}) instead of
+// being wrapped C++ objects. Nothing has to be deleted from JS and no object
+// outlives a call on the WASM heap.
+//
+// The methods are bound as free functions named _TYPE_NAME. pre.js groups them
+// as static functions of Module.TYPE, so RationalTime.add(a, b) replaces
+// a.add(b).
+#include <string>
+
+#include <emscripten/bind.h>
+#include <opentime/rationalTime.h>
+#include <opentime/timeRange.h>
+#include <opentime/timeTransform.h>
+#include <opentimelineio/any.h>
+#include <opentimelineio/serialization.h>
+
+#include "errorStatusConverter.h"
+#include "errorStatusHandler.h"
+#include "timeArrays.h"
+
+namespace ems = emscripten;
+using namespace opentime;
+
+namespace {
+
+double
+_rt_value(RationalTime const& rt)
+{
+    return rt.value();
+}
+
+void
+_rt_set_value(RationalTime& rt, double value)
+{
+    rt = RationalTime(value, rt.rate());
+}
+
+double
+_rt_rate(RationalTime const& rt)
+{
+    return rt.rate();
+}
+
+void
+_rt_set_rate(RationalTime& rt, double rate)
+{
+    rt = RationalTime(rt.value(), rate);
+}
+
+RationalTime
+_tr_start_time(TimeRange const& tr)
+{
+    return tr.start_time();
+}
+
+void
+_tr_set_start_time(TimeRange& tr, RationalTime start_time)
+{
+    tr = TimeRange(start_time, tr.duration());
+}
+
+RationalTime
+_tr_duration(TimeRange const& tr)
+{
+    return tr.duration();
+}
+
+void
+_tr_set_duration(TimeRange& tr, RationalTime duration)
+{
+    tr = TimeRange(tr.start_time(), duration);
+}
+
+RationalTime
+_tt_offset(TimeTransform const& tt)
+{
+    return tt.offset();
+}
+
+void
+_tt_set_offset(TimeTransform& tt, RationalTime offset)
+{
+    tt = TimeTransform(offset, tt.scale(), tt.rate());
+}
+
+double
+_tt_scale(TimeTransform const& tt)
+{
+    return tt.scale();
+}
+
+void
+_tt_set_scale(TimeTransform& tt, double scale)
+{
+    tt = TimeTransform(tt.offset(), scale, tt.rate());
+}
+
+double
+_tt_rate(TimeTransform const& tt)
+{
+    return tt.rate();
+}
+
+void
+_tt_set_rate(TimeTransform& tt, double rate)
+{
+    tt = TimeTransform(tt.offset(), tt.scale(), rate);
+}
+
+template <typename T>
+std::string
+_to_json_string(T const& item, int indent)
+{
+    return OTIO_NS::serialize_json_to_string(
+        linb::any(item),
+        nullptr,
+        ErrorStatusHandler(),
+        indent);
+}
+
+} // namespace
+
+EMSCRIPTEN_BINDINGS(opentime_values)
+{
+    ems::value_object<RationalTime>("RationalTime")
+        .field("value", &_rt_value, &_rt_set_value)
+        .field("rate", &_rt_rate, &_rt_set_rate);
+
+    ems::value_object<TimeRange>("TimeRange")
+        .field("start_time", &_tr_start_time, &_tr_set_start_time)
+        .field("duration", &_tr_duration, &_tr_set_duration);
+
+    ems::value_object<TimeTransform>("TimeTransform")
+        .field("offset", &_tt_offset, &_tt_set_offset)
+        .field("scale", &_tt_scale, &_tt_set_scale)
+        .field("rate", &_tt_rate, &_tt_set_rate);
+
+    // RationalTime
+    ems::function(
+        "_RationalTime_is_invalid_time",
+        ems::optional_override(
+            [](RationalTime rt) { return rt.is_invalid_time(); }));
+    ems::function(
+        "_RationalTime_rescaled_to",
+        ems::optional_override([](RationalTime rt, double rate) {
+            return rt.rescaled_to(rate);
+        }));
+    ems::function(
+        "_RationalTime_value_rescaled_to",
+        ems::optional_override([](RationalTime rt, double rate) {
+            return rt.value_rescaled_to(rate);
+        }));
+    ems::function(
+        "_RationalTime_almost_equal",
+        ems::optional_override([](RationalTime lhs, RationalTime rhs) {
+            return lhs.almost_equal(rhs);
+        }));
+    ems::function(
+        "_RationalTime_almost_equal",
+        ems::optional_override(
+            [](RationalTime lhs, RationalTime rhs, double delta) {
+                return lhs.almost_equal(rhs, delta);
+            }));
+    ems::function(
+        "_RationalTime_duration_from_start_end_time",
+        &RationalTime::duration_from_start_end_time);
+    ems::function(
+        "_RationalTime_duration_from_start_end_time_inclusive",
+        &RationalTime::duration_from_start_end_time_inclusive);
+    ems::function(
+        "_RationalTime_is_valid_timecode_rate",
+        &RationalTime::is_valid_timecode_rate);
+    ems::function(
+        "_RationalTime_nearest_valid_timecode_rate",
+        &RationalTime::nearest_valid_timecode_rate);
+    ems::function("_RationalTime_from_frames", &RationalTime::from_frames);
+    ems::function(
+        "_RationalTime_from_seconds",
+        ems::select_overload<RationalTime(double, double)>(
+            &RationalTime::from_seconds));
+    ems::function(
+        "_RationalTime_from_seconds",
+        ems::select_overload<RationalTime(double)>(
+            &RationalTime::from_seconds));
+    ems::function(
+        "_RationalTime_to_frames",
+        ems::optional_override([](RationalTime rt) { return rt.to_frames(); }));
+    ems::function(
+        "_RationalTime_to_frames",
+        ems::optional_override(
+            [](RationalTime rt, double rate) { return rt.to_frames(rate); }));
+    ems::function(
+        "_RationalTime_to_seconds",
+        ems::optional_override([](RationalTime rt) { return rt.to_seconds(); }));
+    ems::function(
+        "_RationalTime_to_timecode",
+        ems::optional_override([](RationalTime rt) {
+            return rt.to_timecode(
+                rt.rate(),
+                IsDropFrameRate::InferFromRate,
+                ErrorStatusConverter());
+        }));
+    ems::function(
+        "_RationalTime_to_timecode",
+        ems::optional_override([](RationalTime    rt,
+                                  double          rate,
+                                  IsDropFrameRate drop_frame) {
+            return rt.to_timecode(rate, drop_frame, ErrorStatusConverter());
+        }));
+    ems::function(
+        "_RationalTime_to_time_string",
+        ems::optional_override(
+            [](RationalTime rt) { return rt.to_time_string(); }));
+    ems::function(
+        "_RationalTime_from_timecode",
+        ems::optional_override([](std::string timecode, double rate) {
+            return RationalTime::from_timecode(
+                timecode,
+                rate,
+                ErrorStatusConverter());
+        }));
+    ems::function(
+        "_RationalTime_from_time_string",
+        ems::optional_override([](std::string time_string, double rate) {
+            return RationalTime::from_time_string(
+                time_string,
+                rate,
+                ErrorStatusConverter());
+        }));
+    ems::function(
+        "_RationalTime_equal",
+        ems::optional_override(
+            [](RationalTime lhs, RationalTime rhs) { return lhs == rhs; }));
+    ems::function(
+        "_RationalTime_notEqual",
+        ems::optional_override(
+            [](RationalTime lhs, RationalTime rhs) { return lhs != rhs; }));
+    ems::function(
+        "_RationalTime_lessThan",
+        ems::optional_override(
+            [](RationalTime lhs, RationalTime rhs) { return lhs < rhs; }));
+    ems::function(
+        "_RationalTime_lessThanOrEqual",
+        ems::optional_override(
+            [](RationalTime lhs, RationalTime rhs) { return lhs <= rhs; }));
+    ems::function(
+        "_RationalTime_greaterThan",
+        ems::optional_override(
+            [](RationalTime lhs, RationalTime rhs) { return lhs > rhs; }));
+    ems::function(
+        "_RationalTime_greaterThanOrEqual",
+        ems::optional_override(
+            [](RationalTime lhs, RationalTime rhs) { return lhs >= rhs; }));
+    ems::function(
+        "_RationalTime_add",
+        ems::optional_override(
+            [](RationalTime lhs, RationalTime rhs) { return lhs + rhs; }));
+    ems::function(
+        "_RationalTime_subtract",
+        ems::optional_override(
+            [](RationalTime lhs, RationalTime rhs) { return lhs - rhs; }));
+    ems::function(
+        "_RationalTime_to_json_string",
+        ems::optional_override([](RationalTime rt) {
+            return _to_json_string(rt, 4);
+        }));
+    ems::function(
+        "_RationalTime_to_json_string",
+        &_to_json_string<RationalTime>);
+
+    // TimeRange
+    ems::function(
+        "_TimeRange_end_time_inclusive",
+        ems::optional_override(
+            [](TimeRange tr) { return tr.end_time_inclusive(); }));
+    ems::function(
+        "_TimeRange_end_time_exclusive",
+        ems::optional_override(
+            [](TimeRange tr) { return tr.end_time_exclusive(); }));
+    ems::function(
+        "_TimeRange_duration_extended_by",
+        ems::optional_override([](TimeRange tr, RationalTime other) {
+            return tr.duration_extended_by(other);
+        }));
+    ems::function(
+        "_TimeRange_extended_by",
+        ems::optional_override(
+            [](TimeRange tr, TimeRange other) { return tr.extended_by(other); }));
+    ems::function(
+        "_TimeRange_clamped",
+        ems::optional_override(
+            [](TimeRange tr, TimeRange other) { return tr.clamped(other); }));
+    ems::function(
+        "_TimeRange_clamped_time",
+        ems::optional_override(
+            [](TimeRange tr, RationalTime other) { return tr.clamped(other); }));
+    ems::function(
+        "_TimeRange_contains",
+        ems::optional_override([](TimeRange tr, TimeRange other) {
+            return tr.contains(other);
+        }));
+    ems::function(
+        "_TimeRange_contains",
+        ems::optional_override(
+            [](TimeRange tr, TimeRange other, double epsilon) {
+                return tr.contains(other, epsilon);
+            }));
+    ems::function(
+        "_TimeRange_contains_time",
+        ems::optional_override([](TimeRange tr, RationalTime other) {
+            return tr.contains(other);
+        }));
+    ems::function(
+        "_TimeRange_overlaps",
+        ems::optional_override([](TimeRange tr, TimeRange other) {
+            return tr.overlaps(other);
+        }));
+    ems::function(
+        "_TimeRange_overlaps",
+        ems::optional_override(
+            [](TimeRange tr, TimeRange other, double epsilon) {
+                return tr.overlaps(other, epsilon);
+            }));
+    ems::function(
+        "_TimeRange_overlaps_time",
+        ems::optional_override([](TimeRange tr, RationalTime other) {
+            return tr.overlaps(other);
+        }));
+    ems::function(
+        "_TimeRange_before",
+        ems::optional_override(
+            [](TimeRange tr, TimeRange other) { return tr.before(other); }));
+    ems::function(
+        "_TimeRange_before_time",
+        ems::optional_override(
+            [](TimeRange tr, RationalTime other) { return tr.before(other); }));
+    ems::function(
+        "_TimeRange_meets",
+        ems::optional_override(
+            [](TimeRange tr, TimeRange other) { return tr.meets(other); }));
+    ems::function(
+        "_TimeRange_begins",
+        ems::optional_override(
+            [](TimeRange tr, TimeRange other) { return tr.begins(other); }));
+    ems::function(
+        "_TimeRange_begins_time",
+        ems::optional_override(
+            [](TimeRange tr, RationalTime other) { return tr.begins(other); }));
+    ems::function(
+        "_TimeRange_finishes",
+        ems::optional_override(
+            [](TimeRange tr, TimeRange other) { return tr.finishes(other); }));
+    ems::function(
+        "_TimeRange_finishes_time",
+        ems::optional_override([](TimeRange tr, RationalTime other) {
+            return tr.finishes(other);
+        }));
+    ems::function(
+        "_TimeRange_intersects",
+        ems::optional_override(
+            [](TimeRange tr, TimeRange other) { return tr.intersects(other); }));
+    ems::function(
+        "_TimeRange_range_from_start_end_time",
+        &TimeRange::range_from_start_end_time);
+    ems::function(
+        "_TimeRange_range_from_start_end_time_inclusive",
+        &TimeRange::range_from_start_end_time_inclusive);
+    ems::function(
+        "_TimeRange_equal",
+        ems::optional_override(
+            [](TimeRange lhs, TimeRange rhs) { return lhs == rhs; }));
+    ems::function(
+        "_TimeRange_notEqual",
+        ems::optional_override(
+            [](TimeRange lhs, TimeRange rhs) { return lhs != rhs; }));
+    ems::function(
+        "_TimeRange_to_json_string",
+        ems::optional_override(
+            [](TimeRange tr) { return _to_json_string(tr, 4); }));
+    ems::function("_TimeRange_to_json_string", &_to_json_string<TimeRange>);
+
+    // TimeTransform
+    ems::function(
+        "_TimeTransform_applied_to_time",
+        ems::optional_override([](TimeTransform tt, RationalTime other) {
+            return tt.applied_to(other);
+        }));
+    ems::function(
+        "_TimeTransform_applied_to_range",
+        ems::optional_override([](TimeTransform tt, TimeRange other) {
+            return tt.applied_to(other);
+        }));
+    ems::function(
+        "_TimeTransform_applied_to_transform",
+        ems::optional_override([](TimeTransform tt, TimeTransform other) {
+            return tt.applied_to(other);
+        }));
+    ems::function(
+        "_TimeTransform_applied_to_many",
+        ems::optional_override([](TimeTransform   tt,
+                                  ems::val const& values,
+                                  double          rate) {
+            return time_arrays::applied_to_many(
+                tt,
+                values,
+                rate,
+                ems::val::undefined());
+        }));
+    ems::function(
+        "_TimeTransform_applied_to_many",
+        &time_arrays::applied_to_many);
+    ems::function(
+        "_TimeTransform_compose",
+        ems::optional_override([](ems::val const& transforms) {
+            return time_arrays::compose(
+                ems::vecFromJSArray<TimeTransform>(transforms));
+        }));
+    ems::function(
+        "_TimeTransform_applied_to_many_composed",
+        ems::optional_override([](ems::val const& transforms,
+                                  ems::val const& values,
+                                  double          rate) {
+            return time_arrays::applied_to_many(
+                time_arrays::compose(
+                    ems::vecFromJSArray<TimeTransform>(transforms)),
+                values,
+                rate,
+                ems::val::undefined());
+        }));
+    ems::function(
+        "_TimeTransform_equal",
+        ems::optional_override(
+            [](TimeTransform lhs, TimeTransform rhs) { return lhs == rhs; }));
+    ems::function(
+        "_TimeTransform_notEqual",
+        ems::optional_override(
+            [](TimeTransform lhs, TimeTransform rhs) { return lhs != rhs; }));
+    ems::function(
+        "_TimeTransform_to_json_string",
+        ems::optional_override(
+            [](TimeTransform tt) { return _to_json_string(tt, 4); }));
+    ems::function(
+        "_TimeTransform_to_json_string",
+        &_to_json_string<TimeTransform>);
+}
@@ -0,0 +1,663 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <format>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "any/any.hpp"
+#include <opentime/rationalTime.h>
+#include <opentime/timeRange.h>
+#include <opentime/timeTransform.h>
+#include <opentimelineio/anyDictionary.h>
+#include <opentimelineio/anyVector.h>
+#include <opentimelineio/serializableObject.h>
+#include <opentimelineio/errorStatus.h>
+#include <opentimelineio/typeRegistry.h>
+#include <ImathBox.h>
+#include <ImathVec.h>
+
+#include "binarySerialization.h"
+#include "errorStatusHandler.h"
+#include "exceptions.h"
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION {
+
+// SerializableObject::Writer::write_root() walks an object graph and hands
+// the values to an Encoder. OTIO declares the class in serialization.cpp
+// only, so the declaration is repeated here and must be kept identical to
+// the one of the OTIO version in deps/.
+class Encoder
+{
+public:
+    virtual ~Encoder() {}
+
+    bool has_errored(ErrorStatus* error_status)
+    {
+        if (error_status)
+        {
+            *error_status = _error_status;
+        }
+        return is_error(_error_status);
+    }
+
+    bool has_errored() { return is_error(_error_status); }
+
+    virtual void start_object() = 0;
+    virtual void end_object()   = 0;
+
+    virtual void start_array(size_t) = 0;
+    virtual void end_array()         = 0;
+
+    virtual void write_key(std::string const& key)                   = 0;
+    virtual void write_null_value()                                  = 0;
+    virtual void write_value(bool value)                             = 0;
+    virtual void write_value(int value)                              = 0;
+    virtual void write_value(int64_t value)                          = 0;
+    virtual void write_value(uint64_t value)                         = 0;
+    virtual void write_value(double value)                           = 0;
+    virtual void write_value(std::string const& value)               = 0;
+    virtual void write_value(opentime::RationalTime const& value)    = 0;
+    virtual void write_value(opentime::TimeRange const& value)       = 0;
+    virtual void write_value(opentime::TimeTransform const& value)   = 0;
+    virtual void write_value(struct SerializableObject::ReferenceId) = 0;
+    virtual void write_value(Imath::Box2d const&)                    = 0;
+    virtual void write_value(Imath::V2d const&)                      = 0;
+
+protected:
+    void _error(ErrorStatus const& error_status)
+    {
+        _error_status = error_status;
+    }
+
+private:
+    friend class SerializableObject;
+    ErrorStatus _error_status;
+};
+
+}} // namespace opentimelineio::OPENTIMELINEIO_VERSION
+
+namespace {
+
+constexpr char    BINARY_MAGIC[4]       = { 'O', 'T', 'I', 'B' };
+constexpr uint8_t BINARY_FORMAT_VERSION = 1;
+constexpr int     MAX_NESTING_DEPTH     = 512;
+
+// Writes the values that SerializableObject::Writer walks over. Objects are
+// written into their own buffer, which is appended to the enclosing one once
+// the member count is known. The buffers are reused between objects at the
+// same depth.
+class BinaryEncoder : public OTIO_NS::Encoder
+{
+public:
+    BinaryEncoder()
+        : _frames(1)
+    {}
+
+    void start_object() override
+    {
+        _begin_value();
+        if (++_depth == _frames.size())
+        {
+            _frames.emplace_back();
+        }
+        Frame& frame = _frames[_depth];
+        frame.body.clear();
+        frame.count = 0;
+        frame.schema.clear();
+        frame.has_schema     = false;
+        frame.schema_pending = false;
+    }
+
+    void end_object() override
+    {
+        Frame&       frame  = _frames[_depth];
+        std::string& parent = _frames[_depth - 1].body;
+
+        size_t const dot = frame.schema.rfind('.');
+        int          version;
+        if (!frame.has_schema)
+        {
+            _put_tag(parent, BinaryTag::object);
+            _put_varuint(parent, frame.count);
+        }
+        else if (
+            dot == std::string::npos
+            || !_parse_version(
+                std::string_view(frame.schema).substr(dot + 1),
+                &version))
+        {
+            // Let the reader report the malformed schema, like JSON would.
+            _put_tag(parent, BinaryTag::object);
+            _put_varuint(parent, frame.count + 1);
+            _put_varuint(parent, _intern("OTIO_SCHEMA"));
+            _put_tag(parent, BinaryTag::string_value);
+            _put_varuint(parent, _intern(frame.schema));
+        }
+        else
+        {
+            _put_tag(parent, BinaryTag::schema_object);
+            _put_varuint(parent, _intern(frame.schema.substr(0, dot)));
+            _put_varuint(parent, version);
+            _put_varuint(parent, frame.count);
+        }
+        parent.append(frame.body);
+        --_depth;
+    }
+
+    void start_array(size_t size) override
+    {
+        _begin_value();
+        _put_tag(_body(), BinaryTag::array);
+        _put_varuint(_body(), size);
+    }
+
+    void end_array() override {}
+
+    void write_key(std::string const& key) override
+    {
+        Frame& frame = _frames[_depth];
+        if (key == "OTIO_SCHEMA" && !frame.has_schema)
+        {
+            frame.schema_pending = true;
+            return;
+        }
+        _put_varuint(frame.body, _intern(key));
+        ++frame.count;
+    }
+
+    void write_null_value() override
+    {
+        _begin_value();
+        _put_tag(_body(), BinaryTag::null_value);
+    }
+
+    void write_value(bool value) override
+    {
+        _begin_value();
+        _put_tag(
+            _body(),
+            value ? BinaryTag::true_value : BinaryTag::false_value);
+    }
+
+    void write_value(int value) override { write_value(int64_t(value)); }
+
+    void write_value(int64_t value) override
+    {
+        // The reader narrows back to int when the value fits, like the JSON
+        // decoder does.
+        _begin_value();
+        _put_tag(_body(), BinaryTag::int_value);
+        _put_varint(_body(), value);
+    }
+
+    void write_value(uint64_t value) override
+    {
+        if (value <= uint64_t(std::numeric_limits<int64_t>::max()))
+        {
+            write_value(int64_t(value));
+            return;
+        }
+        _begin_value();
+        _put_tag(_body(), BinaryTag::uint64_value);
+        _put_varuint(_body(), value);
+    }
+
+    void write_value(double value) override
+    {
+        _begin_value();
+        _put_tag(_body(), BinaryTag::double_value);
+        _put_double(_body(), value);
+    }
+
+    void write_value(std::string const& value) override
+    {
+        Frame& frame = _frames[_depth];
+        if (frame.schema_pending)
+        {
+            frame.schema         = value;
+            frame.has_schema     = true;
+            frame.schema_pending = false;
+            return;
+        }
+        _put_tag(frame.body, BinaryTag::string_value);
+        _put_varuint(frame.body, _intern(value));
+    }
+
+    void write_value(opentime::RationalTime const& value) override
+    {
+        _begin_value();
+        _put_tag(_body(), BinaryTag::rational_time);
+        _put_double(_body(), value.value());
+        _put_double(_body(), value.rate());
+    }
+
+    void write_value(opentime::TimeRange const& value) override
+    {
+        _begin_value();
+        _put_tag(_body(), BinaryTag::time_range);
+        _put_double(_body(), value.start_time().value());
+        _put_double(_body(), value.start_time().rate());
+        _put_double(_body(), value.duration().value());
+        _put_double(_body(), value.duration().rate());
+    }
+
+    void write_value(opentime::TimeTransform const& value) override
+    {
+        _begin_value();
+        _put_tag(_body(), BinaryTag::time_transform);
+        _put_double(_body(), value.offset().value());
+        _put_double(_body(), value.offset().rate());
+        _put_double(_body(), value.scale());
+        _put_double(_body(), value.rate());
+    }
+
+    void write_value(OTIO_NS::SerializableObject::ReferenceId value) override
+    {
+        _begin_value();
+        _put_schema(_body(), "SerializableObjectRef", 1);
+        _put_varuint(_body(), _intern("id"));
+        _put_tag(_body(), BinaryTag::string_value);
+        _put_varuint(_body(), _intern(value.id));
+    }
+
+    void write_value(Imath::Box2d const& value) override
+    {
+        _begin_value();
+        _put_schema(_body(), "Box2d", 2);
+        _put_varuint(_body(), _intern("min"));
+        write_value(value.min);
+        _put_varuint(_body(), _intern("max"));
+        write_value(value.max);
+    }
+
+    void write_value(Imath::V2d const& value) override
+    {
+        _begin_value();
+        _put_schema(_body(), "V2d", 2);
+        _put_varuint(_body(), _intern("x"));
+        _put_tag(_body(), BinaryTag::double_value);
+        _put_double(_body(), value.x);
+        _put_varuint(_body(), _intern("y"));
+        _put_tag(_body(), BinaryTag::double_value);
+        _put_double(_body(), value.y);
+    }
+
+    std::string finish()
+    {
+        std::string result(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+        result.push_back(static_cast<char>(BINARY_FORMAT_VERSION));
+
+        _put_varuint(result, _strings.size());
+        for (std::string const& s: _strings)
+        {
+            _put_varuint(result, s.size());
+            result.append(s);
+        }
+
+        result.reserve(result.size() + _frames[0].body.size());
+        result.append(_frames[0].body);
+        return result;
+    }
+
+private:
+    struct Frame
+    {
+        std::string body;
+        uint64_t    count = 0;
+        std::string schema;
+        bool        has_schema     = false;
+        bool        schema_pending = false;
+    };
+
+    std::string& _body() { return _frames[_depth].body; }
+
+    // An OTIO_SCHEMA key that isn't followed by a string is an ordinary
+    // member.
+    void _begin_value()
+    {
+        Frame& frame = _frames[_depth];
+        if (frame.schema_pending)
+        {
+            frame.schema_pending = false;
+            _put_varuint(frame.body, _intern("OTIO_SCHEMA"));
+            ++frame.count;
+        }
+    }
+
+    // The member count excludes the schema, like for the objects.
+    void _put_schema(std::string& out, char const* name, uint64_t count)
+    {
+        _put_tag(out, BinaryTag::schema_object);
+        _put_varuint(out, _intern(name));
+        _put_varuint(out, 1);
+        _put_varuint(out, count);
+    }
+
+    static bool _parse_version(std::string_view text, int* version)
+    {
+        if (text.empty() || text.size() > 9)
+        {
+            return false;
+        }
+
+        int result = 0;
+        for (char c: text)
+        {
+            if (c < '0' || c > '9')
+            {
+                return false;
+            }
+            result = result * 10 + (c - '0');
+        }
+        *version = result;
+        return true;
+    }
+
+    uint64_t _intern(std::string_view key)
+    {
+        auto it = _string_ids.find(key);
+        if (it != _string_ids.end())
+        {
+            return it->second;
+        }
+
+        // The deque doesn't move its strings, so the views stay valid.
+        uint64_t id = _strings.size();
+        _strings.emplace_back(key);
+        _string_ids.emplace(_strings.back(), id);
+        return id;
+    }
+
+    static void _put_tag(std::string& out, BinaryTag tag)
+    {
+        out.push_back(static_cast<char>(tag));
+    }
+
+    static void _put_varuint(std::string& out, uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+
+    static void _put_varint(std::string& out, int64_t value)
+    {
+        _put_varuint(
+            out,
+            (static_cast<uint64_t>(value) << 1)
+                ^ static_cast<uint64_t>(value >> 63));
+    }
+
+    static void _put_double(std::string& out, double value)
+    {
+        // WebAssembly is little endian, so the bytes can be copied as is.
+        char bytes[sizeof(double)];
+        std::memcpy(bytes, &value, sizeof(double));
+        out.append(bytes, sizeof(double));
+    }
+
+    std::vector<Frame>                             _frames;
+    size_t                                         _depth = 0;
+    std::deque<std::string>                        _strings;
+    std::unordered_map<std::string_view, uint64_t> _string_ids;
+};
+
+class BinaryReader
+{
+public:
+    BinaryReader(uint8_t const* data, size_t size)
+        : _data(data)
+        , _end(data + size)
+    {}
+
+    linb::any read_document()
+    {
+        if (size_t(_end - _data) < sizeof(BINARY_MAGIC) + 1
+            || std::memcmp(_data, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0)
+        {
+            throw ValueError("Not a binary OTIO document");
+        }
+        _data += sizeof(BINARY_MAGIC);
+
+        uint8_t version = _read_byte();
+        if (version != BINARY_FORMAT_VERSION)
+        {
+            throw ValueError(std::format(
+                "Unsupported binary OTIO format version {}",
+                version));
+        }
+
+        uint64_t count = _read_varuint();
+        // Every string takes at least one byte, which bounds the reservation.
+        if (count > uint64_t(_end - _data))
+        {
+            _malformed();
+        }
+        _strings.reserve(count);
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            uint64_t length = _read_varuint();
+            _require(length);
+            _strings.emplace_back(reinterpret_cast<char const*>(_data), length);
+            _data += length;
+        }
+
+        linb::any result = _read_value(0);
+        if (_data != _end)
+        {
+            _malformed();
+        }
+        return result;
+    }
+
+private:
+    linb::any _read_value(int depth)
+    {
+        if (depth > MAX_NESTING_DEPTH)
+        {
+            throw ValueError("Binary OTIO document is nested too deeply");
+        }
+
+        switch (static_cast<BinaryTag>(_read_byte()))
+        {
+            case BinaryTag::null_value:
+                return linb::any();
+            case BinaryTag::false_value:
+                return linb::any(false);
+            case BinaryTag::true_value:
+                return linb::any(true);
+            case BinaryTag::int_value: {
+                uint64_t encoded = _read_varuint();
+                int64_t  value   = static_cast<int64_t>(encoded >> 1)
+                                ^ -static_cast<int64_t>(encoded & 1);
+                if (value >= std::numeric_limits<int>::min()
+                    && value <= std::numeric_limits<int>::max())
+                {
+                    return linb::any(static_cast<int>(value));
+                }
+                return linb::any(value);
+            }
+            case BinaryTag::uint64_value:
+                return linb::any(_read_varuint());
+            case BinaryTag::double_value:
+                return linb::any(_read_double());
+            case BinaryTag::string_value:
+                return linb::any(_read_string());
+            case BinaryTag::array: {
+                uint64_t           count = _read_count();
+                OTIO_NS::AnyVector vector;
+                vector.reserve(count);
+                for (uint64_t i = 0; i < count; ++i)
+                {
+                    vector.push_back(_read_value(depth + 1));
+                }
+                return linb::any(std::move(vector));
+            }
+            case BinaryTag::object: {
+                OTIO_NS::AnyDictionary dict;
+                _read_members(&dict, depth);
+                return linb::any(std::move(dict));
+            }
+            case BinaryTag::schema_object:
+                return _read_schema_object(depth);
+            case BinaryTag::rational_time: {
+                double value = _read_double();
+                double rate  = _read_double();
+                return linb::any(opentime::RationalTime(value, rate));
+            }
+            case BinaryTag::time_range: {
+                double start_value    = _read_double();
+                double start_rate     = _read_double();
+                double duration_value = _read_double();
+                double duration_rate  = _read_double();
+                return linb::any(opentime::TimeRange(
+                    opentime::RationalTime(start_value, start_rate),
+                    opentime::RationalTime(duration_value, duration_rate)));
+            }
+            case BinaryTag::time_transform: {
+                double offset_value = _read_double();
+                double offset_rate  = _read_double();
+                double scale        = _read_double();
+                double rate         = _read_double();
+                return linb::any(opentime::TimeTransform(
+                    opentime::RationalTime(offset_value, offset_rate),
+                    scale,
+                    rate));
+            }
+        }
+
+        _malformed();
+    }
+
+    linb::any _read_schema_object(int depth)
+    {
+        std::string const& schema_name    = _read_string();
+        uint64_t           schema_version = _read_varuint();
+        if (schema_version > uint64_t(std::numeric_limits<int>::max()))
+        {
+            _malformed();
+        }
+
+        OTIO_NS::AnyDictionary dict;
+        _read_members(&dict, depth);
+
+        OTIO_NS::SerializableObject* so = nullptr;
+        {
+            ErrorStatusHandler error_status;
+            so = OTIO_NS::TypeRegistry::instance().instance_from_schema(
+                schema_name,
+                static_cast<int>(schema_version),
+                dict,
+                error_status);
+        }
+        return linb::any(OTIO_NS::SerializableObject::Retainer<>(so));
+    }
+
+    void _read_members(OTIO_NS::AnyDictionary* dict, int depth)
+    {
+        uint64_t count = _read_count();
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            std::string const& key = _read_string();
+            (*dict)[key]           = _read_value(depth + 1);
+        }
+    }
+
+    std::string const& _read_string()
+    {
+        uint64_t id = _read_varuint();
+        if (id >= _strings.size())
+        {
+            _malformed();
+        }
+        return _strings[id];
+    }
+
+    uint64_t _read_count()
+    {
+        // Every element takes at least one byte.
+        uint64_t count = _read_varuint();
+        if (count > uint64_t(_end - _data))
+        {
+            _malformed();
+        }
+        return count;
+    }
+
+    uint64_t _read_varuint()
+    {
+        uint64_t result = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            uint8_t byte = _read_byte();
+            result |= uint64_t(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+            {
+                return result;
+            }
+        }
+        _malformed();
+    }
+
+    double _read_double()
+    {
+        _require(sizeof(double));
+        double value;
+        std::memcpy(&value, _data, sizeof(double));
+        _data += sizeof(double);
+        return value;
+    }
+
+    uint8_t _read_byte()
+    {
+        _require(1);
+        return *_data++;
+    }
+
+    void _require(uint64_t size)
+    {
+        if (size > uint64_t(_end - _data))
+        {
+            _malformed();
+        }
+    }
+
+    [[noreturn]] void _malformed()
+    {
+        throw ValueError("Malformed binary OTIO document");
+    }
+
+    uint8_t const*           _data;
+    uint8_t const*           _end;
+    std::vector<std::string> _strings;
+};
+
+} // namespace
+
+std::string
+any_to_binary(linb::any const& value)
+{
+    BinaryEncoder encoder;
+    OTIO_NS::SerializableObject::Writer::write_root(
+        value,
+        encoder,
+        nullptr,
+        ErrorStatusHandler());
+    return encoder.finish();
+}
+
+linb::any
+binary_to_any(uint8_t const* data, size_t size)
+{
+    return BinaryReader(data, size).read_document();
+}
@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#ifndef JS_BINARY_SERIALIZATION_H
+#define JS_BINARY_SERIALIZATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "any/any.hpp"
+
+/**
+ * Compact binary encoding of OTIO documents.
+ *
+ * Layout (all integers are LEB128 varints unless noted otherwise):
+ *
+ *   "OTIB" <format version: u8>
+ *   <string count> (<length> <UTF-8 bytes>)*     interned string table
+ *   <value>                                      root value
+ *
+ * Values start with a one byte tag (see BinaryTag). Keys, strings and schema
+ * names are references into the string table. RationalTime, TimeRange and
+ * TimeTransform are packed as raw little endian doubles. Other schemas are
+ * stored as (schema name, schema version, fields) so that the reader can
+ * instantiate them through the TypeRegistry without going through JSON.
+ */
+enum class BinaryTag : uint8_t
+{
+    null_value     = 0,
+    false_value    = 1,
+    true_value     = 2,
+    int_value      = 3, // zigzag encoded int64
+    uint64_value   = 4,
+    double_value   = 5,
+    string_value   = 6,
+    array          = 7,
+    object         = 8,
+    schema_object  = 9,
+    rational_time  = 10, // value, rate
+    time_range     = 11, // start value, start rate, duration value, duration rate
+    time_transform = 12, // offset value, offset rate, scale, rate
+};
+
+/**
+ * Encode a value (usually a SerializableObject retainer or an AnyDictionary)
+ * directly from the object graph, with the values OTIO's JSON serializer
+ * would write. Throws like to_json_string() if a value can't be serialized.
+ */
+std::string any_to_binary(linb::any const& value);
+
+/**
+ * Decode a binary document. Objects with a schema are created through the
+ * TypeRegistry, so schema upgrades are applied like when reading JSON.
+ * Throws ValueError if the data is malformed.
+ */
+linb::any binary_to_any(uint8_t const* data, size_t size);
+
+#endif // JS_BINARY_SERIALIZATION_H
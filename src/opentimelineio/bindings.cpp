@@ -3,6 +3,7 @@
 #include <functional>
 #include <optional>
 #include <string>
+#include <typeinfo>
 #include <vector>
 
 #include "emscripten.h"
@@ -39,11 +40,22 @@
 #include <opentimelineio/typeRegistry.h>
 #include <opentimelineio/unknownSchema.h>
 
+#include "binarySerialization.h"
+#include "byteBuffer.h"
 #include "common_utils.h"
+#include "contentHash.h"
+#include "deepClone.h"
+#include "editAlgorithm.h"
 #include "errorStatusHandler.h"
+#include "handleTable.h"
+#include "imageSequenceBatch.h"
 #include "js_any.h"
 #include "js_anyDictionary.h"
+#include "journal.h"
 #include "js_optional.h"
+#include "timelineSnapshot.h"
+#include "transaction.h"
+#include "tryResult.h"
 #include "utils.h"
 
 namespace ems = emscripten;
@@ -221,21 +233,73 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
             ems::optional_override(
                 [](OTIO_NS::SerializableObject&  so,
                    OTIO_NS::AnyDictionary const& dynamic_fields) {
-                    OTIO_NS::AnyDictionary& old_fields = so.dynamic_fields();
-                    old_fields                         = dynamic_fields;
+                    journal::set_dynamic_fields(so, dynamic_fields);
                 }))
+        .function(
+            "_get_dynamic_field",
+            ems::optional_override([](OTIO_NS::SerializableObject& so,
+                                      std::string const&           name) {
+                OTIO_NS::AnyDictionary& fields = so.dynamic_fields();
+                auto                    it     = fields.find(name);
+                if (it == fields.end())
+                {
+                    return ems::val::undefined();
+                }
+                return any_to_js(it->second, true);
+            }))
+        .function(
+            "_set_dynamic_field",
+            ems::optional_override([](OTIO_NS::SerializableObject& so,
+                                      std::string const&           name,
+                                      ems::val                     value) {
+                journal::set_dynamic_field(so, name, js_to_any(value));
+            }))
         .function(
             "is_equivalent_to",
-            &OTIO_NS::SerializableObject::is_equivalent_to)
+            ems::optional_override(
+                [](OTIO_NS::SerializableObject const& so,
+                   OTIO_NS::SerializableObject const& other) {
+                    return content_hash::is_equivalent(so, other);
+                }))
+        .function(
+            "content_hash",
+            ems::optional_override([](OTIO_NS::SerializableObject const& so) {
+                return content_hash::hash_string(&so);
+            }))
+        .function(
+            "begin_transaction",
+            ems::optional_override([](OTIO_NS::SerializableObject& so) {
+                transaction::begin(&so);
+            }))
+        .function(
+            "commit",
+            ems::optional_override([](OTIO_NS::SerializableObject& so) {
+                return transaction::commit(&so);
+            }))
+        .function(
+            "rollback",
+            ems::optional_override([](OTIO_NS::SerializableObject& so) {
+                transaction::rollback(&so);
+            }))
+        .function(
+            "in_transaction",
+            ems::optional_override([](OTIO_NS::SerializableObject const& so) {
+                return transaction::is_open(&so);
+            }))
+        // Add an owner to the slot of the object in the handle table and
+        // return its handle. It must be released with release_handle().
+        .function(
+            "acquire_handle",
+            ems::optional_override([](OTIO_NS::SerializableObject& so) {
+                return handle_table::acquire(&so);
+            }))
         // Don't override Emscripten's own clone method. Emscripten's clone
         // is not a copy, it creates a references which points to the same C++ object.
         // clone is similar to when compiling OTIO with INSTANCING_SUPPORT I guess? Not sure.
-        // TODO: This crashes. Stacktrace can be seen when cimpiling in Debug mode
-        // and running the tests.
         .function(
             "clone_otio",
-            ems::optional_override([](OTIO_NS::SerializableObject* so) {
-                return so->clone(ErrorStatusHandler());
+            ems::optional_override([](OTIO_NS::SerializableObject const* so) {
+                return deep_clone::clone(so);
             }),
             ems::allow_raw_pointers())
         .function(
@@ -249,6 +313,21 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
                 [](OTIO_NS::SerializableObject const& so, int indent) {
                     return so.to_json_string(ErrorStatusHandler(), {}, indent);
                 }))
+        // Same as to_json_string, but the UTF-8 output stays in a ByteBuffer
+        // instead of being decoded into a JS string.
+        .function(
+            "to_json_bytes",
+            ems::optional_override([](OTIO_NS::SerializableObject const& so) {
+                return ByteBuffer(
+                    so.to_json_string(ErrorStatusHandler(), {}, 4));
+            }))
+        .function(
+            "to_json_bytes",
+            ems::optional_override(
+                [](OTIO_NS::SerializableObject const& so, int indent) {
+                    return ByteBuffer(
+                        so.to_json_string(ErrorStatusHandler(), {}, indent));
+                }))
         .function(
             "to_json_file",
             ems::optional_override([](OTIO_NS::SerializableObject const& so,
@@ -271,6 +350,20 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
                     ErrorStatusHandler());
                 return managing_ptr<OTIO_NS::SerializableObject>(result);
             }))
+        .class_function(
+            "try_from_json_string",
+            ems::optional_override([](std::string input) {
+                OTIO_NS::ErrorStatus         error_status;
+                OTIO_NS::SerializableObject* result =
+                    OTIO_NS::SerializableObject::from_json_string(
+                        input,
+                        &error_status);
+                return try_result(
+                    result ? ems::val(
+                        managing_ptr<OTIO_NS::SerializableObject>(result))
+                           : ems::val::null(),
+                    error_status);
+            }))
         .class_function(
             "from_json_file",
             ems::optional_override([](std::string file_name) {
@@ -279,6 +372,31 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
                     ErrorStatusHandler());
                 return managing_ptr<OTIO_NS::SerializableObject>(result);
             }))
+        .function(
+            "to_binary",
+            ems::optional_override([](OTIO_NS::SerializableObject const& so) {
+                return ByteBuffer(any_to_binary(
+                    linb::any(OTIO_NS::SerializableObject::Retainer<>(&so))));
+            }))
+        .class_function(
+            "from_binary",
+            ems::optional_override([](ems::val const& bytes) {
+                // Copy the bytes in one go rather than element by element.
+                std::vector<uint8_t> data(bytes["length"].as<size_t>());
+                ems::val(ems::typed_memory_view(data.size(), data.data()))
+                    .call<void>("set", bytes);
+                linb::any result = binary_to_any(data.data(), data.size());
+                if (result.type()
+                    != typeid(OTIO_NS::SerializableObject::Retainer<>))
+                {
+                    throw TypeError(
+                        "Binary document doesn't contain a SerializableObject");
+                }
+                return managing_ptr<OTIO_NS::SerializableObject>(
+                    linb::any_cast<OTIO_NS::SerializableObject::Retainer<>&>(
+                        result)
+                        .take_value());
+            }))
         .function("schema_name", &OTIO_NS::SerializableObject::schema_name)
         .function(
             "schema_version",
@@ -332,7 +450,9 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
         .property(
             "name",
             &OTIO_NS::SerializableObjectWithMetadata::name,
-            &OTIO_NS::SerializableObjectWithMetadata::set_name)
+            &journal::recording<
+                &OTIO_NS::SerializableObjectWithMetadata::name,
+                &OTIO_NS::SerializableObjectWithMetadata::set_name>)
         .function(
             "get_metadata",
             // TODO: Should we instead return the reference? AFAIK we can't
@@ -349,8 +469,7 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
             ems::optional_override(
                 [](OTIO_NS::SerializableObjectWithMetadata& so,
                    OTIO_NS::AnyDictionary                   metadata) {
-                    OTIO_NS::AnyDictionary& old_metadata = so.metadata();
-                    old_metadata                         = metadata;
+                    journal::set_metadata(so, metadata);
                 }));
 
     ADD_TO_STRING_TAG_PROPERTY(SerializableObjectWithMetadata);
@@ -381,11 +500,18 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
                     color,
                     js_map_to_cpp(metadata)));
             }))
-        .property("color", &OTIO_NS::Marker::color, &OTIO_NS::Marker::set_color)
+        .property(
+            "color",
+            &OTIO_NS::Marker::color,
+            &journal::recording<
+                &OTIO_NS::Marker::color,
+                &OTIO_NS::Marker::set_color>)
         .property(
             "marked_range",
             &OTIO_NS::Marker::marked_range,
-            &OTIO_NS::Marker::set_marked_range);
+            &journal::recording<
+                &OTIO_NS::Marker::marked_range,
+                &OTIO_NS::Marker::set_marked_range>);
 
     ADD_TO_STRING_TAG_PROPERTY(Marker);
 
@@ -394,7 +520,22 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
     ADD_TO_STRING_TAG_PROPERTY(MarkerColor);
 
     // TODO: Use custom unmarshaling? When I tried, it wasn't even compiling.
-    ems::register_vector<OTIO_NS::SerializableObject*>("SOVector");
+    ems::register_vector<OTIO_NS::SerializableObject*>("SOVector")
+        .function(
+            "_get_address",
+            &element_address<OTIO_NS::SerializableObject>);
+    ems::register_vector<OTIO_NS::Composable*>("ComposableVector")
+        .function("_get_address", &element_address<OTIO_NS::Composable>);
+
+    // Dynamic type of the object at address (see object_address()), which
+    // the wrapper cache of pre.js compares with the type of its wrapper.
+    ems::function(
+        "_dynamic_type",
+        ems::optional_override([](size_t address) {
+            auto object =
+                reinterpret_cast<OTIO_NS::SerializableObject const*>(address);
+            return reinterpret_cast<size_t>(&typeid(*object));
+        }));
 
     using SerializableCollectionIterator =
         ContainerIterator<OTIO_NS::SerializableCollection>;
@@ -458,28 +599,38 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
                 }))
         .function(
             "set_children",
-            &OTIO_NS::SerializableCollection::set_children,
+            ems::optional_override(
+                [](OTIO_NS::SerializableCollection&                 sc,
+                   std::vector<OTIO_NS::SerializableObject*> const& children) {
+                    journal::set_children(sc, children);
+                }),
             ems::allow_raw_pointers())
         .function(
             "clear_children",
-            &OTIO_NS::SerializableCollection::clear_children)
+            ems::optional_override([](OTIO_NS::SerializableCollection& sc) {
+                journal::set_children(sc, {});
+            }))
         .function(
             "insert_child",
-            &OTIO_NS::SerializableCollection::insert_child,
+            ems::optional_override([](OTIO_NS::SerializableCollection& sc,
+                                      int                              index,
+                                      OTIO_NS::SerializableObject*     child) {
+                journal::insert_child(sc, index, child);
+            }),
             ems::allow_raw_pointers())
         .function(
             "set_child",
             ems::optional_override([](OTIO_NS::SerializableCollection& sc,
                                       int                              index,
                                       OTIO_NS::SerializableObject*     child) {
-                return sc.set_child(index, child, ErrorStatusHandler());
+                return journal::set_child(sc, index, child);
             }),
             ems::allow_raw_pointers())
         .function(
             "remove_child",
             ems::optional_override(
                 [](OTIO_NS::SerializableCollection& sc, int index) {
-                    return sc.remove_child(index, ErrorStatusHandler());
+                    return journal::remove_child(sc, index);
                 }))
         .function(
             "find_clips",
@@ -533,21 +684,24 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
             "parent",
             &OTIO_NS::Composable::parent,
             ems::allow_raw_pointers())
+        .function(
+            "_parent_address",
+            ems::optional_override([](OTIO_NS::Composable const& composable) {
+                return object_address(composable.parent());
+            }))
         .function("function", &OTIO_NS::Composable::visible)
         .function("overlapping", &OTIO_NS::Composable::overlapping);
 
     ADD_TO_STRING_TAG_PROPERTY(Composable);
 
     // TODO: This is not nice on the JS side.
-    ems::register_vector<OTIO_NS::Effect*>("EffectVector");
-    ems::register_vector<OTIO_NS::Marker*>("MarkerVector");
+    ems::register_vector<OTIO_NS::Effect*>("EffectVector")
+        .function("_get_address", &element_address<OTIO_NS::Effect>);
+    ems::register_vector<OTIO_NS::Marker*>("MarkerVector")
+        .function("_get_address", &element_address<OTIO_NS::Marker>);
 
-    using EffectVectorProxy = JSMutableSequence<
-        std::vector<OTIO_NS::SerializableObject::Retainer<OTIO_NS::Effect>>,
-        OTIO_NS::Effect*>;
-    using MarkerVectorProxy = JSMutableSequence<
-        std::vector<OTIO_NS::SerializableObject::Retainer<OTIO_NS::Marker>>,
-        OTIO_NS::Marker*>;
+    using EffectVectorProxy = JSMutableSequence<OTIO_NS::Effect>;
+    using MarkerVectorProxy = JSMutableSequence<OTIO_NS::Marker>;
 
     EffectVectorProxy::define_js_class(
         "EffectVectorProxy",
@@ -621,27 +775,41 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
         .property(
             "enabled",
             &OTIO_NS::Item::enabled,
-            &OTIO_NS::Item::set_enabled)
+            &journal::recording<
+                &OTIO_NS::Item::enabled,
+                &OTIO_NS::Item::set_enabled>)
         .property(
             "source_range",
             &OTIO_NS::Item::source_range,
-            &OTIO_NS::Item::set_source_range)
+            &journal::recording<
+                &OTIO_NS::Item::source_range,
+                &OTIO_NS::Item::set_source_range>)
         .function(
             "get_effects",
-            ems::optional_override([](OTIO_NS::Item const& item) {
-                return ((EffectVectorProxy*) &item.effects());
-            }),
-            ems::allow_raw_pointers())
+            ems::optional_override([](OTIO_NS::Item& item) {
+                return EffectVectorProxy(&item);
+            }))
         .function(
             "get_markers",
-            ems::optional_override([](OTIO_NS::Item const& item) {
-                return ((MarkerVectorProxy*) &item.markers());
-            }),
-            ems::allow_raw_pointers())
+            ems::optional_override([](OTIO_NS::Item& item) {
+                return MarkerVectorProxy(&item);
+            }))
         .function(
             "trimmed_range",
             ems::optional_override([](OTIO_NS::Item const& item) {
                 return item.trimmed_range(ErrorStatusHandler());
+            }))
+        .function(
+            "try_trimmed_range",
+            ems::optional_override([](OTIO_NS::Item const& item) {
+                OTIO_NS::ErrorStatus error_status;
+                OTIO_NS::TimeRange   range = item.trimmed_range(&error_status);
+                return try_result(ems::val(range), error_status);
+            }))
+        .function(
+            "range_in_parent",
+            ems::optional_override([](OTIO_NS::Item const& item) {
+                return item.range_in_parent(ErrorStatusHandler());
             }));
     ADD_TO_STRING_TAG_PROPERTY(Item);
 
@@ -663,15 +831,21 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
         .property(
             "transition_type",
             &OTIO_NS::Transition::transition_type,
-            &OTIO_NS::Transition::set_transition_type)
+            &journal::recording<
+                &OTIO_NS::Transition::transition_type,
+                &OTIO_NS::Transition::set_transition_type>)
         .property(
             "in_offset",
             &OTIO_NS::Transition::in_offset,
-            &OTIO_NS::Transition::set_in_offset)
+            &journal::recording<
+                &OTIO_NS::Transition::in_offset,
+                &OTIO_NS::Transition::set_in_offset>)
         .property(
             "out_offset",
             &OTIO_NS::Transition::out_offset,
-            &OTIO_NS::Transition::set_out_offset)
+            &journal::recording<
+                &OTIO_NS::Transition::out_offset,
+                &OTIO_NS::Transition::set_out_offset>)
         .function(
             "duration",
             ems::optional_override([](OTIO_NS::Transition& t) {
@@ -750,18 +924,26 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
             "media_reference",
             &OTIO_NS::Clip::media_reference,
             ems::allow_raw_pointers())
+        .function(
+            "_media_reference_address",
+            ems::optional_override([](OTIO_NS::Clip const& clip) {
+                return object_address(clip.media_reference());
+            }))
         .function(
             "set_media_reference",
-            &OTIO_NS::Clip::set_media_reference,
+            ems::optional_override([](OTIO_NS::Clip&           clip,
+                                      OTIO_NS::MediaReference* media_reference) {
+                journal::set_media_reference(clip, media_reference);
+            }),
             ems::allow_raw_pointers())
         .property(
             "active_media_reference_key",
             &OTIO_NS::Clip::active_media_reference_key,
             ems::optional_override(
                 [](OTIO_NS::Clip& clip, std::string const& new_active_key) {
-                    clip.set_active_media_reference_key(
-                        new_active_key,
-                        ErrorStatusHandler());
+                    journal::set_active_media_reference_key(
+                        clip,
+                        new_active_key);
                 }))
         .function("media_references", &OTIO_NS::Clip::media_references)
         .function(
@@ -770,10 +952,10 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
                 [](OTIO_NS::Clip*                        clip,
                    OTIO_NS::Clip::MediaReferences const& media_references,
                    std::string const&                    new_active_key) {
-                    clip->set_media_references(
+                    journal::set_media_references(
+                        *clip,
                         media_references,
-                        new_active_key,
-                        ErrorStatusHandler());
+                        new_active_key);
                 }),
             ems::allow_raw_pointers());
     ADD_TO_STRING_TAG_PROPERTY(Clip);
@@ -803,10 +985,53 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
                     l.push_back(composable.value);
                 }
                 return l;
+            }))
+        .function(
+            "get_children",
+            ems::optional_override([](OTIO_NS::Composition const& c) {
+                std::vector<OTIO_NS::SerializableObject*> l;
+                for (const auto& child: c.children())
+                {
+                    l.push_back(child.value);
+                }
+                return l;
+            }))
+        .function(
+            "set_children",
+            ems::optional_override(
+                [](OTIO_NS::Composition&                    c,
+                   std::vector<OTIO_NS::Composable*> const& children) {
+                    journal::set_children(c, children);
+                }),
+            ems::allow_raw_pointers())
+        .function(
+            "append_child",
+            ems::optional_override(
+                [](OTIO_NS::Composition& c, OTIO_NS::Composable* child) {
+                    return journal::append_child(c, child);
+                }),
+            ems::allow_raw_pointers())
+        .function(
+            "insert_child",
+            ems::optional_override([](OTIO_NS::Composition& c,
+                                      int                   index,
+                                      OTIO_NS::Composable*  child) {
+                return journal::insert_child(c, index, child);
+            }),
+            ems::allow_raw_pointers())
+        .function(
+            "remove_child",
+            ems::optional_override([](OTIO_NS::Composition& c, int index) {
+                return journal::remove_child(c, index);
             }));
 
     ADD_TO_STRING_TAG_PROPERTY(Composition);
 
+    ems::enum_<edit::ReferencePoint>("ReferencePoint")
+        .value("source", edit::ReferencePoint::source)
+        .value("sequence", edit::ReferencePoint::sequence)
+        .value("fit", edit::ReferencePoint::fit);
+
     ems::enum_<OTIO_NS::Track::NeighborGapPolicy>("TrackNeighborGapPolicy")
         .value(
             "around_transitions",
@@ -860,7 +1085,12 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
                 t->set_children(children, ErrorStatusHandler());
                 return t;
             }))
-        .property("kind", &OTIO_NS::Track::kind, &OTIO_NS::Track::set_kind)
+        .property(
+            "kind",
+            &OTIO_NS::Track::kind,
+            &journal::recording<
+                &OTIO_NS::Track::kind,
+                &OTIO_NS::Track::set_kind>)
         .function(
             "neighbors_of",
             ems::optional_override(
@@ -870,7 +1100,15 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
                     auto result =
                         t.neighbors_of(&item, ErrorStatusHandler(), policy);
                     return result;
-                }));
+                }))
+        .function("overwrite", &edit::overwrite, ems::allow_raw_pointers())
+        .function("insert", &edit::insert, ems::allow_raw_pointers())
+        .function("slice", &edit::slice)
+        .function("slip", &edit::slip, ems::allow_raw_pointers())
+        .function("slide", &edit::slide, ems::allow_raw_pointers())
+        .function("ripple", &edit::ripple, ems::allow_raw_pointers())
+        .function("roll", &edit::roll, ems::allow_raw_pointers())
+        .function("fill", &edit::fill, ems::allow_raw_pointers());
 
     ADD_TO_STRING_TAG_PROPERTY(Track);
 
@@ -900,7 +1138,20 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
     // TODO: Implement
     ems::class_<
         OTIO_NS::Timeline,
-        ems::base<OTIO_NS::SerializableObjectWithMetadata>>("Timeline");
+        ems::base<OTIO_NS::SerializableObjectWithMetadata>>("Timeline")
+        .function(
+            "tracks",
+            &OTIO_NS::Timeline::tracks,
+            ems::allow_raw_pointers())
+        .function(
+            "_tracks_address",
+            ems::optional_override([](OTIO_NS::Timeline const& timeline) {
+                return object_address(timeline.tracks());
+            }))
+        .function("snapshot_columns", &timeline_snapshot::snapshot_columns)
+        .function(
+            "snapshot_columns_since",
+            &timeline_snapshot::snapshot_columns_since);
 
     ADD_TO_STRING_TAG_PROPERTY(Timeline);
 
@@ -923,7 +1174,9 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
         .property(
             "effect_name",
             &OTIO_NS::Effect::effect_name,
-            &OTIO_NS::Effect::set_effect_name);
+            &journal::recording<
+                &OTIO_NS::Effect::effect_name,
+                &OTIO_NS::Effect::set_effect_name>);
 
     ADD_TO_STRING_TAG_PROPERTY(Effect);
 
@@ -964,7 +1217,9 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
         .property(
             "time_scalar",
             &OTIO_NS::LinearTimeWarp::time_scalar,
-            &OTIO_NS::LinearTimeWarp::set_time_scalar);
+            &journal::recording<
+                &OTIO_NS::LinearTimeWarp::time_scalar,
+                &OTIO_NS::LinearTimeWarp::set_time_scalar>);
 
     ADD_TO_STRING_TAG_PROPERTY(LinearTimeWarp);
 
@@ -1008,11 +1263,15 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
         .property(
             "available_range",
             &OTIO_NS::MediaReference::available_range,
-            &OTIO_NS::MediaReference::set_available_range)
+            &journal::recording<
+                &OTIO_NS::MediaReference::available_range,
+                &OTIO_NS::MediaReference::set_available_range>)
         .property(
             "available_image_bounds",
             &OTIO_NS::MediaReference::available_image_bounds,
-            &OTIO_NS::MediaReference::set_available_image_bounds)
+            &journal::recording<
+                &OTIO_NS::MediaReference::available_image_bounds,
+                &OTIO_NS::MediaReference::set_available_image_bounds>)
         .property(
             "is_missing_reference",
             &OTIO_NS::MediaReference::is_missing_reference);
@@ -1068,7 +1327,9 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
         .property(
             "generator_kind",
             &OTIO_NS::GeneratorReference::generator_kind,
-            &OTIO_NS::GeneratorReference::set_generator_kind)
+            &journal::recording<
+                &OTIO_NS::GeneratorReference::generator_kind,
+                &OTIO_NS::GeneratorReference::set_generator_kind>)
         .property(
             "parameters",
             // TODO: Should we use const or the reference? (Using the reference results in a compilation error)
@@ -1133,7 +1394,9 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
         .property(
             "target_url",
             &OTIO_NS::ExternalReference::target_url,
-            &OTIO_NS::ExternalReference::set_target_url);
+            &journal::recording<
+                &OTIO_NS::ExternalReference::target_url,
+                &OTIO_NS::ExternalReference::set_target_url>);
 
     ADD_TO_STRING_TAG_PROPERTY(ExternalReference);
 
@@ -1181,35 +1444,51 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
         .property(
             "target_url_base",
             &OTIO_NS::ImageSequenceReference::target_url_base,
-            &OTIO_NS::ImageSequenceReference::set_target_url_base)
+            &journal::recording<
+                &OTIO_NS::ImageSequenceReference::target_url_base,
+                &OTIO_NS::ImageSequenceReference::set_target_url_base>)
         .property(
             "name_prefix",
             &OTIO_NS::ImageSequenceReference::name_prefix,
-            &OTIO_NS::ImageSequenceReference::set_name_prefix)
+            &journal::recording<
+                &OTIO_NS::ImageSequenceReference::name_prefix,
+                &OTIO_NS::ImageSequenceReference::set_name_prefix>)
         .property(
             "name_suffix",
             &OTIO_NS::ImageSequenceReference::name_suffix,
-            &OTIO_NS::ImageSequenceReference::set_name_suffix)
+            &journal::recording<
+                &OTIO_NS::ImageSequenceReference::name_suffix,
+                &OTIO_NS::ImageSequenceReference::set_name_suffix>)
         .property(
             "start_frame",
             &OTIO_NS::ImageSequenceReference::start_frame,
-            &OTIO_NS::ImageSequenceReference::set_start_frame)
+            &journal::recording<
+                &OTIO_NS::ImageSequenceReference::start_frame,
+                &OTIO_NS::ImageSequenceReference::set_start_frame>)
         .property(
             "frame_step",
             &OTIO_NS::ImageSequenceReference::frame_step,
-            &OTIO_NS::ImageSequenceReference::set_frame_step)
+            &journal::recording<
+                &OTIO_NS::ImageSequenceReference::frame_step,
+                &OTIO_NS::ImageSequenceReference::set_frame_step>)
         .property(
             "rate",
             &OTIO_NS::ImageSequenceReference::rate,
-            &OTIO_NS::ImageSequenceReference::set_rate)
+            &journal::recording<
+                &OTIO_NS::ImageSequenceReference::rate,
+                &OTIO_NS::ImageSequenceReference::set_rate>)
         .property(
             "frame_zero_padding",
             &OTIO_NS::ImageSequenceReference::frame_zero_padding,
-            &OTIO_NS::ImageSequenceReference::set_frame_zero_padding)
+            &journal::recording<
+                &OTIO_NS::ImageSequenceReference::frame_zero_padding,
+                &OTIO_NS::ImageSequenceReference::set_frame_zero_padding>)
         .property(
             "missing_frame_policy",
             &OTIO_NS::ImageSequenceReference::missing_frame_policy,
-            &OTIO_NS::ImageSequenceReference::set_missing_frame_policy)
+            &journal::recording<
+                &OTIO_NS::ImageSequenceReference::missing_frame_policy,
+                &OTIO_NS::ImageSequenceReference::set_missing_frame_policy>)
         .function("end_frame", &OTIO_NS::ImageSequenceReference::end_frame)
         .function(
             "number_of_images_in_sequence",
@@ -1221,6 +1500,15 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
                    OTIO_NS::RationalTime                  time) {
                     return ref.frame_for_time(time, ErrorStatusHandler());
                 }))
+        .function(
+            "try_frame_for_time",
+            ems::optional_override(
+                [](OTIO_NS::ImageSequenceReference const& ref,
+                   OTIO_NS::RationalTime                  time) {
+                    OTIO_NS::ErrorStatus error_status;
+                    int frame = ref.frame_for_time(time, &error_status);
+                    return try_result(ems::val(frame), error_status);
+                }))
         .function(
             "target_url_for_image_number",
             ems::optional_override(
@@ -1230,6 +1518,21 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
                         image_number,
                         ErrorStatusHandler());
                 }))
+        .function(
+            "try_target_url_for_image_number",
+            ems::optional_override(
+                [](OTIO_NS::ImageSequenceReference const& ref,
+                   int                                    image_number) {
+                    OTIO_NS::ErrorStatus error_status;
+                    std::string          url = ref.target_url_for_image_number(
+                        image_number,
+                        &error_status);
+                    return try_result(ems::val(url), error_status);
+                }))
+        .function(
+            "target_urls_for_range",
+            &image_sequence_batch::target_urls_for_range)
+        .function("frames_for_times", &image_sequence_batch::frames_for_times)
         .function(
             "presentation_time_for_image_number",
             ems::optional_override(
@@ -1392,6 +1695,16 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
                     indent);
             }));
 
+    // Lets JS know whether file names refer to the host filesystem
+    // (NODERAWFS builds) or to the in-memory filesystem (default).
+    ems::function("filesystem_backend", ems::optional_override([]() {
+#ifdef OTIO_JS_NODERAWFS
+                      return std::string("NODERAWFS");
+#else
+                      return std::string("MEMFS");
+#endif
+                  }));
+
     ems::function(
         "deserialize_json_from_string",
         ems::optional_override([](std::string input) {
@@ -1415,6 +1728,17 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
             return any_to_js(result, true);
         }));
 
+    ems::function(
+        "object_from_handle",
+        ems::optional_override([](handle_table::Handle handle) {
+            OTIO_NS::SerializableObject* so = handle_table::get(handle);
+            if (!so)
+            {
+                throw ValueError("Stale handle");
+            }
+            return managing_ptr<OTIO_NS::SerializableObject>(so);
+        }));
+
     // TODO: Bind std::unordered_map
     ems::function("type_version_map", ems::optional_override([]() {
                       OTIO_NS::schema_version_map tmp;
@@ -1443,6 +1767,6 @@ EMSCRIPTEN_BINDINGS(opentimelineio)
         }),
         ems::allow_raw_pointers());
 
-    // TODO: register_upgrade_function
-    // TODO: register_downgrade_function
+    // register_upgrade_function and register_downgrade_function are in
+    // typeRegistry.cpp.
 }
@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+
+#include "byteBuffer.h"
+#include "common_utils.h"
+#include "exceptions.h"
+
+namespace ems = emscripten;
+
+ems::val
+ByteBuffer::view() const
+{
+    _ensure_not_released();
+    return ems::val(ems::typed_memory_view(
+        _data.size(),
+        reinterpret_cast<unsigned char const*>(_data.data())));
+}
+
+ems::val
+ByteBuffer::copy() const
+{
+    // slice() copies the bytes out of the WASM memory.
+    return view().call<ems::val>("slice");
+}
+
+void
+ByteBuffer::release()
+{
+    // clear() keeps the capacity around, swapping actually frees it.
+    std::string().swap(_data);
+    _released = true;
+}
+
+void
+ByteBuffer::_ensure_not_released() const
+{
+    if (_released)
+    {
+        throw ValueError("ByteBuffer has already been released");
+    }
+}
+
+EMSCRIPTEN_BINDINGS(opentimelineio_byteBuffer)
+{
+    ems::class_<ByteBuffer>("ByteBuffer")
+        .property("size", &ByteBuffer::size)
+        .property("released", &ByteBuffer::released)
+        .function("view", &ByteBuffer::view)
+        .function("copy", &ByteBuffer::copy)
+        .function("release", &ByteBuffer::release);
+
+    ADD_TO_STRING_TAG_PROPERTY(ByteBuffer);
+}
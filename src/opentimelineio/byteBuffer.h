@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#ifndef JS_BYTE_BUFFER_H
+#define JS_BYTE_BUFFER_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#include <emscripten/val.h>
+
+/**
+ * Owns bytes produced on the WASM heap (for example serialized JSON) so that
+ * they can be handed to JS as a Uint8Array instead of being decoded into a
+ * JS string first.
+ */
+class ByteBuffer
+{
+public:
+    ByteBuffer() = default;
+
+    explicit ByteBuffer(std::string&& data)
+        : _data(std::move(data))
+    {}
+
+    size_t size() const { return _data.size(); }
+
+    bool released() const { return _released; }
+
+    std::string const& data() const { return _data; }
+
+    // Uint8Array pointing directly into the WASM memory. The view is only
+    // valid until release() is called or until the memory grows.
+    emscripten::val view() const;
+
+    // Uint8Array backed by its own ArrayBuffer. Safe to keep around.
+    emscripten::val copy() const;
+
+    // Free the underlying memory without waiting for delete().
+    void release();
+
+private:
+    void _ensure_not_released() const;
+
+    std::string _data;
+    bool        _released = false;
+};
+
+#endif // JS_BYTE_BUFFER_H
@@ -0,0 +1,394 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+#include <emscripten/bind.h>
+#include <opentime/rationalTime.h>
+#include <opentime/timeRange.h>
+#include <opentimelineio/anyDictionary.h>
+#include <opentimelineio/composition.h>
+#include <opentimelineio/effect.h>
+#include <opentimelineio/item.h>
+#include <opentimelineio/marker.h>
+#include <opentimelineio/serializableCollection.h>
+#include <opentimelineio/serializableObject.h>
+#include <opentimelineio/serialization.h>
+#include <opentimelineio/stack.h>
+#include <opentimelineio/timeline.h>
+#include <opentimelineio/track.h>
+
+#include "contentHash.h"
+#include "deepClone.h"
+#include "errorStatusHandler.h"
+#include "mutation.h"
+
+namespace ems = emscripten;
+
+namespace content_hash {
+
+namespace {
+
+// FNV-1a, with a final mix so that close inputs don't give close hashes.
+class Hasher
+{
+public:
+    void add_bytes(void const* data, size_t size)
+    {
+        auto bytes = static_cast<unsigned char const*>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            _hash = (_hash ^ bytes[i]) * 0x100000001b3ull;
+        }
+    }
+
+    void add(uint64_t value) { add_bytes(&value, sizeof(value)); }
+
+    void add(bool value) { add(uint64_t(value)); }
+
+    // Adding 0 turns -0 into 0.
+    void add(double value)
+    {
+        value += 0.0;
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        add(bits);
+    }
+
+    void add(std::string const& value)
+    {
+        add(uint64_t(value.size()));
+        add_bytes(value.data(), value.size());
+    }
+
+    void add(OTIO_NS::RationalTime const& time)
+    {
+        add(time.value());
+        add(time.rate());
+    }
+
+    void add(OTIO_NS::TimeRange const& range)
+    {
+        add(range.start_time());
+        add(range.duration());
+    }
+
+    void add(OTIO_NS::AnyDictionary const& dictionary)
+    {
+        add(uint64_t(dictionary.size()));
+        if (!dictionary.empty())
+        {
+            add(OTIO_NS::serialize_json_to_string(
+                linb::any(dictionary),
+                nullptr,
+                ErrorStatusHandler(),
+                0));
+        }
+    }
+
+    Hash value() const
+    {
+        Hash value = _hash;
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdull;
+        value ^= value >> 33;
+        value *= 0xc4ceb9fe1a85ec53ull;
+        value ^= value >> 33;
+        return value;
+    }
+
+private:
+    uint64_t _hash = 0xcbf29ce484222325ull;
+};
+
+struct Entry
+{
+    OTIO_NS::SerializableObject::Retainer<OTIO_NS::SerializableObject> object;
+    Hash                                                               hash;
+    mutation::Stamp                                                    stamp;
+    mutation::Stamp detached_generation;
+
+    bool valid() const
+    {
+        return detached_generation == mutation::detached_generation()
+               && stamp == mutation::stamp(object.value);
+    }
+};
+
+std::unordered_map<OTIO_NS::SerializableObject const*, Entry>&
+_entries()
+{
+    static std::unordered_map<OTIO_NS::SerializableObject const*, Entry>
+        entries;
+    return entries;
+}
+
+void
+_add_header(Hasher& hasher, OTIO_NS::SerializableObject const& object)
+{
+    hasher.add(object.schema_name());
+    hasher.add(uint64_t(object.schema_version()));
+    hasher.add(
+        const_cast<OTIO_NS::SerializableObject&>(object).dynamic_fields());
+    if (auto with_metadata =
+            dynamic_cast<OTIO_NS::SerializableObjectWithMetadata const*>(
+                &object))
+    {
+        hasher.add(with_metadata->name());
+        hasher.add(with_metadata->metadata());
+    }
+}
+
+// Tracks and stacks are hashed from the hashes of their children, everything
+// else is a leaf.
+bool
+_is_merkle_composition(OTIO_NS::SerializableObject const& object)
+{
+    return dynamic_cast<OTIO_NS::Track const*>(&object)
+           || dynamic_cast<OTIO_NS::Stack const*>(&object);
+}
+
+Hash
+_compute(OTIO_NS::SerializableObject const& object)
+{
+    Hasher hasher;
+    if (auto timeline = dynamic_cast<OTIO_NS::Timeline const*>(&object))
+    {
+        _add_header(hasher, object);
+        auto global_start_time = timeline->global_start_time();
+        hasher.add(bool(global_start_time));
+        if (global_start_time)
+        {
+            hasher.add(*global_start_time);
+        }
+        hasher.add(hash(timeline->tracks()));
+    }
+    else if (
+        auto collection =
+            dynamic_cast<OTIO_NS::SerializableCollection const*>(&object))
+    {
+        _add_header(hasher, object);
+        hasher.add(uint64_t(collection->children().size()));
+        for (auto const& child: collection->children())
+        {
+            hasher.add(hash(child.value));
+        }
+    }
+    else if (_is_merkle_composition(object))
+    {
+        auto composition =
+            dynamic_cast<OTIO_NS::Composition const*>(&object);
+        _add_header(hasher, object);
+        auto source_range = composition->source_range();
+        hasher.add(bool(source_range));
+        if (source_range)
+        {
+            hasher.add(*source_range);
+        }
+        hasher.add(composition->enabled());
+        if (auto track = dynamic_cast<OTIO_NS::Track const*>(composition))
+        {
+            hasher.add(track->kind());
+        }
+        hasher.add(uint64_t(composition->effects().size()));
+        for (auto const& effect: composition->effects())
+        {
+            hasher.add(hash(effect.value));
+        }
+        hasher.add(uint64_t(composition->markers().size()));
+        for (auto const& marker: composition->markers())
+        {
+            hasher.add(hash(marker.value));
+        }
+        hasher.add(uint64_t(composition->children().size()));
+        for (auto const& child: composition->children())
+        {
+            hasher.add(hash(child.value));
+        }
+    }
+    else
+    {
+        hasher.add(object.to_json_string(ErrorStatusHandler(), {}, 0));
+    }
+    return hasher.value();
+}
+
+// The children that is_equivalent compares one by one: the tracks of a
+// timeline, the children of tracks, stacks and collections.
+std::vector<OTIO_NS::SerializableObject const*>
+_children(OTIO_NS::SerializableObject const& object)
+{
+    std::vector<OTIO_NS::SerializableObject const*> children;
+    if (auto timeline = dynamic_cast<OTIO_NS::Timeline const*>(&object))
+    {
+        children.push_back(timeline->tracks());
+    }
+    else if (
+        auto collection =
+            dynamic_cast<OTIO_NS::SerializableCollection const*>(&object))
+    {
+        for (auto const& child: collection->children())
+        {
+            children.push_back(child.value);
+        }
+    }
+    else if (
+        auto composition = dynamic_cast<OTIO_NS::Composition const*>(&object))
+    {
+        for (auto const& child: composition->children())
+        {
+            children.push_back(child.value);
+        }
+    }
+    return children;
+}
+
+} // namespace
+
+Hash
+hash(OTIO_NS::SerializableObject const* object)
+{
+    if (!object)
+    {
+        return 0;
+    }
+
+    // Timelines and collections only combine the hashes of their children,
+    // which are cached, and are rarely nested, so they aren't cached.
+    if (dynamic_cast<OTIO_NS::Timeline const*>(object)
+        || dynamic_cast<OTIO_NS::SerializableCollection const*>(object))
+    {
+        return _compute(*object);
+    }
+
+    auto& entries = _entries();
+    auto  it      = entries.find(object);
+    if (it != entries.end() && it->second.valid())
+    {
+        return it->second.hash;
+    }
+
+    mutation::Stamp stamp               = mutation::stamp(object);
+    mutation::Stamp detached_generation = mutation::detached_generation();
+    Hash            result              = _compute(*object);
+
+    // Computing the hashes of the children may have emptied the cache.
+    it = entries.find(object);
+    if (it != entries.end())
+    {
+        it->second.hash                = result;
+        it->second.stamp               = stamp;
+        it->second.detached_generation = detached_generation;
+        return result;
+    }
+
+    if (entries.size() >= max_size)
+    {
+        entries.clear();
+    }
+    entries.emplace(
+        object,
+        Entry{ OTIO_NS::SerializableObject::Retainer<
+                   OTIO_NS::SerializableObject>(
+                   const_cast<OTIO_NS::SerializableObject*>(object)),
+               result,
+               stamp,
+               detached_generation });
+    return result;
+}
+
+std::string
+hash_string(OTIO_NS::SerializableObject const* object)
+{
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016" PRIx64, hash(object));
+    return buffer;
+}
+
+bool
+is_equivalent(
+    OTIO_NS::SerializableObject const& lhs,
+    OTIO_NS::SerializableObject const& rhs)
+{
+    if (&lhs == &rhs || hash(&lhs) == hash(&rhs))
+    {
+        return true;
+    }
+    if (typeid(lhs) != typeid(rhs) || !deep_clone::is_container(&lhs))
+    {
+        return lhs.is_equivalent_to(rhs);
+    }
+
+    auto lhs_children = _children(lhs);
+    auto rhs_children = _children(rhs);
+    if (lhs_children.size() != rhs_children.size())
+    {
+        return false;
+    }
+    OTIO_NS::SerializableObject::Retainer<> lhs_fields(
+        deep_clone::clone_without_children(&lhs));
+    OTIO_NS::SerializableObject::Retainer<> rhs_fields(
+        deep_clone::clone_without_children(&rhs));
+    if (!lhs_fields.value->is_equivalent_to(*rhs_fields.value))
+    {
+        return false;
+    }
+    for (size_t i = 0; i < lhs_children.size(); ++i)
+    {
+        auto lhs_child = lhs_children[i];
+        auto rhs_child = rhs_children[i];
+        if (!lhs_child || !rhs_child)
+        {
+            if (lhs_child != rhs_child)
+            {
+                return false;
+            }
+        }
+        else if (!is_equivalent(*lhs_child, *rhs_child))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+forget(std::unordered_set<OTIO_NS::SerializableObject const*> const& objects)
+{
+    auto& entries = _entries();
+    for (auto object: objects)
+    {
+        entries.erase(object);
+    }
+}
+
+bool
+retains(OTIO_NS::SerializableObject const* object)
+{
+    return _entries().count(object) > 0;
+}
+
+size_t
+size()
+{
+    return _entries().size();
+}
+
+void
+clear()
+{
+    _entries().clear();
+}
+
+} // namespace content_hash
+
+EMSCRIPTEN_BINDINGS(opentimelineio_contentHash)
+{
+    ems::function("content_hash_cache_size", &content_hash::size);
+    ems::function("clear_content_hash_cache", &content_hash::clear);
+}
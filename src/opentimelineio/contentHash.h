@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+
+#include <opentimelineio/serializableObject.h>
+
+/**
+ * Structural hashes of objects, used to find out quickly whether two objects
+ * (or two states of the same object) differ.
+ *
+ * The hash of tracks, stacks, timelines and collections combines the hashes
+ * of their children with the hash of their own fields, so that after a
+ * modification only the hashes of the modified object and of its ancestors
+ * are computed again. Other objects (clips, gaps, media references, ...) are
+ * hashed from their JSON serialization.
+ *
+ * Hashes of composables are cached until the composable or one of its
+ * descendants is modified, the hashes of other objects until any object
+ * without an owner is modified (see mutation.h). Cached entries retain their
+ * object, so that a deleted object can't leave an entry behind for a new
+ * object created at the same address. When JS releases a root object, the
+ * handle table (see handleTable.h) makes the cache forget its tree, so a
+ * deleted timeline isn't kept alive by the cache. The cache holds at most
+ * max_size entries and is emptied when it's full.
+ *
+ * hash() must only be called on objects that something retains.
+ *
+ * The hash is computed from the exact content of the objects: objects with
+ * the same hash have the same fields (barring a 64 bits collision), so they
+ * are equivalent. The converse doesn't hold. SerializableObject's
+ * is_equivalent_to compares times once rescaled to the same rate, and ranges
+ * with an epsilon, so 1@24 and 2@48 are equivalent but don't have the same
+ * hash.
+ */
+namespace content_hash {
+
+using Hash = uint64_t;
+
+constexpr size_t max_size = 1 << 16;
+
+Hash hash(OTIO_NS::SerializableObject const* object);
+
+// The hash as 16 hexadecimal digits. JS numbers can't hold every 64 bits
+// value.
+std::string hash_string(OTIO_NS::SerializableObject const* object);
+
+// Same as SerializableObject::is_equivalent_to, but subtrees whose hashes are
+// equal are equivalent without being compared. Only the containers (see
+// deep_clone::is_container) whose hashes differ are compared field by field,
+// and their children recursively, so comparing two versions of a timeline
+// only compares the paths to the modified objects.
+bool is_equivalent(
+    OTIO_NS::SerializableObject const& lhs,
+    OTIO_NS::SerializableObject const& rhs);
+
+// Drop the entries of objects.
+void forget(
+    std::unordered_set<OTIO_NS::SerializableObject const*> const& objects);
+
+// Whether the cache retains object.
+bool retains(OTIO_NS::SerializableObject const* object);
+
+size_t size();
+void   clear();
+
+} // namespace content_hash
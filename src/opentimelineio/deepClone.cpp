@@ -0,0 +1,344 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+#include <typeinfo>
+#include <vector>
+
+#include <opentimelineio/anyDictionary.h>
+#include <opentimelineio/anyVector.h>
+#include <opentimelineio/clip.h>
+#include <opentimelineio/composable.h>
+#include <opentimelineio/effect.h>
+#include <opentimelineio/externalReference.h>
+#include <opentimelineio/freezeFrame.h>
+#include <opentimelineio/gap.h>
+#include <opentimelineio/generatorReference.h>
+#include <opentimelineio/imageSequenceReference.h>
+#include <opentimelineio/item.h>
+#include <opentimelineio/linearTimeWarp.h>
+#include <opentimelineio/marker.h>
+#include <opentimelineio/mediaReference.h>
+#include <opentimelineio/missingReference.h>
+#include <opentimelineio/serializableCollection.h>
+#include <opentimelineio/stack.h>
+#include <opentimelineio/timeEffect.h>
+#include <opentimelineio/timeline.h>
+#include <opentimelineio/track.h>
+#include <opentimelineio/transition.h>
+
+#include "deepClone.h"
+#include "errorStatusHandler.h"
+
+namespace deep_clone {
+
+namespace {
+
+using Retainer = OTIO_NS::SerializableObject::Retainer<>;
+
+template <typename T>
+bool
+_is(OTIO_NS::SerializableObject const* object)
+{
+    return typeid(*object) == typeid(T);
+}
+
+linb::any _copy_any(linb::any const& value);
+
+OTIO_NS::AnyDictionary
+_copy_dictionary(OTIO_NS::AnyDictionary const& dictionary)
+{
+    OTIO_NS::AnyDictionary result;
+    for (auto const& field: dictionary)
+    {
+        result.emplace(field.first, _copy_any(field.second));
+    }
+    return result;
+}
+
+// Values are copied as is, except for objects, which are cloned.
+linb::any
+_copy_any(linb::any const& value)
+{
+    auto const& type = value.type();
+    if (type == typeid(OTIO_NS::AnyDictionary))
+    {
+        return _copy_dictionary(
+            linb::any_cast<OTIO_NS::AnyDictionary const&>(value));
+    }
+    if (type == typeid(OTIO_NS::AnyVector))
+    {
+        OTIO_NS::AnyVector result;
+        for (auto const& element:
+             linb::any_cast<OTIO_NS::AnyVector const&>(value))
+        {
+            result.push_back(_copy_any(element));
+        }
+        return result;
+    }
+    if (type == typeid(Retainer))
+    {
+        return Retainer(clone(linb::any_cast<Retainer const&>(value).value));
+    }
+    return value;
+}
+
+template <typename T>
+T*
+_clone_as(T const* object)
+{
+    return static_cast<T*>(clone(object));
+}
+
+void
+_copy_item(OTIO_NS::Item const& from, OTIO_NS::Item& to)
+{
+    to.set_source_range(from.source_range());
+    to.set_enabled(from.enabled());
+    for (auto const& effect: from.effects())
+    {
+        to.effects().push_back(
+            OTIO_NS::SerializableObject::Retainer<OTIO_NS::Effect>(
+                _clone_as(effect.value)));
+    }
+    for (auto const& marker: from.markers())
+    {
+        to.markers().push_back(
+            OTIO_NS::SerializableObject::Retainer<OTIO_NS::Marker>(
+                _clone_as(marker.value)));
+    }
+}
+
+void
+_copy_media_reference(
+    OTIO_NS::MediaReference const& from,
+    OTIO_NS::MediaReference&       to)
+{
+    to.set_available_range(from.available_range());
+    to.set_available_image_bounds(from.available_image_bounds());
+}
+
+void
+_copy_composition_children(
+    OTIO_NS::Composition const& from,
+    OTIO_NS::Composition&       to)
+{
+    std::vector<OTIO_NS::Composable*> children;
+    children.reserve(from.children().size());
+    for (auto const& child: from.children())
+    {
+        children.push_back(_clone_as(child.value));
+    }
+    to.set_children(children, ErrorStatusHandler());
+}
+
+// Copy of the fields of object, other than the ones common to every
+// SerializableObjectWithMetadata. nullptr for types that aren't known.
+OTIO_NS::SerializableObject*
+_copy(OTIO_NS::SerializableObject const* object, bool children)
+{
+    if (_is<OTIO_NS::Clip>(object))
+    {
+        auto from = static_cast<OTIO_NS::Clip const*>(object);
+        auto to   = new OTIO_NS::Clip();
+        _copy_item(*from, *to);
+        OTIO_NS::Clip::MediaReferences references;
+        for (auto const& reference: from->media_references())
+        {
+            references[reference.first] = _clone_as(reference.second);
+        }
+        to->set_media_references(
+            references,
+            from->active_media_reference_key(),
+            ErrorStatusHandler());
+        return to;
+    }
+    if (_is<OTIO_NS::Gap>(object))
+    {
+        auto to = new OTIO_NS::Gap();
+        _copy_item(*static_cast<OTIO_NS::Item const*>(object), *to);
+        return to;
+    }
+    if (_is<OTIO_NS::Track>(object))
+    {
+        auto from = static_cast<OTIO_NS::Track const*>(object);
+        auto to   = new OTIO_NS::Track();
+        _copy_item(*from, *to);
+        to->set_kind(from->kind());
+        if (children)
+        {
+            _copy_composition_children(*from, *to);
+        }
+        return to;
+    }
+    if (_is<OTIO_NS::Stack>(object))
+    {
+        auto from = static_cast<OTIO_NS::Stack const*>(object);
+        auto to   = new OTIO_NS::Stack();
+        _copy_item(*from, *to);
+        if (children)
+        {
+            _copy_composition_children(*from, *to);
+        }
+        return to;
+    }
+    if (_is<OTIO_NS::Transition>(object))
+    {
+        auto from = static_cast<OTIO_NS::Transition const*>(object);
+        auto to   = new OTIO_NS::Transition();
+        to->set_transition_type(from->transition_type());
+        to->set_in_offset(from->in_offset());
+        to->set_out_offset(from->out_offset());
+        return to;
+    }
+    if (_is<OTIO_NS::Timeline>(object))
+    {
+        auto from = static_cast<OTIO_NS::Timeline const*>(object);
+        auto to   = new OTIO_NS::Timeline();
+        to->set_global_start_time(from->global_start_time());
+        if (children && from->tracks())
+        {
+            to->set_tracks(_clone_as(from->tracks()));
+        }
+        return to;
+    }
+    if (_is<OTIO_NS::SerializableCollection>(object))
+    {
+        auto from = static_cast<OTIO_NS::SerializableCollection const*>(object);
+        auto to   = new OTIO_NS::SerializableCollection();
+        if (children)
+        {
+            std::vector<OTIO_NS::SerializableObject*> copies;
+            copies.reserve(from->children().size());
+            for (auto const& child: from->children())
+            {
+                copies.push_back(child.value ? clone(child.value) : nullptr);
+            }
+            to->set_children(copies);
+        }
+        return to;
+    }
+    if (_is<OTIO_NS::ExternalReference>(object))
+    {
+        auto from = static_cast<OTIO_NS::ExternalReference const*>(object);
+        auto to   = new OTIO_NS::ExternalReference(from->target_url());
+        _copy_media_reference(*from, *to);
+        return to;
+    }
+    if (_is<OTIO_NS::MissingReference>(object))
+    {
+        auto to = new OTIO_NS::MissingReference();
+        _copy_media_reference(
+            *static_cast<OTIO_NS::MediaReference const*>(object),
+            *to);
+        return to;
+    }
+    if (_is<OTIO_NS::GeneratorReference>(object))
+    {
+        auto from = static_cast<OTIO_NS::GeneratorReference const*>(object);
+        auto to   = new OTIO_NS::GeneratorReference();
+        _copy_media_reference(*from, *to);
+        to->set_generator_kind(from->generator_kind());
+        to->parameters() = _copy_dictionary(from->parameters());
+        return to;
+    }
+    if (_is<OTIO_NS::ImageSequenceReference>(object))
+    {
+        auto from = static_cast<OTIO_NS::ImageSequenceReference const*>(object);
+        auto to   = new OTIO_NS::ImageSequenceReference();
+        _copy_media_reference(*from, *to);
+        to->set_target_url_base(from->target_url_base());
+        to->set_name_prefix(from->name_prefix());
+        to->set_name_suffix(from->name_suffix());
+        to->set_start_frame(from->start_frame());
+        to->set_frame_step(from->frame_step());
+        to->set_rate(from->rate());
+        to->set_frame_zero_padding(from->frame_zero_padding());
+        to->set_missing_frame_policy(from->missing_frame_policy());
+        return to;
+    }
+    if (_is<OTIO_NS::Marker>(object))
+    {
+        auto from = static_cast<OTIO_NS::Marker const*>(object);
+        auto to   = new OTIO_NS::Marker();
+        to->set_marked_range(from->marked_range());
+        to->set_color(from->color());
+        return to;
+    }
+    // FreezeFrame and LinearTimeWarp only differ by their effect name and
+    // time scalar, which are copied.
+    if (_is<OTIO_NS::LinearTimeWarp>(object)
+        || _is<OTIO_NS::FreezeFrame>(object))
+    {
+        auto from = static_cast<OTIO_NS::LinearTimeWarp const*>(object);
+        auto to   = _is<OTIO_NS::FreezeFrame>(object)
+                        ? new OTIO_NS::FreezeFrame()
+                        : new OTIO_NS::LinearTimeWarp();
+        to->set_effect_name(from->effect_name());
+        to->set_time_scalar(from->time_scalar());
+        return to;
+    }
+    if (_is<OTIO_NS::Effect>(object) || _is<OTIO_NS::TimeEffect>(object))
+    {
+        auto from = static_cast<OTIO_NS::Effect const*>(object);
+        auto to   = _is<OTIO_NS::TimeEffect>(object) ? new OTIO_NS::TimeEffect()
+                                                     : new OTIO_NS::Effect();
+        to->set_effect_name(from->effect_name());
+        return to;
+    }
+    if (_is<OTIO_NS::SerializableObjectWithMetadata>(object))
+    {
+        return new OTIO_NS::SerializableObjectWithMetadata();
+    }
+    return nullptr;
+}
+
+OTIO_NS::SerializableObject*
+_clone(OTIO_NS::SerializableObject const* object, bool children)
+{
+    if (!object)
+    {
+        return nullptr;
+    }
+
+    OTIO_NS::SerializableObject* result = _copy(object, children);
+    if (!result)
+    {
+        return object->clone(ErrorStatusHandler());
+    }
+
+    if (auto from =
+            dynamic_cast<OTIO_NS::SerializableObjectWithMetadata const*>(
+                object))
+    {
+        auto to = static_cast<OTIO_NS::SerializableObjectWithMetadata*>(result);
+        to->set_name(from->name());
+        to->metadata() = _copy_dictionary(from->metadata());
+    }
+    result->dynamic_fields() = _copy_dictionary(
+        const_cast<OTIO_NS::SerializableObject*>(object)->dynamic_fields());
+    return result;
+}
+
+} // namespace
+
+OTIO_NS::SerializableObject*
+clone(OTIO_NS::SerializableObject const* object)
+{
+    return _clone(object, true);
+}
+
+bool
+is_container(OTIO_NS::SerializableObject const* object)
+{
+    return object
+           && (_is<OTIO_NS::Timeline>(object) || _is<OTIO_NS::Track>(object)
+               || _is<OTIO_NS::Stack>(object)
+               || _is<OTIO_NS::SerializableCollection>(object));
+}
+
+OTIO_NS::SerializableObject*
+clone_without_children(OTIO_NS::SerializableObject const* object)
+{
+    return _clone(object, false);
+}
+
+} // namespace deep_clone
@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include <opentimelineio/serializableObject.h>
+
+/**
+ * Deep copies of objects that copy the fields of the known schemas directly,
+ * instead of going through the serializer like SerializableObject::clone.
+ * Objects of other types (JS defined schemas, unknown schemas, ...) are still
+ * copied with SerializableObject::clone. Objects held in metadata or in
+ * dynamic fields are copied too.
+ *
+ * The copies are new objects that nothing retains yet.
+ */
+namespace deep_clone {
+
+OTIO_NS::SerializableObject* clone(OTIO_NS::SerializableObject const* object);
+
+// Whether clone_without_children leaves the children (or tracks) out.
+bool is_container(OTIO_NS::SerializableObject const* object);
+
+// Same as clone, but leaves out the children of containers (the tracks of
+// timelines, the children of tracks, stacks and collections).
+OTIO_NS::SerializableObject*
+clone_without_children(OTIO_NS::SerializableObject const* object);
+
+} // namespace deep_clone
@@ -0,0 +1,530 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+#include <opentime/timeRange.h>
+#include <opentimelineio/clip.h>
+#include <opentimelineio/gap.h>
+#include <opentimelineio/linearTimeWarp.h>
+#include <opentimelineio/mediaReference.h>
+
+#include "deepClone.h"
+#include "editAlgorithm.h"
+#include "errorStatusHandler.h"
+#include "exceptions.h"
+#include "journal.h"
+
+namespace edit {
+
+namespace {
+
+using OTIO_NS::RationalTime;
+using OTIO_NS::TimeRange;
+
+// Records an operation as a single step of the recording journal.
+class Group
+{
+public:
+    Group()
+        : _journal(journal::active())
+    {
+        if (_journal)
+        {
+            _journal->begin_group();
+        }
+    }
+
+    ~Group()
+    {
+        if (_journal)
+        {
+            _journal->end_group();
+        }
+    }
+
+    Group(Group const&)            = delete;
+    Group& operator=(Group const&) = delete;
+
+private:
+    Journal* _journal;
+};
+
+// Where a cut of the track is: the index of the first child after it, and
+// the two halves of the item that was split, if any.
+struct Cut
+{
+    size_t         index = 0;
+    OTIO_NS::Item* left  = nullptr;
+    OTIO_NS::Item* right = nullptr;
+};
+
+// Start of every child of the track, followed by the end of the track.
+std::vector<RationalTime>
+_starts(OTIO_NS::Track const& track)
+{
+    auto const&               children = track.children();
+    std::vector<RationalTime> starts;
+    starts.reserve(children.size() + 1);
+    RationalTime time;
+    for (auto const& child: children)
+    {
+        starts.push_back(time);
+        if (!child.value->overlapping())
+        {
+            time += child.value->duration(ErrorStatusHandler());
+        }
+    }
+    starts.push_back(time);
+    return starts;
+}
+
+// Index of the item under time, or the number of children if time is past
+// the end of the track.
+size_t
+_index_at(
+    OTIO_NS::Track const&            track,
+    std::vector<RationalTime> const& starts,
+    RationalTime                     time)
+{
+    auto const& children = track.children();
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+        if (!children[i].value->overlapping() && starts[i] <= time
+            && time < starts[i + 1])
+        {
+            return i;
+        }
+    }
+    return children.size();
+}
+
+size_t
+_index_of(OTIO_NS::Track const& track, OTIO_NS::Item const* item)
+{
+    if (!item || item->parent() != &track)
+    {
+        throw NotAChildError("Item is not a child of the track");
+    }
+    auto const& children = track.children();
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+        if (children[i].value == item)
+        {
+            return i;
+        }
+    }
+    throw NotAChildError("Item is not a child of the track");
+}
+
+// Checks an item that is about to be added to the track, before the track is
+// modified.
+void
+_check_new(OTIO_NS::Track const& track, OTIO_NS::Item const* item)
+{
+    if (!item)
+    {
+        throw ValueError("Item is null");
+    }
+    if (item == &track || item->parent())
+    {
+        throw ValueError("Item already has a parent");
+    }
+}
+
+// Times before the start of the track have no item to cut or gap to pad.
+void
+_check_time(RationalTime time)
+{
+    if (time.value() < 0)
+    {
+        throw ValueError("Time is negative");
+    }
+}
+
+// The closest item before (step -1) or after (step 1) index, skipping the
+// transitions.
+OTIO_NS::Item*
+_neighbor(OTIO_NS::Track const& track, size_t index, int step)
+{
+    auto const& children = track.children();
+    for (size_t i = index + step; i < children.size(); i += step)
+    {
+        if (!children[i].value->overlapping())
+        {
+            return dynamic_cast<OTIO_NS::Item*>(children[i].value);
+        }
+    }
+    return nullptr;
+}
+
+TimeRange
+_trimmed(OTIO_NS::Item const* item)
+{
+    return item->trimmed_range(ErrorStatusHandler());
+}
+
+std::optional<TimeRange>
+_available(OTIO_NS::Item const* item)
+{
+    auto clip = dynamic_cast<OTIO_NS::Clip const*>(item);
+    if (!clip || !clip->media_reference())
+    {
+        return std::nullopt;
+    }
+    return clip->media_reference()->available_range();
+}
+
+void
+_set_range(OTIO_NS::Item* item, TimeRange const& range)
+{
+    journal::recording<
+        &OTIO_NS::Item::source_range,
+        &OTIO_NS::Item::set_source_range>(*item, range);
+}
+
+OTIO_NS::Gap*
+_gap(RationalTime duration)
+{
+    auto gap = new OTIO_NS::Gap();
+    gap->set_source_range(TimeRange(RationalTime(0, duration.rate()), duration));
+    return gap;
+}
+
+// Appends a gap if time is past the end of the track.
+void
+_pad(OTIO_NS::Track& track, RationalTime time, Affected& affected)
+{
+    RationalTime end = _starts(track).back();
+    if (end < time)
+    {
+        OTIO_NS::Gap* gap = _gap(time - end);
+        journal::append_child(track, gap);
+        affected.push_back(gap);
+    }
+}
+
+// Makes a child of the track start at time, by splitting the item under
+// time.
+Cut
+_cut(OTIO_NS::Track& track, RationalTime time, bool remove_transitions)
+{
+    auto        starts   = _starts(track);
+    auto const& children = track.children();
+    Cut         cut;
+    cut.index = _index_at(track, starts, time);
+    if (cut.index < children.size() && starts[cut.index] < time)
+    {
+        cut.left = static_cast<OTIO_NS::Item*>(children[cut.index].value);
+        TimeRange    range  = _trimmed(cut.left);
+        RationalTime offset = time - starts[cut.index];
+        cut.right           = static_cast<OTIO_NS::Item*>(
+            deep_clone::clone(cut.left));
+        cut.right->set_source_range(TimeRange(
+            range.start_time() + offset,
+            range.duration() - offset));
+        _set_range(cut.left, TimeRange(range.start_time(), offset));
+        journal::insert_child(track, static_cast<int>(cut.index) + 1, cut.right);
+        ++cut.index;
+        return cut;
+    }
+
+    while (remove_transitions && cut.index > 0
+           && children[cut.index - 1].value->overlapping())
+    {
+        journal::remove_child(track, static_cast<int>(--cut.index));
+    }
+    return cut;
+}
+
+} // namespace
+
+Affected
+overwrite(OTIO_NS::Track& track, OTIO_NS::Item* item, RationalTime time)
+{
+    _check_new(track, item);
+    _check_time(time);
+    RationalTime duration = _trimmed(item).duration();
+
+    Group    group;
+    Affected affected;
+    _pad(track, time, affected);
+    Cut first = _cut(track, time, true);
+    if (first.left)
+    {
+        affected.push_back(first.left);
+    }
+    Cut last = _cut(track, time + duration, true);
+    for (size_t i = first.index; i < last.index; ++i)
+    {
+        journal::remove_child(track, static_cast<int>(first.index));
+    }
+    journal::insert_child(track, static_cast<int>(first.index), item);
+    affected.push_back(item);
+    if (last.right)
+    {
+        affected.push_back(last.right);
+    }
+    return affected;
+}
+
+Affected
+insert(OTIO_NS::Track& track, OTIO_NS::Item* item, RationalTime time)
+{
+    _check_new(track, item);
+    _check_time(time);
+
+    Group    group;
+    Affected affected;
+    _pad(track, time, affected);
+    Cut cut = _cut(track, time, true);
+    if (cut.left)
+    {
+        affected.push_back(cut.left);
+    }
+    journal::insert_child(track, static_cast<int>(cut.index), item);
+    affected.push_back(item);
+    if (cut.right)
+    {
+        affected.push_back(cut.right);
+    }
+    return affected;
+}
+
+Affected
+slice(OTIO_NS::Track& track, RationalTime time)
+{
+    _check_time(time);
+    Group group;
+    Cut   cut = _cut(track, time, false);
+    if (!cut.left)
+    {
+        return {};
+    }
+    return { cut.left, cut.right };
+}
+
+Affected
+slip(OTIO_NS::Track& track, OTIO_NS::Item* item, RationalTime delta)
+{
+    _index_of(track, item);
+    TimeRange    range = _trimmed(item);
+    RationalTime start = range.start_time() + delta;
+    if (auto available = _available(item))
+    {
+        start = std::min(
+            start,
+            available->end_time_exclusive() - range.duration());
+        start = std::max(start, available->start_time());
+    }
+    _set_range(item, TimeRange(start, range.duration()));
+    return { item };
+}
+
+Affected
+slide(OTIO_NS::Track& track, OTIO_NS::Item* item, RationalTime delta)
+{
+    OTIO_NS::Item* previous = _neighbor(track, _index_of(track, item), -1);
+    if (!previous)
+    {
+        return {};
+    }
+
+    TimeRange    range    = _trimmed(previous);
+    RationalTime duration = range.duration() + delta;
+    if (auto available = _available(previous))
+    {
+        duration = std::min(
+            duration,
+            available->end_time_exclusive() - range.start_time());
+    }
+    duration = std::max(duration, RationalTime(0, duration.rate()));
+    _set_range(previous, TimeRange(range.start_time(), duration));
+    return { previous, item };
+}
+
+Affected
+ripple(
+    OTIO_NS::Track& track,
+    OTIO_NS::Item*  item,
+    RationalTime    delta_in,
+    RationalTime    delta_out)
+{
+    _index_of(track, item);
+    TimeRange    range = _trimmed(item);
+    RationalTime start = range.start_time() + delta_in;
+    RationalTime end   = range.end_time_exclusive() + delta_out;
+    if (auto available = _available(item))
+    {
+        start = std::max(start, available->start_time());
+        end   = std::min(end, available->end_time_exclusive());
+    }
+    end = std::max(end, start);
+    _set_range(item, TimeRange::range_from_start_end_time(start, end));
+    return { item };
+}
+
+Affected
+roll(
+    OTIO_NS::Track& track,
+    OTIO_NS::Item*  item,
+    RationalTime    delta_in,
+    RationalTime    delta_out)
+{
+    size_t         index     = _index_of(track, item);
+    OTIO_NS::Item* previous  = _neighbor(track, index, -1);
+    OTIO_NS::Item* next      = _neighbor(track, index, 1);
+    TimeRange      range     = _trimmed(item);
+    RationalTime   start     = range.start_time();
+    RationalTime   end       = range.end_time_exclusive();
+    auto           available = _available(item);
+
+    Group    group;
+    Affected affected;
+    if (previous)
+    {
+        // The previous item and item keep a duration of at least 0.
+        TimeRange    previous_range = _trimmed(previous);
+        RationalTime delta          = std::min(delta_in, end - start);
+        delta                       = std::max(
+            delta,
+            RationalTime(0, delta.rate()) - previous_range.duration());
+        if (available)
+        {
+            delta = std::max(delta, available->start_time() - start);
+        }
+        if (auto previous_available = _available(previous))
+        {
+            delta = std::min(
+                delta,
+                previous_available->end_time_exclusive()
+                    - previous_range.end_time_exclusive());
+        }
+        if (delta.value() != 0)
+        {
+            _set_range(
+                previous,
+                TimeRange(
+                    previous_range.start_time(),
+                    previous_range.duration() + delta));
+            start += delta;
+            affected.push_back(previous);
+        }
+    }
+    affected.push_back(item);
+    if (next)
+    {
+        TimeRange    next_range = _trimmed(next);
+        RationalTime delta      = std::min(delta_out, next_range.duration());
+        delta                   = std::max(delta, start - end);
+        if (available)
+        {
+            delta = std::min(delta, available->end_time_exclusive() - end);
+        }
+        if (auto next_available = _available(next))
+        {
+            delta = std::max(
+                delta,
+                next_available->start_time() - next_range.start_time());
+        }
+        if (delta.value() != 0)
+        {
+            _set_range(
+                next,
+                TimeRange(
+                    next_range.start_time() + delta,
+                    next_range.duration() - delta));
+            end += delta;
+            affected.push_back(next);
+        }
+    }
+    _set_range(item, TimeRange::range_from_start_end_time(start, end));
+    return affected;
+}
+
+Affected
+fill(
+    OTIO_NS::Track& track,
+    OTIO_NS::Item*  item,
+    RationalTime    time,
+    ReferencePoint  reference_point)
+{
+    _check_new(track, item);
+    _check_time(time);
+    auto        starts   = _starts(track);
+    auto const& children = track.children();
+    size_t      index    = _index_at(track, starts, time);
+    auto        gap      = index < children.size()
+                               ? dynamic_cast<OTIO_NS::Gap*>(children[index].value)
+                               : nullptr;
+    if (!gap)
+    {
+        throw ValueError("There is no gap at the given time");
+    }
+
+    RationalTime gap_start = starts[index];
+    RationalTime gap_end   = starts[index + 1];
+    TimeRange    range     = _trimmed(item);
+    RationalTime start     = gap_start;
+    RationalTime duration  = std::min(range.duration(), gap_end - gap_start);
+    switch (reference_point)
+    {
+        case ReferencePoint::source:
+            start    = time;
+            duration = std::min(range.duration(), gap_end - time);
+            break;
+        case ReferencePoint::sequence:
+            break;
+        case ReferencePoint::fit:
+            duration = gap_end - gap_start;
+            break;
+    }
+
+    Group    group;
+    Affected affected;
+    if (reference_point == ReferencePoint::fit)
+    {
+        journal::insert_element<OTIO_NS::Effect>(
+            *item,
+            item->effects().size(),
+            new OTIO_NS::LinearTimeWarp(
+                "",
+                "LinearTimeWarp",
+                range.duration().to_seconds() / duration.to_seconds()));
+    }
+    _set_range(item, TimeRange(range.start_time(), duration));
+    TimeRange    gap_range = _trimmed(gap);
+    RationalTime before    = start - gap_start;
+    RationalTime after     = gap_end - (start + duration);
+    int          position  = static_cast<int>(index);
+    if (before.value() > 0)
+    {
+        _set_range(gap, TimeRange(gap_range.start_time(), before));
+        affected.push_back(gap);
+        journal::insert_child(track, position + 1, item);
+        affected.push_back(item);
+        if (after.value() > 0)
+        {
+            OTIO_NS::Gap* rest = _gap(after);
+            journal::insert_child(track, position + 2, rest);
+            affected.push_back(rest);
+        }
+    }
+    else if (after.value() > 0)
+    {
+        _set_range(gap, TimeRange(gap_range.start_time(), after));
+        journal::insert_child(track, position, item);
+        affected.push_back(item);
+        affected.push_back(gap);
+    }
+    else
+    {
+        journal::remove_child(track, position);
+        journal::insert_child(track, position, item);
+        affected.push_back(item);
+    }
+    return affected;
+}
+
+} // namespace edit
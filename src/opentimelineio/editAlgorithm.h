@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include <vector>
+
+#include <opentime/rationalTime.h>
+#include <opentimelineio/item.h>
+#include <opentimelineio/track.h>
+
+/**
+ * Editorial operations on the children of a track.
+ *
+ * Times are track times, deltas are durations. Transitions don't take any
+ * time in the track, like in Track::range_of_child_at_index(). Operations
+ * that cut the track between two children remove the transitions at the cut.
+ * Items are trimmed within the available range of their media reference when
+ * it is known.
+ *
+ * Every operation returns the items it inserted or modified that are still
+ * children of the track, not the ones it removed (which may already be
+ * deleted). The modifications go through journal.h, so an operation is a
+ * single undo step of the recording journal and touches what it modifies.
+ *
+ * The operations that add an item to the track throw ValueError if it's null
+ * or already has a parent, and the ones that take a time throw ValueError if
+ * it's negative, before modifying anything.
+ */
+namespace edit {
+
+enum class ReferencePoint
+{
+    // The item starts at the given time and keeps its in point. It's trimmed
+    // at the end of the gap.
+    source,
+    // The item fills the gap from its start, trimmed to the duration of the
+    // gap.
+    sequence,
+    // The item fills the gap and is time warped to fit it: a LinearTimeWarp
+    // is appended to its effects.
+    fit,
+};
+
+using Affected = std::vector<OTIO_NS::SerializableObject*>;
+
+// Place item at time, replacing what it covers. The track is padded with a
+// gap if time is past its end.
+Affected overwrite(
+    OTIO_NS::Track&       track,
+    OTIO_NS::Item*        item,
+    OTIO_NS::RationalTime time);
+
+// Insert item at time, splitting the item under time. The following items
+// are pushed later.
+Affected insert(
+    OTIO_NS::Track&       track,
+    OTIO_NS::Item*        item,
+    OTIO_NS::RationalTime time);
+
+// Split the item under time in two.
+Affected slice(OTIO_NS::Track& track, OTIO_NS::RationalTime time);
+
+// Move the source range of item by delta, without moving it in the track.
+Affected slip(
+    OTIO_NS::Track&       track,
+    OTIO_NS::Item*        item,
+    OTIO_NS::RationalTime delta);
+
+// Move item by delta in the track by changing the duration of the previous
+// item. The following items move with it.
+Affected slide(
+    OTIO_NS::Track&       track,
+    OTIO_NS::Item*        item,
+    OTIO_NS::RationalTime delta);
+
+// Move the in and out points of item. The following items move with its out
+// point.
+Affected ripple(
+    OTIO_NS::Track&       track,
+    OTIO_NS::Item*        item,
+    OTIO_NS::RationalTime delta_in,
+    OTIO_NS::RationalTime delta_out);
+
+// Move the in and out points of item along with the out point of the
+// previous item and the in point of the next one. The duration of the track
+// doesn't change.
+Affected roll(
+    OTIO_NS::Track&       track,
+    OTIO_NS::Item*        item,
+    OTIO_NS::RationalTime delta_in,
+    OTIO_NS::RationalTime delta_out);
+
+// Place item in the gap under time. Throws ValueError if there is no gap at
+// time, leaving item unchanged.
+Affected fill(
+    OTIO_NS::Track&       track,
+    OTIO_NS::Item*        item,
+    OTIO_NS::RationalTime time,
+    ReferencePoint        reference_point);
+
+} // namespace edit
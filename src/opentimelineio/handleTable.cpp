@@ -0,0 +1,350 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <emscripten/bind.h>
+#include <opentimelineio/clip.h>
+#include <opentimelineio/composition.h>
+#include <opentimelineio/serializableCollection.h>
+#include <opentimelineio/timeline.h>
+
+#include "contentHash.h"
+#include "exceptions.h"
+#include "handleTable.h"
+#include "transformCache.h"
+
+namespace ems = emscripten;
+
+namespace handle_table {
+
+namespace {
+
+constexpr uint32_t index_bits = 24;
+constexpr uint32_t index_mask = (1u << index_bits) - 1;
+
+struct Slot
+{
+    OTIO_NS::SerializableObject::Retainer<> object;
+    uint32_t                                wrappers = 0;
+    uint32_t                                handles  = 0;
+    // Starts at 1 so that null is never a valid handle.
+    uint8_t generation = 1;
+    bool    shared     = false;
+};
+
+struct Table
+{
+    // A deque so that the slots aren't copied (retaining and releasing their
+    // objects) when the table grows.
+    std::deque<Slot>      slots;
+    std::vector<uint32_t> free;
+    std::unordered_map<OTIO_NS::SerializableObject const*, uint32_t> indices;
+};
+
+Table&
+_table()
+{
+    static Table table;
+    return table;
+}
+
+Handle
+_handle(uint32_t index, uint8_t generation)
+{
+    return (Handle(generation) << index_bits) | index;
+}
+
+// Slot of handle, nullptr if the handle is stale.
+Slot*
+_slot(Handle handle)
+{
+    auto&    table = _table();
+    uint32_t index = handle & index_mask;
+    if (index >= table.slots.size())
+    {
+        return nullptr;
+    }
+    Slot& slot = table.slots[index];
+    if ((slot.wrappers == 0 && slot.handles == 0)
+        || slot.generation != handle >> index_bits)
+    {
+        return nullptr;
+    }
+    return &slot;
+}
+
+Slot&
+_checked_slot(Handle handle)
+{
+    Slot* slot = _slot(handle);
+    if (!slot)
+    {
+        throw ValueError("Stale handle");
+    }
+    return *slot;
+}
+
+void
+_monitor(Handle handle)
+{
+    if (Slot* slot = _slot(handle))
+    {
+        slot->shared = slot->object.value->current_ref_count() > 1;
+    }
+}
+
+// Finds or creates the slot of object. A new slot has no owner yet.
+uint32_t
+_find_or_create(OTIO_NS::SerializableObject* object)
+{
+    auto& table = _table();
+    auto  found = table.indices.find(object);
+    if (found != table.indices.end())
+    {
+        return found->second;
+    }
+
+    uint32_t index;
+    if (!table.free.empty())
+    {
+        index = table.free.back();
+        table.free.pop_back();
+    }
+    else
+    {
+        if (table.slots.size() > index_mask)
+        {
+            throw ValueError("Too many objects are held by JS");
+        }
+        index = static_cast<uint32_t>(table.slots.size());
+        table.slots.emplace_back();
+    }
+    table.indices.emplace(object, index);
+
+    Slot& slot  = table.slots[index];
+    slot.object = OTIO_NS::SerializableObject::Retainer<>(object);
+    slot.shared = object->current_ref_count() > 1;
+
+    Handle handle = _handle(index, slot.generation);
+    object->install_external_keepalive_monitor(
+        [handle] { _monitor(handle); },
+        false);
+    return index;
+}
+
+using Objects = std::unordered_set<OTIO_NS::SerializableObject const*>;
+
+void
+_add_tree(OTIO_NS::SerializableObject const* object, Objects& objects)
+{
+    if (!object || !objects.insert(object).second)
+    {
+        return;
+    }
+    if (auto timeline = dynamic_cast<OTIO_NS::Timeline const*>(object))
+    {
+        _add_tree(timeline->tracks(), objects);
+    }
+    else if (
+        auto collection =
+            dynamic_cast<OTIO_NS::SerializableCollection const*>(object))
+    {
+        for (auto const& child: collection->children())
+        {
+            _add_tree(child.value, objects);
+        }
+    }
+    if (auto item = dynamic_cast<OTIO_NS::Item const*>(object))
+    {
+        for (auto const& effect: item->effects())
+        {
+            _add_tree(effect.value, objects);
+        }
+        for (auto const& marker: item->markers())
+        {
+            _add_tree(marker.value, objects);
+        }
+    }
+    if (auto composition = dynamic_cast<OTIO_NS::Composition const*>(object))
+    {
+        for (auto const& child: composition->children())
+        {
+            _add_tree(child.value, objects);
+        }
+    }
+    else if (auto clip = dynamic_cast<OTIO_NS::Clip const*>(object))
+    {
+        for (auto const& reference: clip->media_references())
+        {
+            _add_tree(reference.second, objects);
+        }
+    }
+}
+
+// Makes the caches forget the tree of object if JS held its last owner, so
+// that they don't keep a deleted timeline alive. Only roots (objects without
+// a parent) are considered: the tree of a child is still used by its parent.
+void
+_forget_if_released(OTIO_NS::SerializableObject const* object)
+{
+    auto composable = dynamic_cast<OTIO_NS::Composable const*>(object);
+    if (composable
+            ? composable->parent() != nullptr
+            : !dynamic_cast<OTIO_NS::Timeline const*>(object)
+                  && !dynamic_cast<OTIO_NS::SerializableCollection const*>(
+                      object))
+    {
+        return;
+    }
+
+    // The slot and the caches.
+    size_t owners = 1 + (content_hash::retains(object) ? 1 : 0)
+                    + transform_cache::retains(object);
+    if (static_cast<size_t>(object->current_ref_count()) > owners)
+    {
+        return;
+    }
+
+    Objects objects;
+    _add_tree(object, objects);
+    content_hash::forget(objects);
+    transform_cache::forget(objects);
+}
+
+// Frees the slot if nothing owns it anymore.
+void
+_free_if_unowned(uint32_t index)
+{
+    auto& table = _table();
+    Slot& slot  = table.slots[index];
+    if (slot.wrappers > 0 || slot.handles > 0)
+    {
+        return;
+    }
+    _forget_if_released(slot.object.value);
+
+    // The slot is freed before the object is released, so the monitor called
+    // by the release finds a stale handle.
+    table.indices.erase(slot.object.value);
+    table.free.push_back(index);
+    slot.shared = false;
+    if (++slot.generation == 0)
+    {
+        slot.generation = 1;
+    }
+    slot.object = OTIO_NS::SerializableObject::Retainer<>();
+}
+
+} // namespace
+
+Handle
+acquire(OTIO_NS::SerializableObject* object)
+{
+    uint32_t index = _find_or_create(object);
+    Slot&    slot  = _table().slots[index];
+    ++slot.handles;
+    return _handle(index, slot.generation);
+}
+
+void
+retain(Handle handle)
+{
+    ++_checked_slot(handle).handles;
+}
+
+void
+release(Handle handle)
+{
+    Slot& slot = _checked_slot(handle);
+    if (slot.handles == 0)
+    {
+        throw ValueError("All the handles to this object were released");
+    }
+    --slot.handles;
+    _free_if_unowned(handle & index_mask);
+}
+
+Handle
+acquire_wrapper(OTIO_NS::SerializableObject* object)
+{
+    uint32_t index = _find_or_create(object);
+    Slot&    slot  = _table().slots[index];
+    ++slot.wrappers;
+    return _handle(index, slot.generation);
+}
+
+void
+retain_wrapper(Handle handle) noexcept
+{
+    if (Slot* slot = _slot(handle))
+    {
+        ++slot->wrappers;
+    }
+}
+
+void
+release_wrapper(Handle handle) noexcept
+{
+    Slot* slot = _slot(handle);
+    if (!slot || slot->wrappers == 0)
+    {
+        return;
+    }
+    --slot->wrappers;
+    _free_if_unowned(handle & index_mask);
+}
+
+OTIO_NS::SerializableObject*
+get(Handle handle)
+{
+    Slot* slot = _slot(handle);
+    return slot ? slot->object.value : nullptr;
+}
+
+Handle
+find(OTIO_NS::SerializableObject const* object)
+{
+    auto& table = _table();
+    auto  found = table.indices.find(object);
+    if (found == table.indices.end())
+    {
+        return null;
+    }
+    return _handle(found->second, table.slots[found->second].generation);
+}
+
+size_t
+count(Handle handle)
+{
+    Slot* slot = _slot(handle);
+    return slot ? slot->wrappers + slot->handles : 0;
+}
+
+bool
+is_shared(Handle handle)
+{
+    Slot* slot = _slot(handle);
+    return slot && slot->shared;
+}
+
+size_t
+size()
+{
+    return _table().indices.size();
+}
+
+} // namespace handle_table
+
+EMSCRIPTEN_BINDINGS(opentimelineio_handleTable)
+{
+    ems::function("retain_handle", &handle_table::retain);
+    ems::function("release_handle", &handle_table::release);
+    ems::function("handle_count", &handle_table::count);
+    ems::function("is_handle_shared", &handle_table::is_shared);
+    ems::function("handle_table_size", &handle_table::size);
+}
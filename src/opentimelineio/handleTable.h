@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <opentimelineio/serializableObject.h>
+
+/**
+ * Ownership of the objects held by JS.
+ *
+ * Every object that JS holds has a slot in a single table. The slot retains
+ * the object once and counts its two kinds of JS owners separately: the
+ * wrappers (through managing_ptr) and the handles taken with acquire() or
+ * retain(). The object is released when both counts drop to 0. Releasing
+ * handles can't release the ownership of a wrapper.
+ *
+ * A handle is the index of the slot and its generation, so a handle to a
+ * released slot is invalid after the slot is reused. The generation only has
+ * 8 bits (0 is never used): a stale handle becomes valid again once its slot
+ * was reused 255 times. JS must not use a handle after releasing it.
+ *
+ * When the last JS owner of a root object (a timeline, a collection or a
+ * composable without a parent) goes away and only the caches retain it
+ * besides, the caches (see contentHash.h and transformCache.h) forget its
+ * tree so that it's deleted.
+ *
+ * The keepalive monitor that OTIO calls when the reference count of an object
+ * goes from 1 to 2 or from 2 to 1 only captures the handle. It records
+ * whether C++ also retains the object in the slot.
+ */
+namespace handle_table {
+
+// Index of the slot in the low 24 bits, generation in the high 8 bits.
+using Handle = uint32_t;
+
+// Never a valid handle.
+constexpr Handle null = 0;
+
+// Take a handle to object, creating its slot if needed.
+Handle acquire(OTIO_NS::SerializableObject* object);
+
+// Take another handle to the slot of handle. Throws ValueError if the handle
+// is stale.
+void retain(Handle handle);
+
+// Give back a handle. Releases the object and frees the slot when nothing
+// else owns it. Throws ValueError if the handle is stale or if all the
+// handles of the slot were already released.
+void release(Handle handle);
+
+// Used by managing_ptr. They don't throw: a wrapper always owns its slot.
+Handle acquire_wrapper(OTIO_NS::SerializableObject* object);
+void   retain_wrapper(Handle handle) noexcept;
+void   release_wrapper(Handle handle) noexcept;
+
+// Object of the slot of handle, nullptr if the handle is stale.
+OTIO_NS::SerializableObject* get(Handle handle);
+
+// Handle of the slot of object, null if JS doesn't hold it.
+Handle find(OTIO_NS::SerializableObject const* object);
+
+// Number of owners (wrappers and handles) of the slot of handle, 0 if the
+// handle is stale.
+size_t count(Handle handle);
+
+// Whether something else than the table retains the object of handle.
+bool is_shared(Handle handle);
+
+// Number of slots in use.
+size_t size();
+
+} // namespace handle_table
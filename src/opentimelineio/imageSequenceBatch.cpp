@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+#include <opentime/rationalTime.h>
+#include <opentimelineio/imageSequenceReference.h>
+
+#include "common_utils.h"
+#include "errorStatusHandler.h"
+#include "exceptions.h"
+#include "imageSequenceBatch.h"
+
+namespace ems = emscripten;
+
+using MissingFramePolicy = OTIO_NS::ImageSequenceReference::MissingFramePolicy;
+
+namespace image_sequence_batch {
+
+ems::val
+target_urls_for_range(
+    OTIO_NS::ImageSequenceReference const& ref,
+    int                                    first,
+    int                                    count)
+{
+    if (count < 0)
+    {
+        throw ValueError("count can't be negative");
+    }
+
+    // number_of_images_in_sequence divides by the rate.
+    MissingFramePolicy policy = ref.missing_frame_policy();
+    int  images = ref.rate() == 0 ? 0 : ref.number_of_images_in_sequence();
+    bool empty  = images <= 0;
+
+    std::vector<uint8_t>  data;
+    std::vector<uint32_t> offsets;
+    std::vector<int32_t>  missing;
+    offsets.reserve(size_t(count) + 1);
+    offsets.push_back(0);
+
+    for (int i = 0; i < count; ++i)
+    {
+        int  image_number = first + i;
+        bool is_missing   = empty || image_number < 0 || image_number >= images;
+        if (is_missing)
+        {
+            if (policy == MissingFramePolicy::error)
+            {
+                if (image_number < 0)
+                {
+                    throw IndexError("Out of bounds.");
+                }
+                // Let the core report why the frame doesn't exist.
+                ref.target_url_for_image_number(
+                    image_number,
+                    ErrorStatusHandler());
+            }
+            missing.push_back(image_number);
+            if (policy == MissingFramePolicy::black || empty)
+            {
+                offsets.push_back(uint32_t(data.size()));
+                continue;
+            }
+            image_number = std::clamp(image_number, 0, images - 1);
+        }
+
+        std::string url =
+            ref.target_url_for_image_number(image_number, ErrorStatusHandler());
+        data.insert(data.end(), url.begin(), url.end());
+        offsets.push_back(uint32_t(data.size()));
+    }
+
+    ems::val result = ems::val::object();
+    result.set("data", to_js_typed_array(data));
+    result.set("offsets", to_js_typed_array(offsets));
+    result.set("missing", to_js_typed_array(missing));
+    return result;
+}
+
+ems::val
+frames_for_times(
+    OTIO_NS::ImageSequenceReference const& ref,
+    ems::val const&                        times,
+    double                                 rate)
+{
+    std::vector<double> values = ems::convertJSArrayToNumberVector<double>(times);
+    MissingFramePolicy  policy = ref.missing_frame_policy();
+    auto                range  = ref.available_range();
+
+    std::vector<int32_t> frames(values.size());
+    std::vector<int32_t> missing;
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        OTIO_NS::RationalTime time(values[i], rate);
+        OTIO_NS::ErrorStatus  error_status;
+        frames[i] = ref.frame_for_time(time, &error_status);
+        if (!OTIO_NS::is_error(error_status))
+        {
+            continue;
+        }
+
+        if (policy == MissingFramePolicy::error)
+        {
+            ref.frame_for_time(time, ErrorStatusHandler());
+        }
+        missing.push_back(int32_t(i));
+        frames[i] = 0;
+        if (policy == MissingFramePolicy::hold && range
+            && range->duration().value() > 0)
+        {
+            OTIO_NS::RationalTime closest = time < range->start_time()
+                                                ? range->start_time()
+                                                : range->end_time_inclusive();
+            frames[i] = ref.frame_for_time(closest, ErrorStatusHandler());
+        }
+    }
+
+    ems::val result = ems::val::object();
+    result.set("frames", to_js_typed_array(frames));
+    result.set("missing", to_js_typed_array(missing));
+    return result;
+}
+
+} // namespace image_sequence_batch
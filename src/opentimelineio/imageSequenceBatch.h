@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include <emscripten/val.h>
+#include <opentimelineio/imageSequenceReference.h>
+
+/**
+ * Batch versions of the ImageSequenceReference frame and URL lookups. Frames
+ * that are not part of the sequence are handled according to the missing
+ * frame policy of the reference:
+ *
+ *  - error: an exception is thrown for the first missing frame.
+ *  - hold: the closest frame of the sequence is used instead.
+ *  - black: no frame is produced (empty URL, frame 0).
+ *
+ * With hold and black, the positions of the missing frames are returned in
+ * the "missing" Int32Array of the result, so callers can tell them apart.
+ */
+namespace image_sequence_batch {
+
+/**
+ * URLs of the images first to first + count - 1, as
+ * {data: Uint8Array, offsets: Uint32Array, missing: Int32Array}. data contains
+ * the UTF-8 encoded URLs one after the other, and URL i spans
+ * data[offsets[i]] to data[offsets[i + 1]]. missing contains image numbers.
+ */
+emscripten::val target_urls_for_range(
+    OTIO_NS::ImageSequenceReference const& ref,
+    int                                    first,
+    int                                    count);
+
+/**
+ * Frame numbers for times (values at rate), as
+ * {frames: Int32Array, missing: Int32Array}. missing contains indices into
+ * times.
+ */
+emscripten::val frames_for_times(
+    OTIO_NS::ImageSequenceReference const& ref,
+    emscripten::val const&                 times,
+    double                                 rate);
+
+} // namespace image_sequence_batch
@@ -0,0 +1,1220 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <map>
+
+#include <emscripten/bind.h>
+#include <opentimelineio/mediaReference.h>
+
+#include "binarySerialization.h"
+#include "common_utils.h"
+#include "errorStatusHandler.h"
+#include "exceptions.h"
+#include "journal.h"
+#include "transaction.h"
+
+namespace ems = emscripten;
+
+namespace journal {
+
+namespace {
+
+Journal* _active = nullptr;
+
+using Retainer = OTIO_NS::SerializableObject::Retainer<>;
+
+// Index at which OTIO inserts a child, given the index passed to
+// insert_child().
+int
+_insert_index(int index, size_t size)
+{
+    int count = static_cast<int>(size);
+    index     = index < 0 ? index + count : index;
+    return std::clamp(index, 0, count);
+}
+
+// Index of the child that OTIO removes, given the index passed to
+// remove_child(). size must not be 0.
+int
+_remove_index(int index, size_t size)
+{
+    int count = static_cast<int>(size);
+    index     = index < 0 ? index + count : index;
+    return std::clamp(index, 0, count - 1);
+}
+
+void
+_encode_objects(
+    Writer&                                          writer,
+    std::vector<OTIO_NS::SerializableObject*> const& objects,
+    Journal&                                         journal)
+{
+    writer.varuint(objects.size());
+    for (auto object: objects)
+    {
+        writer.object(object);
+        journal.retain(object);
+    }
+}
+
+template <typename T>
+std::vector<T*>
+_decode_objects(Reader& reader)
+{
+    std::vector<T*> objects(reader.varuint());
+    for (auto& object: objects)
+    {
+        object = reader.object<T>();
+    }
+    return objects;
+}
+
+template <typename T>
+std::vector<OTIO_NS::SerializableObject*>
+_objects(std::vector<OTIO_NS::SerializableObject::Retainer<T>> const& children)
+{
+    std::vector<OTIO_NS::SerializableObject*> objects;
+    objects.reserve(children.size());
+    for (auto const& child: children)
+    {
+        objects.push_back(child.value);
+    }
+    return objects;
+}
+
+void
+_apply_metadata(Reader& reader, bool undo)
+{
+    auto object = reader.object<OTIO_NS::SerializableObjectWithMetadata>();
+    OTIO_NS::AnyDictionary old_metadata;
+    OTIO_NS::AnyDictionary new_metadata;
+    decode(reader, old_metadata);
+    decode(reader, new_metadata);
+    object->metadata() = undo ? old_metadata : new_metadata;
+    mutation::touch(object);
+}
+
+void
+_apply_dynamic_fields(Reader& reader, bool undo)
+{
+    auto                   object = reader.object();
+    OTIO_NS::AnyDictionary old_fields;
+    OTIO_NS::AnyDictionary new_fields;
+    decode(reader, old_fields);
+    decode(reader, new_fields);
+    object->dynamic_fields() = undo ? old_fields : new_fields;
+    mutation::touch(object);
+}
+
+// The old value is an empty dictionary if the field didn't exist.
+void
+_apply_dynamic_field(Reader& reader, bool undo)
+{
+    auto                   object = reader.object();
+    std::string            name   = reader.string();
+    OTIO_NS::AnyDictionary old_field;
+    OTIO_NS::AnyDictionary new_field;
+    decode(reader, old_field);
+    decode(reader, new_field);
+    OTIO_NS::AnyDictionary& fields = object->dynamic_fields();
+    fields.erase(name);
+    for (auto& field: undo ? old_field : new_field)
+    {
+        fields[field.first] = std::move(field.second);
+    }
+    mutation::touch(object);
+}
+
+void
+_apply_composition_insert(Reader& reader, bool undo)
+{
+    auto composition = reader.object<OTIO_NS::Composition>();
+    int  index       = static_cast<int>(reader.varint());
+    auto child       = reader.object<OTIO_NS::Composable>();
+    if (undo)
+    {
+        composition->remove_child(index, ErrorStatusHandler());
+    }
+    else
+    {
+        composition->insert_child(index, child, ErrorStatusHandler());
+    }
+    mutation::touch(composition);
+}
+
+void
+_apply_composition_remove(Reader& reader, bool undo)
+{
+    auto composition = reader.object<OTIO_NS::Composition>();
+    int  index       = static_cast<int>(reader.varint());
+    auto child       = reader.object<OTIO_NS::Composable>();
+    if (undo)
+    {
+        composition->insert_child(index, child, ErrorStatusHandler());
+    }
+    else
+    {
+        composition->remove_child(index, ErrorStatusHandler());
+    }
+    mutation::touch(composition);
+}
+
+// Composition::set_children() fails if one of the children already has a
+// parent, so the current children are removed first.
+void
+_apply_composition_children(Reader& reader, bool undo)
+{
+    auto composition  = reader.object<OTIO_NS::Composition>();
+    auto old_children = _decode_objects<OTIO_NS::Composable>(reader);
+    auto new_children = _decode_objects<OTIO_NS::Composable>(reader);
+    composition->clear_children();
+    composition->set_children(
+        undo ? old_children : new_children,
+        ErrorStatusHandler());
+    mutation::touch(composition);
+}
+
+void
+_apply_collection_insert(Reader& reader, bool undo)
+{
+    auto collection = reader.object<OTIO_NS::SerializableCollection>();
+    int  index      = static_cast<int>(reader.varint());
+    auto child      = reader.object();
+    if (undo)
+    {
+        collection->remove_child(index, ErrorStatusHandler());
+    }
+    else
+    {
+        collection->insert_child(index, child);
+    }
+    mutation::touch(collection);
+}
+
+void
+_apply_collection_remove(Reader& reader, bool undo)
+{
+    auto collection = reader.object<OTIO_NS::SerializableCollection>();
+    int  index      = static_cast<int>(reader.varint());
+    auto child      = reader.object();
+    if (undo)
+    {
+        collection->insert_child(index, child);
+    }
+    else
+    {
+        collection->remove_child(index, ErrorStatusHandler());
+    }
+    mutation::touch(collection);
+}
+
+void
+_apply_collection_child(Reader& reader, bool undo)
+{
+    auto collection = reader.object<OTIO_NS::SerializableCollection>();
+    int  index      = static_cast<int>(reader.varint());
+    auto old_child  = reader.object();
+    auto new_child  = reader.object();
+    collection->set_child(
+        index,
+        undo ? old_child : new_child,
+        ErrorStatusHandler());
+    mutation::touch(collection);
+}
+
+void
+_apply_collection_children(Reader& reader, bool undo)
+{
+    auto collection   = reader.object<OTIO_NS::SerializableCollection>();
+    auto old_children = _decode_objects<OTIO_NS::SerializableObject>(reader);
+    auto new_children = _decode_objects<OTIO_NS::SerializableObject>(reader);
+    collection->set_children(undo ? old_children : new_children);
+    mutation::touch(collection);
+}
+
+void
+_apply_media_reference(Reader& reader, bool undo)
+{
+    auto clip          = reader.object<OTIO_NS::Clip>();
+    auto old_reference = reader.object<OTIO_NS::MediaReference>();
+    auto new_reference = reader.object<OTIO_NS::MediaReference>();
+    clip->set_media_reference(undo ? old_reference : new_reference);
+    mutation::touch(clip);
+}
+
+void
+_encode_media_references(
+    Writer&                               writer,
+    OTIO_NS::Clip::MediaReferences const& references,
+    std::string const&                    active_key,
+    Journal&                              journal)
+{
+    writer.varuint(references.size());
+    for (auto const& reference: references)
+    {
+        writer.string(reference.first);
+        writer.object(reference.second);
+        journal.retain(reference.second);
+    }
+    writer.string(active_key);
+}
+
+std::pair<OTIO_NS::Clip::MediaReferences, std::string>
+_decode_media_references(Reader& reader)
+{
+    OTIO_NS::Clip::MediaReferences references;
+    for (uint64_t count = reader.varuint(); count > 0; --count)
+    {
+        std::string key = reader.string();
+        references[key] = reader.object<OTIO_NS::MediaReference>();
+    }
+    return { references, reader.string() };
+}
+
+void
+_apply_media_references(Reader& reader, bool undo)
+{
+    auto clip           = reader.object<OTIO_NS::Clip>();
+    auto old_references = _decode_media_references(reader);
+    auto new_references = _decode_media_references(reader);
+    auto const& state   = undo ? old_references : new_references;
+    clip->set_media_references(
+        state.first,
+        state.second,
+        ErrorStatusHandler());
+    mutation::touch(clip);
+}
+
+void
+_apply_active_media_reference_key(Reader& reader, bool undo)
+{
+    auto        clip    = reader.object<OTIO_NS::Clip>();
+    std::string old_key = reader.string();
+    std::string new_key = reader.string();
+    clip->set_active_media_reference_key(
+        undo ? old_key : new_key,
+        ErrorStatusHandler());
+    mutation::touch(clip);
+}
+
+template <typename T>
+void
+_apply_element_insert(Reader& reader, bool undo)
+{
+    auto  item     = reader.object<OTIO_NS::Item>();
+    auto  index    = static_cast<ptrdiff_t>(reader.varuint());
+    auto  element  = reader.object<T>();
+    auto& elements = elements_of<T>(*item);
+    if (undo)
+    {
+        elements.erase(elements.begin() + index);
+    }
+    else
+    {
+        elements.emplace(elements.begin() + index, element);
+    }
+    mutation::touch(item);
+}
+
+template <typename T>
+void
+_apply_element_remove(Reader& reader, bool undo)
+{
+    auto  item     = reader.object<OTIO_NS::Item>();
+    auto  index    = static_cast<ptrdiff_t>(reader.varuint());
+    auto  element  = reader.object<T>();
+    auto& elements = elements_of<T>(*item);
+    if (undo)
+    {
+        elements.emplace(elements.begin() + index, element);
+    }
+    else
+    {
+        elements.erase(elements.begin() + index);
+    }
+    mutation::touch(item);
+}
+
+template <typename T>
+void
+_apply_element(Reader& reader, bool undo)
+{
+    auto item        = reader.object<OTIO_NS::Item>();
+    auto index       = reader.varuint();
+    auto old_element = reader.object<T>();
+    auto new_element = reader.object<T>();
+    elements_of<T>(*item)[index] = undo ? old_element : new_element;
+    mutation::touch(item);
+}
+
+} // namespace
+
+void
+Writer::varuint(uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        _bytes.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    _bytes.push_back(static_cast<char>(value));
+}
+
+void
+Writer::varint(int64_t value)
+{
+    varuint(
+        (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+void
+Writer::number(double value)
+{
+    char bytes[sizeof(double)];
+    std::memcpy(bytes, &value, sizeof(double));
+    _bytes.append(bytes, sizeof(double));
+}
+
+void
+Writer::string(std::string const& value)
+{
+    varuint(value.size());
+    _bytes.append(value);
+}
+
+void
+Writer::object(OTIO_NS::SerializableObject const* object)
+{
+    varuint(reinterpret_cast<uintptr_t>(object));
+}
+
+uint64_t
+Reader::varuint()
+{
+    uint64_t value = 0;
+    for (int shift = 0; _data < _end; shift += 7)
+    {
+        uint8_t byte = static_cast<uint8_t>(*_data++);
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+        {
+            return value;
+        }
+    }
+    throw ValueError("Malformed journal record");
+}
+
+int64_t
+Reader::varint()
+{
+    uint64_t value = varuint();
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+double
+Reader::number()
+{
+    if (_end - _data < static_cast<ptrdiff_t>(sizeof(double)))
+    {
+        throw ValueError("Malformed journal record");
+    }
+    double value;
+    std::memcpy(&value, _data, sizeof(double));
+    _data += sizeof(double);
+    return value;
+}
+
+std::string
+Reader::string()
+{
+    uint64_t size = varuint();
+    if (static_cast<uint64_t>(_end - _data) < size)
+    {
+        throw ValueError("Malformed journal record");
+    }
+    std::string value(_data, size);
+    _data += size;
+    return value;
+}
+
+void
+encode(Writer& writer, bool value)
+{
+    writer.varuint(value ? 1 : 0);
+}
+
+void
+encode(Writer& writer, int value)
+{
+    writer.varint(value);
+}
+
+void
+encode(Writer& writer, double value)
+{
+    writer.number(value);
+}
+
+void
+encode(Writer& writer, std::string const& value)
+{
+    writer.string(value);
+}
+
+void
+encode(Writer& writer, OTIO_NS::RationalTime const& value)
+{
+    writer.number(value.value());
+    writer.number(value.rate());
+}
+
+void
+encode(Writer& writer, OTIO_NS::TimeRange const& value)
+{
+    encode(writer, value.start_time());
+    encode(writer, value.duration());
+}
+
+void
+encode(Writer& writer, Imath::Box2d const& value)
+{
+    writer.number(value.min.x);
+    writer.number(value.min.y);
+    writer.number(value.max.x);
+    writer.number(value.max.y);
+}
+
+// Dictionaries use the binary encoding of documents (see
+// binarySerialization.h).
+void
+encode(Writer& writer, OTIO_NS::AnyDictionary const& value)
+{
+    writer.string(any_to_binary(linb::any(value)));
+}
+
+void
+decode(Reader& reader, bool& value)
+{
+    value = reader.varuint() != 0;
+}
+
+void
+decode(Reader& reader, int& value)
+{
+    value = static_cast<int>(reader.varint());
+}
+
+void
+decode(Reader& reader, double& value)
+{
+    value = reader.number();
+}
+
+void
+decode(Reader& reader, std::string& value)
+{
+    value = reader.string();
+}
+
+void
+decode(Reader& reader, OTIO_NS::RationalTime& value)
+{
+    double time = reader.number();
+    value       = OTIO_NS::RationalTime(time, reader.number());
+}
+
+void
+decode(Reader& reader, OTIO_NS::TimeRange& value)
+{
+    OTIO_NS::RationalTime start_time;
+    OTIO_NS::RationalTime duration;
+    decode(reader, start_time);
+    decode(reader, duration);
+    value = OTIO_NS::TimeRange(start_time, duration);
+}
+
+void
+decode(Reader& reader, Imath::Box2d& value)
+{
+    value.min.x = reader.number();
+    value.min.y = reader.number();
+    value.max.x = reader.number();
+    value.max.y = reader.number();
+}
+
+void
+decode(Reader& reader, OTIO_NS::AnyDictionary& value)
+{
+    std::string bytes = reader.string();
+    value             = linb::any_cast<OTIO_NS::AnyDictionary>(binary_to_any(
+        reinterpret_cast<uint8_t const*>(bytes.data()),
+        bytes.size()));
+}
+
+Journal*
+active()
+{
+    return _active;
+}
+
+void
+set_metadata(
+    OTIO_NS::SerializableObjectWithMetadata& object,
+    OTIO_NS::AnyDictionary const&            metadata)
+{
+    Journal* journal = active();
+    if (journal)
+    {
+        journal->record(
+            &_apply_metadata,
+            &object,
+            [&](Writer& writer, Journal&) {
+                encode(writer, object.metadata());
+                encode(writer, metadata);
+            });
+    }
+    object.metadata() = metadata;
+    mutation::touch(&object);
+}
+
+void
+set_dynamic_fields(
+    OTIO_NS::SerializableObject&  object,
+    OTIO_NS::AnyDictionary const& dynamic_fields)
+{
+    Journal* journal = active();
+    if (journal)
+    {
+        journal->record(
+            &_apply_dynamic_fields,
+            &object,
+            [&](Writer& writer, Journal&) {
+                encode(writer, object.dynamic_fields());
+                encode(writer, dynamic_fields);
+            });
+    }
+    object.dynamic_fields() = dynamic_fields;
+    mutation::touch(&object);
+}
+
+void
+set_dynamic_field(
+    OTIO_NS::SerializableObject& object,
+    std::string const&           name,
+    linb::any const&             value)
+{
+    Journal* journal = active();
+    if (journal)
+    {
+        journal->record(
+            &_apply_dynamic_field,
+            &object,
+            [&](Writer& writer, Journal&) {
+                OTIO_NS::AnyDictionary old_field;
+                OTIO_NS::AnyDictionary new_field;
+                auto const&            fields = object.dynamic_fields();
+                auto                   it     = fields.find(name);
+                if (it != fields.end())
+                {
+                    old_field[name] = it->second;
+                }
+                new_field[name] = value;
+                writer.string(name);
+                encode(writer, old_field);
+                encode(writer, new_field);
+            });
+    }
+    object.dynamic_fields()[name] = value;
+    mutation::touch(&object);
+}
+
+bool
+insert_child(
+    OTIO_NS::Composition& composition,
+    int                   index,
+    OTIO_NS::Composable*  child)
+{
+    int  position = _insert_index(index, composition.children().size());
+    bool result   = composition.insert_child(index, child, ErrorStatusHandler());
+    mutation::touch(&composition);
+    if (Journal* journal = active())
+    {
+        journal->record(
+            &_apply_composition_insert,
+            &composition,
+            [&](Writer& writer, Journal& journal) {
+                writer.varint(position);
+                writer.object(child);
+                journal.retain(child);
+            });
+    }
+    return result;
+}
+
+bool
+append_child(OTIO_NS::Composition& composition, OTIO_NS::Composable* child)
+{
+    return insert_child(
+        composition,
+        static_cast<int>(composition.children().size()),
+        child);
+}
+
+bool
+remove_child(OTIO_NS::Composition& composition, int index)
+{
+    auto const& children = composition.children();
+    if (children.empty())
+    {
+        return composition.remove_child(index, ErrorStatusHandler());
+    }
+
+    int      position = _remove_index(index, children.size());
+    Retainer child(children[position].value);
+    bool     result = composition.remove_child(index, ErrorStatusHandler());
+    mutation::touch(&composition);
+    if (Journal* journal = active())
+    {
+        journal->record(
+            &_apply_composition_remove,
+            &composition,
+            [&](Writer& writer, Journal& journal) {
+                writer.varint(position);
+                writer.object(child.value);
+                journal.retain(child.value);
+            });
+    }
+    return result;
+}
+
+void
+set_children(
+    OTIO_NS::Composition&                    composition,
+    std::vector<OTIO_NS::Composable*> const& children)
+{
+    auto                  old_children = _objects(composition.children());
+    std::vector<Retainer> keep(old_children.begin(), old_children.end());
+    composition.set_children(children, ErrorStatusHandler());
+    mutation::touch(&composition);
+    if (Journal* journal = active())
+    {
+        journal->record(
+            &_apply_composition_children,
+            &composition,
+            [&](Writer& writer, Journal& journal) {
+                _encode_objects(writer, old_children, journal);
+                _encode_objects(
+                    writer,
+                    _objects(composition.children()),
+                    journal);
+            });
+    }
+}
+
+void
+set_children(
+    OTIO_NS::SerializableCollection&                 collection,
+    std::vector<OTIO_NS::SerializableObject*> const& children)
+{
+    auto                  old_children = _objects(collection.children());
+    std::vector<Retainer> keep(old_children.begin(), old_children.end());
+    collection.set_children(children);
+    mutation::touch(&collection);
+    if (Journal* journal = active())
+    {
+        journal->record(
+            &_apply_collection_children,
+            &collection,
+            [&](Writer& writer, Journal& journal) {
+                _encode_objects(writer, old_children, journal);
+                _encode_objects(writer, children, journal);
+            });
+    }
+}
+
+void
+insert_child(
+    OTIO_NS::SerializableCollection& collection,
+    int                              index,
+    OTIO_NS::SerializableObject*     child)
+{
+    int position = _insert_index(index, collection.children().size());
+    collection.insert_child(index, child);
+    mutation::touch(&collection);
+    if (Journal* journal = active())
+    {
+        journal->record(
+            &_apply_collection_insert,
+            &collection,
+            [&](Writer& writer, Journal& journal) {
+                writer.varint(position);
+                writer.object(child);
+                journal.retain(child);
+            });
+    }
+}
+
+bool
+set_child(
+    OTIO_NS::SerializableCollection& collection,
+    int                              index,
+    OTIO_NS::SerializableObject*     child)
+{
+    auto const& children = collection.children();
+    int         count    = static_cast<int>(children.size());
+    int         position = index < 0 ? index + count : index;
+    if (position < 0 || position >= count)
+    {
+        return collection.set_child(index, child, ErrorStatusHandler());
+    }
+
+    Retainer old_child(children[position].value);
+    bool     result = collection.set_child(index, child, ErrorStatusHandler());
+    mutation::touch(&collection);
+    if (Journal* journal = active())
+    {
+        journal->record(
+            &_apply_collection_child,
+            &collection,
+            [&](Writer& writer, Journal& journal) {
+                writer.varint(position);
+                writer.object(old_child.value);
+                writer.object(child);
+                journal.retain(old_child.value);
+                journal.retain(child);
+            });
+    }
+    return result;
+}
+
+bool
+remove_child(OTIO_NS::SerializableCollection& collection, int index)
+{
+    auto const& children = collection.children();
+    if (children.empty())
+    {
+        return collection.remove_child(index, ErrorStatusHandler());
+    }
+
+    int      position = _remove_index(index, children.size());
+    Retainer child(children[position].value);
+    bool     result = collection.remove_child(index, ErrorStatusHandler());
+    mutation::touch(&collection);
+    if (Journal* journal = active())
+    {
+        journal->record(
+            &_apply_collection_remove,
+            &collection,
+            [&](Writer& writer, Journal& journal) {
+                writer.varint(position);
+                writer.object(child.value);
+                journal.retain(child.value);
+            });
+    }
+    return result;
+}
+
+void
+set_media_reference(
+    OTIO_NS::Clip&           clip,
+    OTIO_NS::MediaReference* media_reference)
+{
+    Retainer old_reference(clip.media_reference());
+    clip.set_media_reference(media_reference);
+    mutation::touch(&clip);
+    if (Journal* journal = active())
+    {
+        journal->record(
+            &_apply_media_reference,
+            &clip,
+            [&](Writer& writer, Journal& journal) {
+                writer.object(old_reference.value);
+                writer.object(clip.media_reference());
+                journal.retain(old_reference.value);
+                journal.retain(clip.media_reference());
+            });
+    }
+}
+
+void
+set_media_references(
+    OTIO_NS::Clip&                        clip,
+    OTIO_NS::Clip::MediaReferences const& media_references,
+    std::string const&                    new_active_key)
+{
+    OTIO_NS::Clip::MediaReferences old_references = clip.media_references();
+    std::string           old_key = clip.active_media_reference_key();
+    std::vector<Retainer> keep;
+    for (auto const& reference: old_references)
+    {
+        keep.emplace_back(reference.second);
+    }
+    clip.set_media_references(
+        media_references,
+        new_active_key,
+        ErrorStatusHandler());
+    mutation::touch(&clip);
+    if (Journal* journal = active())
+    {
+        journal->record(
+            &_apply_media_references,
+            &clip,
+            [&](Writer& writer, Journal& journal) {
+                _encode_media_references(
+                    writer,
+                    old_references,
+                    old_key,
+                    journal);
+                _encode_media_references(
+                    writer,
+                    clip.media_references(),
+                    clip.active_media_reference_key(),
+                    journal);
+            });
+    }
+}
+
+void
+set_active_media_reference_key(
+    OTIO_NS::Clip&     clip,
+    std::string const& new_active_key)
+{
+    std::string old_key = clip.active_media_reference_key();
+    clip.set_active_media_reference_key(new_active_key, ErrorStatusHandler());
+    mutation::touch(&clip);
+    if (Journal* journal = active())
+    {
+        journal->record(
+            &_apply_active_media_reference_key,
+            &clip,
+            [&](Writer& writer, Journal&) {
+                writer.string(old_key);
+                writer.string(new_active_key);
+            });
+    }
+}
+
+template <typename T>
+void
+insert_element(OTIO_NS::Item& item, size_t index, T* element)
+{
+    auto& elements = elements_of<T>(item);
+    elements.emplace(elements.begin() + index, element);
+    mutation::touch(&item);
+    if (Journal* journal = active())
+    {
+        journal->record(
+            &_apply_element_insert<T>,
+            &item,
+            [&](Writer& writer, Journal& journal) {
+                writer.varuint(index);
+                writer.object(element);
+                journal.retain(element);
+            });
+    }
+}
+
+template <typename T>
+void
+set_element(OTIO_NS::Item& item, size_t index, T* element)
+{
+    auto&    elements = elements_of<T>(item);
+    Retainer old_element(elements[index].value);
+    elements[index] = element;
+    mutation::touch(&item);
+    if (Journal* journal = active())
+    {
+        journal->record(
+            &_apply_element<T>,
+            &item,
+            [&](Writer& writer, Journal& journal) {
+                writer.varuint(index);
+                writer.object(old_element.value);
+                writer.object(element);
+                journal.retain(old_element.value);
+                journal.retain(element);
+            });
+    }
+}
+
+template <typename T>
+void
+remove_element(OTIO_NS::Item& item, size_t index)
+{
+    auto&    elements = elements_of<T>(item);
+    Retainer element(elements[index].value);
+    elements.erase(elements.begin() + index);
+    mutation::touch(&item);
+    if (Journal* journal = active())
+    {
+        journal->record(
+            &_apply_element_remove<T>,
+            &item,
+            [&](Writer& writer, Journal& journal) {
+                writer.varuint(index);
+                writer.object(element.value);
+                journal.retain(element.value);
+            });
+    }
+}
+
+template void insert_element(OTIO_NS::Item&, size_t, OTIO_NS::Effect*);
+template void insert_element(OTIO_NS::Item&, size_t, OTIO_NS::Marker*);
+template void set_element(OTIO_NS::Item&, size_t, OTIO_NS::Effect*);
+template void set_element(OTIO_NS::Item&, size_t, OTIO_NS::Marker*);
+template void remove_element<OTIO_NS::Effect>(OTIO_NS::Item&, size_t);
+template void remove_element<OTIO_NS::Marker>(OTIO_NS::Item&, size_t);
+
+} // namespace journal
+
+Journal::Journal(size_t capacity)
+    : _capacity(capacity)
+{}
+
+Journal::~Journal()
+{
+    stop();
+    transaction::forget_journal(this);
+}
+
+void
+Journal::start()
+{
+    Journal* recording = transaction::recording_journal();
+    if (recording && recording != this)
+    {
+        throw ValueError("Can't start a journal during a transaction");
+    }
+    journal::_active = this;
+}
+
+void
+Journal::stop()
+{
+    if (journal::_active == this)
+    {
+        journal::_active = nullptr;
+    }
+}
+
+bool
+Journal::is_recording() const
+{
+    return journal::_active == this;
+}
+
+bool
+Journal::is_used_by_transaction() const
+{
+    return transaction::uses_journal(this);
+}
+
+void
+Journal::begin_group()
+{
+    ++_group_depth;
+}
+
+void
+Journal::end_group()
+{
+    if (_group_depth == 0)
+    {
+        throw ValueError("end_group() without begin_group()");
+    }
+    if (--_group_depth == 0)
+    {
+        _appending = false;
+    }
+}
+
+bool
+Journal::undo()
+{
+    if (_group_depth > 0)
+    {
+        throw ValueError("Can't undo while a group is open");
+    }
+    if (!can_undo())
+    {
+        return false;
+    }
+
+    Step const& step = _steps[--_position];
+    for (auto it = step.offsets.rbegin(); it != step.offsets.rend(); ++it)
+    {
+        journal::Reader reader(
+            step.bytes.data() + *it,
+            step.bytes.size() - *it);
+        auto apply = reinterpret_cast<journal::Apply>(
+            static_cast<uintptr_t>(reader.varuint()));
+        apply(reader, true);
+    }
+    return true;
+}
+
+bool
+Journal::redo()
+{
+    if (_group_depth > 0)
+    {
+        throw ValueError("Can't redo while a group is open");
+    }
+    if (!can_redo())
+    {
+        return false;
+    }
+
+    Step const& step = _steps[_position++];
+    for (uint32_t offset: step.offsets)
+    {
+        journal::Reader reader(
+            step.bytes.data() + offset,
+            step.bytes.size() - offset);
+        auto apply = reinterpret_cast<journal::Apply>(
+            static_cast<uintptr_t>(reader.varuint()));
+        apply(reader, false);
+    }
+    return true;
+}
+
+void
+Journal::set_capacity(size_t capacity)
+{
+    _capacity = capacity;
+    _trim();
+}
+
+void
+Journal::clear()
+{
+    _steps.clear();
+    _position     = 0;
+    _appending    = false;
+    _memory_usage = 0;
+}
+
+void
+Journal::absorb(Journal& other)
+{
+    if (other._position == 0)
+    {
+        other.clear();
+        return;
+    }
+
+    Step&  step = _step_for_record();
+    size_t size = _step_size(step);
+    for (size_t i = 0; i < other._position; ++i)
+    {
+        Step& from = other._steps[i];
+        for (uint32_t offset: from.offsets)
+        {
+            step.offsets.push_back(
+                static_cast<uint32_t>(step.bytes.size() + offset));
+        }
+        step.bytes.append(from.bytes);
+        std::move(
+            from.retained.begin(),
+            from.retained.end(),
+            std::back_inserter(step.retained));
+    }
+    _memory_usage += _step_size(step) - size;
+    other.clear();
+    _trim();
+}
+
+// Retaining an object that nothing retains would delete it when the step is
+// dropped, under the feet of its JS owner.
+void
+Journal::retain(OTIO_NS::SerializableObject const* object)
+{
+    if (!object || object->current_ref_count() <= 0)
+    {
+        return;
+    }
+    auto& retained = _steps.back().retained;
+    if (!retained.empty() && retained.back().value == object)
+    {
+        return;
+    }
+    retained.emplace_back(const_cast<OTIO_NS::SerializableObject*>(object));
+    _memory_usage += sizeof(OTIO_NS::SerializableObject::Retainer<>);
+}
+
+Journal::Step&
+Journal::_step_for_record()
+{
+    if (_appending)
+    {
+        return _steps.back();
+    }
+
+    // A new step can't be followed by the steps that were undone.
+    while (_steps.size() > _position)
+    {
+        _memory_usage -= _step_size(_steps.back());
+        _steps.pop_back();
+    }
+    _steps.emplace_back();
+    _position      = _steps.size();
+    _appending     = _group_depth > 0;
+    _memory_usage += sizeof(Step);
+    return _steps.back();
+}
+
+size_t
+Journal::_step_size(Step const& step) const
+{
+    return sizeof(Step) + step.bytes.size()
+           + step.offsets.size() * sizeof(uint32_t)
+           + step.retained.size()
+                 * sizeof(OTIO_NS::SerializableObject::Retainer<>);
+}
+
+// Drops the oldest steps that can be undone first, then the steps that can
+// be redone, starting from the last one.
+void
+Journal::_trim()
+{
+    while (_memory_usage > _capacity && _steps.size() > 1)
+    {
+        if (_position > 0)
+        {
+            _memory_usage -= _step_size(_steps.front());
+            _steps.pop_front();
+            --_position;
+        }
+        else
+        {
+            _memory_usage -= _step_size(_steps.back());
+            _steps.pop_back();
+        }
+    }
+}
+
+EMSCRIPTEN_BINDINGS(opentimelineio_journal)
+{
+    ems::class_<Journal>("Journal")
+        .constructor<>()
+        .constructor<size_t>()
+        .function("start", &Journal::start)
+        .function("stop", &Journal::stop)
+        .function("is_recording", &Journal::is_recording)
+        .function("is_used_by_transaction", &Journal::is_used_by_transaction)
+        .function("begin_group", &Journal::begin_group)
+        .function("end_group", &Journal::end_group)
+        .function("undo", &Journal::undo)
+        .function("redo", &Journal::redo)
+        .function("can_undo", &Journal::can_undo)
+        .function("can_redo", &Journal::can_redo)
+        .function("undo_count", &Journal::undo_count)
+        .function("redo_count", &Journal::redo_count)
+        .function("memory_usage", &Journal::memory_usage)
+        .property("capacity", &Journal::capacity, &Journal::set_capacity)
+        .function("clear", &Journal::clear);
+
+    ADD_TO_STRING_TAG_PROPERTY(Journal);
+}
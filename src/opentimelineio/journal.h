@@ -0,0 +1,435 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <ImathBox.h>
+#include <opentime/rationalTime.h>
+#include <opentime/timeRange.h>
+#include <opentimelineio/anyDictionary.h>
+#include <opentimelineio/clip.h>
+#include <opentimelineio/composition.h>
+#include <opentimelineio/effect.h>
+#include <opentimelineio/item.h>
+#include <opentimelineio/marker.h>
+#include <opentimelineio/serializableCollection.h>
+#include <opentimelineio/serializableObject.h>
+#include <opentimelineio/serializableObjectWithMetadata.h>
+
+#include "mutation.h"
+
+/**
+ * Undo/redo journal of the modifications made through the bindings.
+ *
+ * While a journal is recording, every binding that modifies an object
+ * (properties, metadata, children, media references, ...) appends a binary
+ * record to it: the function that replays the record, the modified object
+ * and the old and new values. Records are grouped in steps, one per binding
+ * call or one per begin_group()/end_group() pair. undo() replays the records
+ * of the last step backward with their old values, redo() forward with their
+ * new values. Recording a new step drops the steps that could be redone.
+ *
+ * The journal retains the objects its records mention, so that a removed
+ * child can be inserted back. Objects that nothing retains yet (root objects
+ * created from JS) aren't retained: they must outlive the steps that mention
+ * them.
+ *
+ * When its memory usage grows above its capacity, the journal forgets its
+ * oldest steps. The last step is always kept.
+ */
+namespace journal {
+
+class Writer
+{
+public:
+    explicit Writer(std::string& bytes)
+        : _bytes(bytes)
+    {}
+
+    void varuint(uint64_t value);
+    void varint(int64_t value);
+    void number(double value);
+    void string(std::string const& value);
+    void object(OTIO_NS::SerializableObject const* object);
+
+private:
+    std::string& _bytes;
+};
+
+class Reader
+{
+public:
+    Reader(char const* data, size_t size)
+        : _data(data)
+        , _end(data + size)
+    {}
+
+    uint64_t    varuint();
+    int64_t     varint();
+    double      number();
+    std::string string();
+
+    template <typename T = OTIO_NS::SerializableObject>
+    T* object()
+    {
+        return static_cast<T*>(
+            reinterpret_cast<OTIO_NS::SerializableObject*>(
+                static_cast<uintptr_t>(varuint())));
+    }
+
+private:
+    char const* _data;
+    char const* _end;
+};
+
+// Encoding of the values of the properties.
+void encode(Writer& writer, bool value);
+void encode(Writer& writer, int value);
+void encode(Writer& writer, double value);
+void encode(Writer& writer, std::string const& value);
+void encode(Writer& writer, OTIO_NS::RationalTime const& value);
+void encode(Writer& writer, OTIO_NS::TimeRange const& value);
+void encode(Writer& writer, Imath::Box2d const& value);
+void encode(Writer& writer, OTIO_NS::AnyDictionary const& value);
+
+void decode(Reader& reader, bool& value);
+void decode(Reader& reader, int& value);
+void decode(Reader& reader, double& value);
+void decode(Reader& reader, std::string& value);
+void decode(Reader& reader, OTIO_NS::RationalTime& value);
+void decode(Reader& reader, OTIO_NS::TimeRange& value);
+void decode(Reader& reader, Imath::Box2d& value);
+void decode(Reader& reader, OTIO_NS::AnyDictionary& value);
+
+template <typename T>
+std::enable_if_t<std::is_enum_v<T>>
+encode(Writer& writer, T value)
+{
+    writer.varint(static_cast<int64_t>(value));
+}
+
+template <typename T>
+std::enable_if_t<std::is_enum_v<T>>
+decode(Reader& reader, T& value)
+{
+    value = static_cast<T>(reader.varint());
+}
+
+template <typename T>
+void
+encode(Writer& writer, std::optional<T> const& value)
+{
+    encode(writer, value.has_value());
+    if (value)
+    {
+        encode(writer, *value);
+    }
+}
+
+template <typename T>
+void
+decode(Reader& reader, std::optional<T>& value)
+{
+    bool has_value = false;
+    decode(reader, has_value);
+    value.reset();
+    if (has_value)
+    {
+        decode(reader, value.emplace());
+    }
+}
+
+// Replays a record, with its old values when undo is true.
+using Apply = void (*)(Reader& reader, bool undo);
+
+} // namespace journal
+
+class Journal
+{
+public:
+    static constexpr size_t default_capacity = 16 << 20;
+
+    explicit Journal(size_t capacity = default_capacity);
+    // Deleting the journal that was recording when the open transaction
+    // began is rejected from JS (see pre.js). The transaction forgets it if
+    // it's deleted anyway.
+    ~Journal();
+
+    Journal(Journal const&)            = delete;
+    Journal& operator=(Journal const&) = delete;
+
+    // Record the modifications made through the bindings. Only one journal
+    // records at a time: starting a journal stops the one that was recording.
+    // Throws ValueError during a transaction, which records in its own
+    // journal.
+    void start();
+    void stop();
+    bool is_recording() const;
+
+    // Whether the open transaction uses the journal (see transaction.h).
+    bool is_used_by_transaction() const;
+
+    // Record the modifications made until the matching end_group() as a
+    // single step. Groups can be nested.
+    void begin_group();
+    void end_group();
+
+    // Revert the last step. Returns false if there is nothing to undo.
+    bool undo();
+    // Apply again the last reverted step. Returns false if there is nothing to
+    // redo.
+    bool redo();
+
+    bool   can_undo() const { return _position > 0; }
+    bool   can_redo() const { return _position < _steps.size(); }
+    size_t undo_count() const { return _position; }
+    size_t redo_count() const { return _steps.size() - _position; }
+
+    // Approximate number of bytes used by the steps.
+    size_t memory_usage() const { return _memory_usage; }
+
+    size_t capacity() const { return _capacity; }
+    void   set_capacity(size_t capacity);
+
+    // Forget every step.
+    void clear();
+
+    // Move the steps of other that can be undone to a single step of this
+    // journal (the current step if a group is open). other is cleared.
+    void absorb(Journal& other);
+
+    // Append a record to the current step: apply, object and the payload
+    // written by write(writer, journal). object is retained.
+    template <typename Write>
+    void record(
+        journal::Apply                     apply,
+        OTIO_NS::SerializableObject const* object,
+        Write&&                            write)
+    {
+        Step&           step = _step_for_record();
+        size_t          size = step.bytes.size();
+        journal::Writer writer(step.bytes);
+        try
+        {
+            writer.varuint(reinterpret_cast<uintptr_t>(apply));
+            writer.object(object);
+            retain(object);
+            write(writer, *this);
+        }
+        catch (...)
+        {
+            step.bytes.resize(size);
+            throw;
+        }
+        step.offsets.push_back(static_cast<uint32_t>(size));
+        _memory_usage += step.bytes.size() - size + sizeof(uint32_t);
+        _trim();
+    }
+
+    // Keep object alive as long as the current step, if something already
+    // retains it. Only valid while record() writes a record.
+    void retain(OTIO_NS::SerializableObject const* object);
+
+private:
+    struct Step
+    {
+        std::string                                          bytes;
+        std::vector<uint32_t>                                offsets;
+        std::vector<OTIO_NS::SerializableObject::Retainer<>> retained;
+    };
+
+    Step&  _step_for_record();
+    size_t _step_size(Step const& step) const;
+    void   _trim();
+
+    std::deque<Step> _steps;
+    // Number of steps that can be undone.
+    size_t _position     = 0;
+    size_t _group_depth  = 0;
+    bool   _appending    = false;
+    size_t _memory_usage = 0;
+    size_t _capacity;
+};
+
+namespace journal {
+
+// The recording journal, nullptr if none.
+Journal* active();
+
+namespace detail {
+
+template <typename Setter>
+struct SetterTraits;
+
+template <typename C, typename A>
+struct SetterTraits<void (C::*)(A)>
+{
+    using Class    = C;
+    using Argument = A;
+};
+
+template <typename C, typename A>
+struct SetterTraits<void (C::*)(A) noexcept>
+{
+    using Class    = C;
+    using Argument = A;
+};
+
+template <auto Setter>
+using Class = typename SetterTraits<decltype(Setter)>::Class;
+
+template <auto Setter>
+using Argument = typename SetterTraits<decltype(Setter)>::Argument;
+
+template <auto Setter>
+using Value = std::decay_t<Argument<Setter>>;
+
+template <auto Setter>
+void
+apply_property(Reader& reader, bool undo)
+{
+    auto          object = reader.object<Class<Setter>>();
+    Value<Setter> old_value;
+    Value<Setter> new_value;
+    decode(reader, old_value);
+    decode(reader, new_value);
+    (object->*Setter)(undo ? old_value : new_value);
+    mutation::touch(object);
+}
+
+} // namespace detail
+
+/**
+ * Property setter that records the modification in the active journal, calls
+ * Setter and touches the object (see mutation.h), for binding plain OTIO
+ * setters:
+ *
+ *   .property(
+ *       "color",
+ *       &Marker::color,
+ *       &journal::recording<&Marker::color, &Marker::set_color>)
+ */
+template <auto Getter, auto Setter>
+void
+recording(
+    detail::Class<Setter>&   object,
+    detail::Argument<Setter> value)
+{
+    Journal*              journal = active();
+    detail::Value<Setter> old_value;
+    if (journal)
+    {
+        old_value = (object.*Getter)();
+    }
+    (object.*Setter)(std::forward<detail::Argument<Setter>>(value));
+    mutation::touch(&object);
+    if (journal)
+    {
+        journal->record(
+            &detail::apply_property<Setter>,
+            &object,
+            [&](Writer& writer, Journal&) {
+                encode(writer, old_value);
+                encode(writer, (object.*Getter)());
+            });
+    }
+}
+
+// The modifications below also record themselves in the active journal and
+// touch the modified object.
+
+void set_metadata(
+    OTIO_NS::SerializableObjectWithMetadata& object,
+    OTIO_NS::AnyDictionary const&            metadata);
+
+void set_dynamic_fields(
+    OTIO_NS::SerializableObject&  object,
+    OTIO_NS::AnyDictionary const& dynamic_fields);
+
+void set_dynamic_field(
+    OTIO_NS::SerializableObject& object,
+    std::string const&           name,
+    linb::any const&             value);
+
+bool insert_child(
+    OTIO_NS::Composition& composition,
+    int                   index,
+    OTIO_NS::Composable*  child);
+
+bool append_child(OTIO_NS::Composition& composition, OTIO_NS::Composable* child);
+
+bool remove_child(OTIO_NS::Composition& composition, int index);
+
+void set_children(
+    OTIO_NS::Composition&                    composition,
+    std::vector<OTIO_NS::Composable*> const& children);
+
+void set_children(
+    OTIO_NS::SerializableCollection&                 collection,
+    std::vector<OTIO_NS::SerializableObject*> const& children);
+
+void insert_child(
+    OTIO_NS::SerializableCollection& collection,
+    int                              index,
+    OTIO_NS::SerializableObject*     child);
+
+bool set_child(
+    OTIO_NS::SerializableCollection& collection,
+    int                              index,
+    OTIO_NS::SerializableObject*     child);
+
+bool remove_child(OTIO_NS::SerializableCollection& collection, int index);
+
+void set_media_reference(
+    OTIO_NS::Clip&           clip,
+    OTIO_NS::MediaReference* media_reference);
+
+void set_media_references(
+    OTIO_NS::Clip&                        clip,
+    OTIO_NS::Clip::MediaReferences const& media_references,
+    std::string const&                    new_active_key);
+
+void set_active_media_reference_key(
+    OTIO_NS::Clip&     clip,
+    std::string const& new_active_key);
+
+// The effects (T = Effect) or the markers (T = Marker) of an item.
+template <typename T>
+std::vector<OTIO_NS::SerializableObject::Retainer<T>>&
+elements_of(OTIO_NS::Item& item);
+
+template <>
+inline std::vector<OTIO_NS::SerializableObject::Retainer<OTIO_NS::Effect>>&
+elements_of<OTIO_NS::Effect>(OTIO_NS::Item& item)
+{
+    return item.effects();
+}
+
+template <>
+inline std::vector<OTIO_NS::SerializableObject::Retainer<OTIO_NS::Marker>>&
+elements_of<OTIO_NS::Marker>(OTIO_NS::Item& item)
+{
+    return item.markers();
+}
+
+// Modifications of elements_of<T>(item). index must be valid: at most the
+// number of elements for insert_element(), less for the others.
+template <typename T>
+void insert_element(OTIO_NS::Item& item, size_t index, T* element);
+
+template <typename T>
+void set_element(OTIO_NS::Item& item, size_t index, T* element);
+
+template <typename T>
+void remove_element(OTIO_NS::Item& item, size_t index);
+
+} // namespace journal
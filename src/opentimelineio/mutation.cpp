@@ -0,0 +1,240 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+#include <unordered_map>
+#include <unordered_set>
+
+#include <opentimelineio/composable.h>
+#include <opentimelineio/composition.h>
+
+#include "mutation.h"
+
+namespace mutation {
+
+namespace {
+
+// Size of the side table above which it is reset.
+constexpr size_t max_size = 1 << 16;
+
+Stamp _generation          = 0;
+Stamp _detached_generation = 0;
+
+struct Stamps
+{
+    Stamp own     = 0;
+    Stamp subtree = 0;
+};
+
+std::unordered_map<OTIO_NS::SerializableObject const*, Stamps>&
+_stamps()
+{
+    static std::unordered_map<OTIO_NS::SerializableObject const*, Stamps>
+        stamps;
+    return stamps;
+}
+
+struct Deferred
+{
+    bool active = false;
+    // Touched objects whose stamps weren't updated yet.
+    std::vector<OTIO_NS::SerializableObject const*>        pending;
+    std::unordered_set<OTIO_NS::SerializableObject const*> pending_set;
+    // Every object touched since begin_deferred().
+    std::vector<OTIO_NS::SerializableObject*>              touched;
+    std::unordered_set<OTIO_NS::SerializableObject const*> touched_set;
+    std::vector<OTIO_NS::SerializableObject::Retainer<>>   retained;
+};
+
+Deferred&
+_deferred()
+{
+    static Deferred deferred;
+    return deferred;
+}
+
+// Updates the stamps of the pending objects with a single generation. The
+// walk up the ancestors stops at the first one that was already updated by a
+// sibling.
+void
+_flush()
+{
+    auto& deferred = _deferred();
+    if (deferred.pending.empty())
+    {
+        return;
+    }
+
+    if (_stamps().size() >= max_size)
+    {
+        reset();
+    }
+
+    Stamp stamp  = ++_generation;
+    auto& stamps = _stamps();
+    for (auto object: deferred.pending)
+    {
+        stamps[object] = { stamp, stamp };
+        auto composable = dynamic_cast<OTIO_NS::Composable const*>(object);
+        if (!composable)
+        {
+            _detached_generation = stamp;
+            continue;
+        }
+        for (auto parent = composable->parent(); parent;
+             parent      = parent->parent())
+        {
+            Stamp& subtree = stamps[parent].subtree;
+            if (subtree == stamp)
+            {
+                break;
+            }
+            subtree = stamp;
+        }
+    }
+    deferred.pending.clear();
+    deferred.pending_set.clear();
+}
+
+Stamps
+_find(OTIO_NS::SerializableObject const* object)
+{
+    _flush();
+    auto const& stamps = _stamps();
+    auto        it     = stamps.find(object);
+    return it == stamps.end() ? Stamps() : it->second;
+}
+
+} // namespace
+
+void
+touch(OTIO_NS::SerializableObject const* object)
+{
+    if (!object)
+    {
+        return;
+    }
+
+    auto& deferred = _deferred();
+    if (deferred.active
+        && deferred.touched_set.insert(object).second)
+    {
+        deferred.touched.push_back(
+            const_cast<OTIO_NS::SerializableObject*>(object));
+    }
+    // Objects that nothing retains can't be retained until the stamps are
+    // updated, and they have no owner whose stamps would need updating.
+    if (deferred.active && object->current_ref_count() > 0)
+    {
+        if (deferred.pending_set.insert(object).second)
+        {
+            deferred.pending.push_back(object);
+            deferred.retained.emplace_back(
+                const_cast<OTIO_NS::SerializableObject*>(object));
+        }
+        return;
+    }
+
+    if (_stamps().size() >= max_size)
+    {
+        reset();
+    }
+
+    Stamp stamp  = ++_generation;
+    auto& stamps = _stamps();
+    stamps[object] = { stamp, stamp };
+
+    auto composable = dynamic_cast<OTIO_NS::Composable const*>(object);
+    if (!composable)
+    {
+        _detached_generation = stamp;
+        return;
+    }
+    for (auto parent = composable->parent(); parent; parent = parent->parent())
+    {
+        stamps[parent].subtree = stamp;
+    }
+}
+
+void
+touch_detached()
+{
+    _detached_generation = ++_generation;
+}
+
+Stamp
+stamp(OTIO_NS::SerializableObject const* object)
+{
+    return _find(object).subtree;
+}
+
+Stamp
+own_stamp(OTIO_NS::SerializableObject const* object)
+{
+    return _find(object).own;
+}
+
+Stamp
+generation()
+{
+    _flush();
+    return _generation;
+}
+
+Stamp
+detached_generation()
+{
+    _flush();
+    return _detached_generation;
+}
+
+size_t
+size()
+{
+    _flush();
+    return _stamps().size();
+}
+
+void
+reset()
+{
+    _stamps().clear();
+    _detached_generation = ++_generation;
+}
+
+void
+begin_deferred()
+{
+    _deferred().active = true;
+}
+
+std::vector<OTIO_NS::SerializableObject*>
+end_deferred()
+{
+    _flush();
+    auto& deferred  = _deferred();
+    deferred.active = false;
+
+    // An object only retained by the deferral is deleted when it's released.
+    std::unordered_set<OTIO_NS::SerializableObject const*> released;
+    for (auto const& object: deferred.retained)
+    {
+        if (object.value->current_ref_count() == 1)
+        {
+            released.insert(object.value);
+        }
+    }
+    std::vector<OTIO_NS::SerializableObject*> touched;
+    for (auto object: deferred.touched)
+    {
+        if (!released.count(object))
+        {
+            touched.push_back(object);
+        }
+    }
+
+    deferred.touched.clear();
+    deferred.touched_set.clear();
+    deferred.retained.clear();
+    return touched;
+}
+
+} // namespace mutation
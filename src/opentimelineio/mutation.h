@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <opentimelineio/serializableObject.h>
+
+/**
+ * Mutation stamps let caches built on top of the object graph find out that
+ * the objects they depend on were modified. The bindings that modify objects
+ * (ranges, children, media references, names, metadata, ...) call touch().
+ *
+ * Every touch() increments a global generation and records it as the stamp of
+ * the object. Since the timing of a composable also depends on its children,
+ * touching a composable also updates the subtree stamp of its ancestors.
+ * Objects that don't know their owner (media references for example) can't
+ * do that, so touching them increments the "detached" generation instead,
+ * which invalidates everything that depends on detached objects.
+ *
+ * Stamps are kept in a side table that holds plain pointers, so a deleted
+ * object can leave a stale stamp behind. Stamps are only compared with
+ * previously recorded stamps or generations, so that can only lead to extra
+ * invalidations. Caches that record stamps must also record the detached
+ * generation, which is how reset() invalidates them.
+ *
+ * Between begin_deferred() and end_deferred() (see transaction.h), touching
+ * an object that something retains only records it, once, and retains it.
+ * The stamps of the recorded objects and of their ancestors are updated
+ * together when a stamp or a generation is read next, so modifying many
+ * children of a track updates the stamps of the track and its ancestors
+ * once.
+ */
+namespace mutation {
+
+using Stamp = uint64_t;
+
+// Record a modification of object.
+void touch(OTIO_NS::SerializableObject const* object);
+
+// Record a modification of an object whose owner isn't known, for example a
+// media reference. Same as touching a detached object.
+void touch_detached();
+
+// Stamp of the last modification of object or of one of its descendants, 0
+// if none was modified since the last reset().
+Stamp stamp(OTIO_NS::SerializableObject const* object);
+
+// Stamp of the last modification of object itself (not of its descendants).
+Stamp own_stamp(OTIO_NS::SerializableObject const* object);
+
+Stamp generation();
+Stamp detached_generation();
+
+// Number of objects in the side table.
+size_t size();
+
+// Forget every stamp. This also increments the detached generation. It's
+// called by touch() when the side table grows too large.
+void reset();
+
+void begin_deferred();
+
+// Stop deferring touches. Returns the objects touched since begin_deferred(),
+// once each, except the ones that were only retained by the deferral.
+std::vector<OTIO_NS::SerializableObject*> end_deferred();
+
+} // namespace mutation
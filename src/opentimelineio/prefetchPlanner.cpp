@@ -0,0 +1,385 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+#include <opentime/rationalTime.h>
+#include <opentime/timeRange.h>
+#include <opentimelineio/clip.h>
+#include <opentimelineio/composition.h>
+#include <opentimelineio/externalReference.h>
+#include <opentimelineio/generatorReference.h>
+#include <opentimelineio/imageSequenceReference.h>
+#include <opentimelineio/item.h>
+#include <opentimelineio/stack.h>
+#include <opentimelineio/timeline.h>
+
+#include "common_utils.h"
+#include "errorStatusHandler.h"
+#include "exceptions.h"
+#include "mutation.h"
+#include "prefetchPlanner.h"
+#include "utils.h"
+
+namespace {
+
+// Tolerance (in frames) used when listing the frames of an image sequence
+// that fall in a range, so that rounding errors don't add or drop a frame.
+constexpr double frame_tolerance = 1e-6;
+
+enum class Kind
+{
+    image_sequence,
+    external,
+    generator
+};
+
+struct FetchRequest
+{
+    std::string              key;
+    Kind                     kind;
+    OTIO_NS::MediaReference* reference;
+    OTIO_NS::Clip*           clip;
+    OTIO_NS::TimeRange       source_range;
+    std::set<int>            frames;
+    std::string              detail;
+    double                   distance;
+};
+
+std::string
+_reference_key(OTIO_NS::MediaReference const* reference)
+{
+    return "ref:" + std::to_string(reinterpret_cast<uintptr_t>(reference));
+}
+
+void
+_add_frames(
+    OTIO_NS::ImageSequenceReference const& reference,
+    OTIO_NS::TimeRange const&              range,
+    std::set<int>&                         frames)
+{
+    double rate = reference.rate();
+    if (rate <= 0)
+    {
+        return;
+    }
+
+    double start = range.start_time().to_seconds() * rate;
+    double end   = range.end_time_exclusive().to_seconds() * rate;
+    for (double value = std::floor(start + frame_tolerance);
+         value < end - frame_tolerance;
+         value += 1)
+    {
+        OTIO_NS::ErrorStatus error_status;
+        int                  frame = reference.frame_for_time(
+            OTIO_NS::RationalTime(value, rate),
+            &error_status);
+        if (!OTIO_NS::is_error(error_status))
+        {
+            frames.insert(frame);
+        }
+    }
+}
+
+} // namespace
+
+PrefetchPlanner::PrefetchPlanner(OTIO_NS::Timeline* timeline)
+    : _timeline(timeline)
+{
+    if (!timeline)
+    {
+        throw ValueError("PrefetchPlanner requires a timeline");
+    }
+}
+
+void
+PrefetchPlanner::reset()
+{
+    _issued.clear();
+    _has_window = false;
+}
+
+size_t
+PrefetchPlanner::clip_count()
+{
+    _update_index();
+    return _clips.size();
+}
+
+void
+PrefetchPlanner::_update_index()
+{
+    OTIO_NS::Stack* tracks = _timeline.value->tracks();
+    if (_indexed_tracks && tracks == _indexed_tracks
+        && mutation::stamp(tracks) == _indexed_stamp
+        && mutation::detached_generation() == _indexed_detached_generation)
+    {
+        return;
+    }
+
+    _clips.clear();
+    _max_duration = 0;
+    if (tracks)
+    {
+        _add_children(tracks, 0);
+    }
+    std::stable_sort(
+        _clips.begin(),
+        _clips.end(),
+        [](ClipEntry const& lhs, ClipEntry const& rhs) {
+            return lhs.start < rhs.start;
+        });
+
+    _indexed_tracks              = tracks;
+    _indexed_stamp               = mutation::stamp(tracks);
+    _indexed_detached_generation = mutation::detached_generation();
+}
+
+void
+PrefetchPlanner::_add_children(
+    OTIO_NS::Composition* composition,
+    double                offset)
+{
+    if (!composition->enabled())
+    {
+        return;
+    }
+
+    // range_of_all_children computes the ranges of a track in one pass,
+    // asking for them one by one is quadratic.
+    auto ranges = composition->range_of_all_children(ErrorStatusHandler());
+    for (auto const& child: composition->children())
+    {
+        auto item = dynamic_cast<OTIO_NS::Item*>(child.value);
+        auto range = ranges.find(child.value);
+        if (!item || !item->enabled() || range == ranges.end())
+        {
+            continue;
+        }
+
+        // Clips without a usable range are skipped, they can't be played.
+        OTIO_NS::ErrorStatus error_status;
+        OTIO_NS::TimeRange   trimmed = item->trimmed_range(&error_status);
+        if (OTIO_NS::is_error(error_status))
+        {
+            continue;
+        }
+
+        double start = offset + range->second.start_time().to_seconds();
+        double child_offset = start - trimmed.start_time().to_seconds();
+        if (auto clip = dynamic_cast<OTIO_NS::Clip*>(item))
+        {
+            double duration = range->second.duration().to_seconds();
+            _clips.push_back({ OTIO_NS::SerializableObject::Retainer<
+                                   OTIO_NS::Clip>(clip),
+                               start,
+                               start + duration,
+                               child_offset,
+                               trimmed.start_time().rate() });
+            _max_duration = std::max(_max_duration, duration);
+        }
+        else if (auto nested = dynamic_cast<OTIO_NS::Composition*>(item))
+        {
+            _add_children(nested, child_offset);
+        }
+    }
+}
+
+ems::val
+PrefetchPlanner::plan(
+    OTIO_NS::RationalTime const& playhead,
+    double                       speed,
+    OTIO_NS::RationalTime const& look_ahead)
+{
+    if (look_ahead.to_seconds() < 0)
+    {
+        throw ValueError("look_ahead can't be negative");
+    }
+    _update_index();
+
+    // The window covers the part of the timeline played during look_ahead.
+    // When playing backwards, the frame at the playhead is the last one of
+    // the window.
+    bool   reverse = speed < 0;
+    double factor  = speed == 0 ? 1 : std::abs(speed);
+    double extent  = look_ahead.to_seconds() * factor;
+    double time    = playhead.to_seconds();
+    double frame   = playhead.rate() > 0 ? 1 / playhead.rate() : 0;
+    double window_start = reverse ? time + frame - extent : time;
+    double window_end   = reverse ? time + frame : time + extent;
+
+    if (_has_window
+        && (window_end <= _window_start || window_start >= _window_end))
+    {
+        _issued.clear();
+    }
+
+    std::vector<FetchRequest>               requests;
+    std::unordered_map<std::string, size_t> request_index;
+
+    auto first = std::lower_bound(
+        _clips.begin(),
+        _clips.end(),
+        window_start - _max_duration,
+        [](ClipEntry const& entry, double value) {
+            return entry.start < value;
+        });
+    for (auto it = first; it != _clips.end() && it->start < window_end; ++it)
+    {
+        if (it->end <= window_start)
+        {
+            continue;
+        }
+
+        OTIO_NS::Clip*           clip      = it->clip.value;
+        OTIO_NS::MediaReference* reference = clip->media_reference();
+        double overlap_start = std::max(it->start, window_start);
+        double overlap_end   = std::min(it->end, window_end);
+        double rate          = it->rate;
+
+        FetchRequest request;
+        request.reference    = reference;
+        request.clip         = clip;
+        request.source_range = OTIO_NS::TimeRange::range_from_start_end_time(
+            OTIO_NS::RationalTime::from_seconds(
+                overlap_start - it->offset,
+                rate),
+            OTIO_NS::RationalTime::from_seconds(overlap_end - it->offset, rate));
+        request.distance =
+            std::max(0.0, reverse ? time + frame - overlap_end
+                                  : overlap_start - time);
+
+        if (auto sequence =
+                dynamic_cast<OTIO_NS::ImageSequenceReference*>(reference))
+        {
+            request.key  = _reference_key(reference);
+            request.kind = Kind::image_sequence;
+            _add_frames(*sequence, request.source_range, request.frames);
+        }
+        else if (
+            auto external =
+                dynamic_cast<OTIO_NS::ExternalReference*>(reference))
+        {
+            request.key    = "url:" + external->target_url();
+            request.kind   = Kind::external;
+            request.detail = external->target_url();
+        }
+        else if (
+            auto generator =
+                dynamic_cast<OTIO_NS::GeneratorReference*>(reference))
+        {
+            request.key    = _reference_key(reference);
+            request.kind   = Kind::generator;
+            request.detail = generator->generator_kind();
+        }
+        else
+        {
+            // Missing references (and unknown ones) have nothing to fetch.
+            continue;
+        }
+
+        auto existing = request_index.find(request.key);
+        if (existing == request_index.end())
+        {
+            request_index.emplace(request.key, requests.size());
+            requests.push_back(std::move(request));
+            continue;
+        }
+
+        FetchRequest& merged = requests[existing->second];
+        merged.source_range  = merged.source_range.extended_by(
+            request.source_range);
+        merged.frames.insert(request.frames.begin(), request.frames.end());
+        merged.distance = std::min(merged.distance, request.distance);
+    }
+
+    // Only return what the previous call didn't, and remember what the
+    // current window needs.
+    std::unordered_map<std::string, std::set<int>> issued;
+    std::vector<FetchRequest>                      pending;
+    for (auto& request: requests)
+    {
+        auto previous = _issued.find(request.key);
+        issued[request.key] = request.frames;
+        if (previous != _issued.end())
+        {
+            if (request.frames.empty())
+            {
+                continue;
+            }
+            for (int issued_frame: previous->second)
+            {
+                request.frames.erase(issued_frame);
+            }
+            if (request.frames.empty())
+            {
+                continue;
+            }
+        }
+        pending.push_back(std::move(request));
+    }
+    _issued       = std::move(issued);
+    _has_window   = true;
+    _window_start = window_start;
+    _window_end   = window_end;
+
+    std::stable_sort(
+        pending.begin(),
+        pending.end(),
+        [](FetchRequest const& lhs, FetchRequest const& rhs) {
+            return lhs.distance < rhs.distance;
+        });
+
+    ems::val result = ems::val::array();
+    for (auto const& request: pending)
+    {
+        ems::val item = ems::val::object();
+        item.set(
+            "reference",
+            managing_ptr<OTIO_NS::SerializableObject>(request.reference));
+        item.set("clip", managing_ptr<OTIO_NS::Clip>(request.clip));
+        item.set("source_range", request.source_range);
+        item.set("delay", request.distance / factor);
+        if (request.kind == Kind::image_sequence)
+        {
+            item.set("kind", std::string("image_sequence"));
+            std::vector<int32_t> frames(
+                request.frames.begin(),
+                request.frames.end());
+            if (reverse)
+            {
+                std::reverse(frames.begin(), frames.end());
+            }
+            item.set("frames", to_js_typed_array(frames));
+        }
+        else if (request.kind == Kind::external)
+        {
+            item.set("kind", std::string("external"));
+            item.set("url", request.detail);
+        }
+        else
+        {
+            item.set("kind", std::string("generator"));
+            item.set("generator_kind", request.detail);
+        }
+        result.call<void>("push", item);
+    }
+    return result;
+}
+
+EMSCRIPTEN_BINDINGS(opentimelineio_prefetchPlanner)
+{
+    ems::class_<PrefetchPlanner>("PrefetchPlanner")
+        .constructor<OTIO_NS::Timeline*>(ems::allow_raw_pointers())
+        .function("plan", &PrefetchPlanner::plan)
+        .function("reset", &PrefetchPlanner::reset)
+        .function("clip_count", &PrefetchPlanner::clip_count);
+
+    ADD_TO_STRING_TAG_PROPERTY(PrefetchPlanner);
+}
@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <emscripten/val.h>
+#include <opentime/rationalTime.h>
+#include <opentimelineio/clip.h>
+#include <opentimelineio/composition.h>
+#include <opentimelineio/serializableObject.h>
+#include <opentimelineio/stack.h>
+#include <opentimelineio/timeline.h>
+
+#include "mutation.h"
+
+namespace ems = emscripten;
+
+/**
+ * Decides which media a player needs to fetch next. Given the playhead, the
+ * playback speed and a look-ahead duration, plan() returns the media used by
+ * the clips under the upcoming part of the timeline, ordered by when they are
+ * needed:
+ *
+ *   {kind, reference, clip, source_range, delay, frames | url | generator_kind}
+ *
+ * kind is "image_sequence" (frames is an Int32Array of frame numbers in the
+ * order they are played), "external" (url) or "generator" (generator_kind).
+ * source_range is in the time of the media reference and delay is the number
+ * of seconds (at the given speed) before the media is needed. reference and
+ * clip are wrappers that retain their object, which JS deletes.
+ *
+ * Requests are deduplicated: external references by URL, the others by
+ * reference. Calls are incremental: as long as the look-ahead window moves
+ * continuously, media (or image sequence frames) returned by the previous
+ * call are not returned again. A window that doesn't overlap the previous one
+ * (a seek) or reset() starts over.
+ *
+ * Times are expressed in the time of the timeline's tracks (the global start
+ * time is not applied). Time effects are not taken into account.
+ */
+class PrefetchPlanner
+{
+public:
+    explicit PrefetchPlanner(OTIO_NS::Timeline* timeline);
+
+    ems::val plan(
+        OTIO_NS::RationalTime const& playhead,
+        double                       speed,
+        OTIO_NS::RationalTime const& look_ahead);
+
+    void reset();
+
+    // Number of clips in the index built from the timeline.
+    size_t clip_count();
+
+private:
+    struct ClipEntry
+    {
+        OTIO_NS::SerializableObject::Retainer<OTIO_NS::Clip> clip;
+        // Range of the clip in the time of the tracks, in seconds.
+        double start;
+        double end;
+        // Add to a time of the clip to get the time in the tracks.
+        double offset;
+        // Rate of the clip's trimmed range.
+        double rate;
+    };
+
+    void _update_index();
+    void _add_children(OTIO_NS::Composition* composition, double offset);
+
+    OTIO_NS::SerializableObject::Retainer<OTIO_NS::Timeline> _timeline;
+
+    // Enabled clips sorted by start time, rebuilt when the tracks change.
+    std::vector<ClipEntry> _clips;
+    double                 _max_duration                = 0;
+    OTIO_NS::Stack const*  _indexed_tracks              = nullptr;
+    mutation::Stamp        _indexed_stamp               = 0;
+    mutation::Stamp        _indexed_detached_generation = 0;
+
+    // What the previous call returned, per deduplication key. The frames are
+    // only used for image sequences.
+    std::unordered_map<std::string, std::set<int>> _issued;
+    bool                                           _has_window   = false;
+    double                                         _window_start = 0;
+    double                                         _window_end   = 0;
+};
@@ -0,0 +1,252 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+#include <cinttypes>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include <emscripten/bind.h>
+#include <opentimelineio/composition.h>
+#include <opentimelineio/serializableCollection.h>
+#include <opentimelineio/stack.h>
+#include <opentimelineio/timeline.h>
+
+#include "common_utils.h"
+#include "deepClone.h"
+#include "errorStatusHandler.h"
+#include "snapshotStore.h"
+
+namespace ems = emscripten;
+
+namespace {
+
+OTIO_NS::SerializableObject*
+_thaw(SnapshotNode const* node)
+{
+    if (!node)
+    {
+        return nullptr;
+    }
+
+    OTIO_NS::SerializableObject* result =
+        deep_clone::clone(node->object.value);
+    if (node->children.empty())
+    {
+        return result;
+    }
+
+    if (auto timeline = dynamic_cast<OTIO_NS::Timeline*>(result))
+    {
+        timeline->set_tracks(
+            static_cast<OTIO_NS::Stack*>(_thaw(node->children[0].get())));
+    }
+    else if (auto composition = dynamic_cast<OTIO_NS::Composition*>(result))
+    {
+        std::vector<OTIO_NS::Composable*> children;
+        children.reserve(node->children.size());
+        for (auto const& child: node->children)
+        {
+            children.push_back(
+                static_cast<OTIO_NS::Composable*>(_thaw(child.get())));
+        }
+        composition->set_children(children, ErrorStatusHandler());
+    }
+    else if (
+        auto collection =
+            dynamic_cast<OTIO_NS::SerializableCollection*>(result))
+    {
+        std::vector<OTIO_NS::SerializableObject*> children;
+        children.reserve(node->children.size());
+        for (auto const& child: node->children)
+        {
+            children.push_back(_thaw(child.get()));
+        }
+        collection->set_children(children);
+    }
+    return result;
+}
+
+// The children _freeze() freezes separately: the tracks of a timeline, the
+// children of tracks, stacks and collections.
+std::vector<OTIO_NS::SerializableObject const*>
+_children(OTIO_NS::SerializableObject const* object)
+{
+    std::vector<OTIO_NS::SerializableObject const*> children;
+    if (auto timeline = dynamic_cast<OTIO_NS::Timeline const*>(object))
+    {
+        if (timeline->tracks())
+        {
+            children.push_back(timeline->tracks());
+        }
+    }
+    else if (
+        auto composition = dynamic_cast<OTIO_NS::Composition const*>(object))
+    {
+        for (auto const& child: composition->children())
+        {
+            children.push_back(child.value);
+        }
+    }
+    else if (
+        auto collection =
+            dynamic_cast<OTIO_NS::SerializableCollection const*>(object))
+    {
+        for (auto const& child: collection->children())
+        {
+            children.push_back(child.value);
+        }
+    }
+    return children;
+}
+
+std::string
+_fields_json(OTIO_NS::SerializableObject const* object)
+{
+    return object->to_json_string(ErrorStatusHandler(), {}, 0);
+}
+
+// Whether node is a copy of object. Equal hashes only make that very likely,
+// so the fields of the copy are compared with the ones of object, and the
+// hashes of the children with the ones of the children of the copy.
+bool
+_is_copy_of(
+    SnapshotNode const&                node,
+    OTIO_NS::SerializableObject const* object)
+{
+    if (typeid(*node.object.value) != typeid(*object))
+    {
+        return false;
+    }
+    if (!deep_clone::is_container(object))
+    {
+        return _fields_json(node.object.value) == _fields_json(object);
+    }
+
+    auto children = _children(object);
+    if (children.size() != node.children.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+        if (content_hash::hash(children[i]) != node.children[i]->hash)
+        {
+            return false;
+        }
+    }
+    OTIO_NS::SerializableObject::Retainer<> fields(
+        deep_clone::clone_without_children(object));
+    return _fields_json(node.object.value) == _fields_json(fields.value);
+}
+
+} // namespace
+
+OTIO_NS::SerializableObject*
+Snapshot::restore() const
+{
+    return _thaw(_root.get());
+}
+
+std::string
+Snapshot::content_hash() const
+{
+    char buffer[17];
+    std::snprintf(
+        buffer,
+        sizeof(buffer),
+        "%016" PRIx64,
+        _root ? _root->hash : content_hash::Hash(0));
+    return buffer;
+}
+
+Snapshot
+SnapshotStore::take(OTIO_NS::SerializableObject const* object)
+{
+    Snapshot snapshot(_freeze(object));
+    _sweep();
+    return snapshot;
+}
+
+size_t
+SnapshotStore::node_count() const
+{
+    size_t count = 0;
+    for (auto const& node: _nodes)
+    {
+        count += node.second.expired() ? 0 : 1;
+    }
+    return count;
+}
+
+std::shared_ptr<SnapshotNode const>
+SnapshotStore::_freeze(OTIO_NS::SerializableObject const* object)
+{
+    if (!object)
+    {
+        return nullptr;
+    }
+
+    content_hash::Hash hash = content_hash::hash(object);
+    auto               it   = _nodes.find(hash);
+    if (it != _nodes.end())
+    {
+        auto node = it->second.lock();
+        if (node && _is_copy_of(*node, object))
+        {
+            return node;
+        }
+    }
+
+    auto node  = std::make_shared<SnapshotNode>();
+    node->hash = hash;
+    if (!deep_clone::is_container(object))
+    {
+        node->object = deep_clone::clone(object);
+    }
+    else
+    {
+        node->object = deep_clone::clone_without_children(object);
+        for (auto child: _children(object))
+        {
+            node->children.push_back(_freeze(child));
+        }
+    }
+
+    _nodes[hash] = node;
+    return node;
+}
+
+// Forgets the copies that no snapshot uses anymore, once the table doubled
+// since the last time.
+void
+SnapshotStore::_sweep()
+{
+    if (_nodes.size() < 2 * _swept_size + 1024)
+    {
+        return;
+    }
+    for (auto it = _nodes.begin(); it != _nodes.end();)
+    {
+        it = it->second.expired() ? _nodes.erase(it) : std::next(it);
+    }
+    _swept_size = _nodes.size();
+}
+
+EMSCRIPTEN_BINDINGS(opentimelineio_snapshotStore)
+{
+    ems::class_<Snapshot>("Snapshot")
+        .function("restore", &Snapshot::restore, ems::allow_raw_pointers())
+        .function("content_hash", &Snapshot::content_hash);
+
+    ADD_TO_STRING_TAG_PROPERTY(Snapshot);
+
+    ems::class_<SnapshotStore>("SnapshotStore")
+        .constructor<>()
+        .function("take", &SnapshotStore::take, ems::allow_raw_pointers())
+        .function("node_count", &SnapshotStore::node_count);
+
+    ADD_TO_STRING_TAG_PROPERTY(SnapshotStore);
+}
@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <opentimelineio/serializableObject.h>
+
+#include "contentHash.h"
+
+/**
+ * Copy-on-write snapshots of object graphs, for undo stacks and the like.
+ *
+ * A composable has a single parent, so two live graphs can't share a
+ * subtree. Snapshots are frozen instead: every object of the graph is copied
+ * without its children and the copies are shared by content hash (see
+ * contentHash.h) between all the snapshots of a store. A copy found by hash
+ * is only reused once its fields and the hashes of its children are checked
+ * against the object. Taking a snapshot after an edit only copies the objects
+ * on the path to the modified ones, the rest is shared with the previous
+ * snapshots. restore() builds a new graph from a snapshot.
+ *
+ * Shared copies live as long as one of the snapshots that use them.
+ */
+struct SnapshotNode
+{
+    OTIO_NS::SerializableObject::Retainer<>           object;
+    std::vector<std::shared_ptr<SnapshotNode const>> children;
+    content_hash::Hash                                hash;
+};
+
+class Snapshot
+{
+public:
+    explicit Snapshot(std::shared_ptr<SnapshotNode const> root = nullptr)
+        : _root(std::move(root))
+    {}
+
+    // New copy of the graph the snapshot was taken of. Nothing retains it
+    // yet.
+    OTIO_NS::SerializableObject* restore() const;
+
+    // Content hash of the graph when the snapshot was taken.
+    std::string content_hash() const;
+
+private:
+    std::shared_ptr<SnapshotNode const> _root;
+};
+
+class SnapshotStore
+{
+public:
+    Snapshot take(OTIO_NS::SerializableObject const* object);
+
+    // Number of copies that are used by snapshots.
+    size_t node_count() const;
+
+private:
+    std::shared_ptr<SnapshotNode const>
+    _freeze(OTIO_NS::SerializableObject const* object);
+
+    void _sweep();
+
+    std::unordered_map<content_hash::Hash, std::weak_ptr<SnapshotNode const>>
+           _nodes;
+    size_t _swept_size = 0;
+};
@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+#include <vector>
+
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+#include <opentimelineio/composition.h>
+#include <opentimelineio/item.h>
+#include <opentimelineio/linearTimeWarp.h>
+
+#include "common_utils.h"
+#include "errorStatusHandler.h"
+#include "exceptions.h"
+#include "timeMapper.h"
+
+TimeMapper::TimeMapper(OTIO_NS::Item* item)
+    : TimeMapper(item, item ? item->parent() : nullptr)
+{}
+
+TimeMapper::TimeMapper(OTIO_NS::Item* item, OTIO_NS::Composition* ancestor)
+    : _ancestor(ancestor)
+{
+    if (!item)
+    {
+        throw ValueError("TimeMapper requires an item");
+    }
+
+    // Collect the path bottom up, then store it top down.
+    std::vector<OTIO_NS::Item*> path;
+    for (OTIO_NS::Item* current = item; current != ancestor;)
+    {
+        path.push_back(current);
+        current = current->parent();
+        if (!current && ancestor)
+        {
+            throw NotAChildError(
+                "The item is not a descendant of the given ancestor");
+        }
+    }
+
+    for (auto it = path.rbegin(); it != path.rend(); ++it)
+    {
+        _path.emplace_back(*it);
+    }
+    update();
+}
+
+void
+TimeMapper::update()
+{
+    double scale  = 1;
+    double offset = 0;
+    for (auto const& retainer: _path)
+    {
+        OTIO_NS::Item* item = retainer.value;
+        double         start =
+            item->trimmed_range(ErrorStatusHandler()).start_time().to_seconds();
+
+        // Move from the parent's time to the item's own time. Without a
+        // parent, the times are already in the item's time.
+        if (item->parent())
+        {
+            offset += start
+                      - item->range_in_parent(ErrorStatusHandler())
+                            .start_time()
+                            .to_seconds();
+        }
+
+        // Each warp scales the time around the start of the trimmed range.
+        // FreezeFrame is a LinearTimeWarp with a scalar of 0. Other effects
+        // don't change the timing.
+        for (auto const& effect: item->effects())
+        {
+            if (auto warp =
+                    dynamic_cast<OTIO_NS::LinearTimeWarp*>(effect.value))
+            {
+                double scalar = warp->time_scalar();
+                scale *= scalar;
+                offset = scalar * offset + start * (1 - scalar);
+            }
+        }
+    }
+    _scale  = scale;
+    _offset = offset;
+}
+
+void
+TimeMapper::map(
+    double const* in,
+    double*       out,
+    size_t        size,
+    double        rate,
+    double        output_rate) const
+{
+    double scale  = _scale * output_rate / rate;
+    double offset = _offset * output_rate;
+    for (size_t i = 0; i < size; ++i)
+    {
+        out[i] = scale * in[i] + offset;
+    }
+}
+
+ems::val
+TimeMapper::map_many(
+    ems::val const& values,
+    double          rate,
+    double          output_rate,
+    ems::val        output) const
+{
+    if (rate <= 0 || output_rate <= 0)
+    {
+        throw ValueError("rates must be positive");
+    }
+
+    std::vector<double> data = ems::convertJSArrayToNumberVector<double>(values);
+    map(data.data(), data.data(), data.size(), rate, output_rate);
+
+    ems::val view = ems::val(ems::typed_memory_view(data.size(), data.data()));
+    if (output.isUndefined())
+    {
+        return view.call<ems::val>("slice");
+    }
+
+    if (output["length"].as<size_t>() < data.size())
+    {
+        throw ValueError("output is shorter than values");
+    }
+    output.call<void>("set", view);
+    return output;
+}
+
+EMSCRIPTEN_BINDINGS(opentimelineio_timeMapper)
+{
+    ems::class_<TimeMapper>("TimeMapper")
+        .constructor<OTIO_NS::Item*>(ems::allow_raw_pointers())
+        .constructor<OTIO_NS::Item*, OTIO_NS::Composition*>(
+            ems::allow_raw_pointers())
+        .property("scale", &TimeMapper::scale)
+        .property("offset", &TimeMapper::offset)
+        .function("update", &TimeMapper::update)
+        .function(
+            "map",
+            ems::optional_override(
+                [](TimeMapper const& m, ems::val const& values, double rate) {
+                    return m.map_many(values, rate, rate, ems::val::undefined());
+                }))
+        .function(
+            "map",
+            ems::optional_override([](TimeMapper const& m,
+                                      ems::val const&   values,
+                                      double            rate,
+                                      double            output_rate) {
+                return m.map_many(
+                    values,
+                    rate,
+                    output_rate,
+                    ems::val::undefined());
+            }))
+        .function("map_into", &TimeMapper::map_many);
+
+    ADD_TO_STRING_TAG_PROPERTY(TimeMapper);
+}
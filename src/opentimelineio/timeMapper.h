@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <emscripten/val.h>
+#include <opentimelineio/composition.h>
+#include <opentimelineio/item.h>
+#include <opentimelineio/serializableObject.h>
+
+namespace ems = emscripten;
+
+/**
+ * Maps times from the coordinate space of an ancestor (by default the parent)
+ * of an item to the media time of the item, applying the time effects
+ * (LinearTimeWarp and FreezeFrame) of every composable on the path.
+ *
+ * All the supported effects are linear, so the whole path collapses into a
+ * single "media = scale * time + offset" (in seconds) that is computed once
+ * when the mapper is created. Call update() after editing the items, ranges or
+ * effects on the path.
+ */
+class TimeMapper
+{
+public:
+    explicit TimeMapper(OTIO_NS::Item* item);
+    TimeMapper(OTIO_NS::Item* item, OTIO_NS::Composition* ancestor);
+
+    // Recompute the mapping from the current state of the path.
+    void update();
+
+    double scale() const { return _scale; }
+    double offset() const { return _offset; }
+
+    // Map values (at rate) to media times. The results are expressed in
+    // output_rate. in and out can be the same.
+    void map(
+        double const* in,
+        double*       out,
+        size_t        size,
+        double        rate,
+        double        output_rate) const;
+
+    // Map a JS array of values. When output is undefined, the results are
+    // returned in a new Float64Array, otherwise they are written into output
+    // (which can be values itself) and output is returned.
+    ems::val map_many(
+        ems::val const& values,
+        double          rate,
+        double          output_rate,
+        ems::val        output) const;
+
+private:
+    using ItemRetainer = OTIO_NS::SerializableObject::Retainer<OTIO_NS::Item>;
+    using CompositionRetainer =
+        OTIO_NS::SerializableObject::Retainer<OTIO_NS::Composition>;
+
+    // The items from the child of the ancestor down to the item itself.
+    // Retaining them keeps the path alive as long as the mapper.
+    std::vector<ItemRetainer> _path;
+    CompositionRetainer       _ancestor;
+
+    double _scale  = 1;
+    double _offset = 0;
+};
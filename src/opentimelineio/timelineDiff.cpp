@@ -0,0 +1,566 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+#include <opentime/rationalTime.h>
+#include <opentime/timeRange.h>
+#include <opentimelineio/composition.h>
+#include <opentimelineio/item.h>
+#include <opentimelineio/serializableCollection.h>
+#include <opentimelineio/serializableObject.h>
+#include <opentimelineio/serialization.h>
+#include <opentimelineio/stack.h>
+#include <opentimelineio/timeline.h>
+#include <opentimelineio/track.h>
+
+#include "contentHash.h"
+#include "errorStatusHandler.h"
+#include "exceptions.h"
+#include "timelineDiff.h"
+#include "utils.h"
+
+namespace ems = emscripten;
+
+namespace timeline_diff {
+
+namespace {
+
+// An element of a path: a key when key isn't empty, an index otherwise.
+struct PathElement
+{
+    std::string key;
+    int         index;
+};
+
+using Path = std::vector<PathElement>;
+
+// Fields of a container (everything but its children), as JSON.
+using Fields = std::vector<std::pair<std::string, std::string>>;
+
+enum class Kind
+{
+    timeline,
+    composition,
+    collection,
+    leaf
+};
+
+Kind
+_kind(OTIO_NS::SerializableObject const* object)
+{
+    if (dynamic_cast<OTIO_NS::Timeline const*>(object))
+    {
+        return Kind::timeline;
+    }
+    // Like for content hashes, other compositions may have fields that
+    // aren't known here.
+    if (dynamic_cast<OTIO_NS::Track const*>(object)
+        || dynamic_cast<OTIO_NS::Stack const*>(object))
+    {
+        return Kind::composition;
+    }
+    if (dynamic_cast<OTIO_NS::SerializableCollection const*>(object))
+    {
+        return Kind::collection;
+    }
+    return Kind::leaf;
+}
+
+std::string
+_json(linb::any const& value)
+{
+    return OTIO_NS::serialize_json_to_string(
+        value,
+        nullptr,
+        ErrorStatusHandler(),
+        0);
+}
+
+std::string
+_object_json(OTIO_NS::SerializableObject const* object)
+{
+    return object ? object->to_json_string(ErrorStatusHandler(), {}, 0)
+                  : "null";
+}
+
+template <typename V>
+std::string
+_objects_json(V const& objects)
+{
+    std::string result = "[";
+    for (auto const& object: objects)
+    {
+        if (result.size() > 1)
+        {
+            result += ",";
+        }
+        result += _object_json(object.value);
+    }
+    return result + "]";
+}
+
+ems::val
+_parse(std::string const& json)
+{
+    return ems::val::global("JSON").call<ems::val>("parse", json);
+}
+
+std::string
+_stringify(ems::val const& value)
+{
+    return ems::val::global("JSON")
+        .call<ems::val>("stringify", value)
+        .as<std::string>();
+}
+
+Fields
+_fields(OTIO_NS::SerializableObject const& object)
+{
+    Fields fields;
+    if (auto with_metadata =
+            dynamic_cast<OTIO_NS::SerializableObjectWithMetadata const*>(
+                &object))
+    {
+        fields.emplace_back("name", _json(linb::any(with_metadata->name())));
+        fields.emplace_back(
+            "metadata",
+            _json(linb::any(with_metadata->metadata())));
+    }
+
+    if (auto composition = dynamic_cast<OTIO_NS::Composition const*>(&object))
+    {
+        auto source_range = composition->source_range();
+        fields.emplace_back(
+            "source_range",
+            source_range ? _json(linb::any(*source_range)) : "null");
+        fields.emplace_back(
+            "enabled",
+            composition->enabled() ? "true" : "false");
+        fields.emplace_back("effects", _objects_json(composition->effects()));
+        fields.emplace_back("markers", _objects_json(composition->markers()));
+        if (auto track = dynamic_cast<OTIO_NS::Track const*>(composition))
+        {
+            fields.emplace_back("kind", _json(linb::any(track->kind())));
+        }
+    }
+    else if (auto timeline = dynamic_cast<OTIO_NS::Timeline const*>(&object))
+    {
+        auto global_start_time = timeline->global_start_time();
+        fields.emplace_back(
+            "global_start_time",
+            global_start_time ? _json(linb::any(*global_start_time))
+                              : "null");
+    }
+
+    for (auto const& field:
+         const_cast<OTIO_NS::SerializableObject&>(object).dynamic_fields())
+    {
+        fields.emplace_back(field.first, _json(field.second));
+    }
+    return fields;
+}
+
+// Source range of items, used to match children.
+std::string
+_range_key(OTIO_NS::SerializableObject const* object)
+{
+    auto item = dynamic_cast<OTIO_NS::Item const*>(object);
+    if (!item || !item->source_range())
+    {
+        return std::string();
+    }
+    OTIO_NS::TimeRange range = *item->source_range();
+    return std::to_string(range.start_time().value()) + "/"
+           + std::to_string(range.start_time().rate()) + "/"
+           + std::to_string(range.duration().value()) + "/"
+           + std::to_string(range.duration().rate());
+}
+
+std::string
+_name(OTIO_NS::SerializableObject const* object)
+{
+    auto with_metadata =
+        dynamic_cast<OTIO_NS::SerializableObjectWithMetadata const*>(object);
+    return with_metadata ? with_metadata->name() : std::string();
+}
+
+// Keys used to match children, by decreasing priority. An empty key doesn't
+// match anything.
+std::vector<std::function<std::string(OTIO_NS::SerializableObject const*)>>
+_match_keys()
+{
+    return {
+        [](OTIO_NS::SerializableObject const* object) {
+            return std::to_string(reinterpret_cast<uintptr_t>(object));
+        },
+        [](OTIO_NS::SerializableObject const* object) {
+            return content_hash::hash_string(object);
+        },
+        [](OTIO_NS::SerializableObject const* object) {
+            if (!object)
+            {
+                return std::string();
+            }
+            return object->schema_name() + "\n" + _name(object) + "\n"
+                   + _range_key(object);
+        },
+        [](OTIO_NS::SerializableObject const* object) {
+            std::string name = _name(object);
+            return name.empty() ? name : object->schema_name() + "\n" + name;
+        },
+        [](OTIO_NS::SerializableObject const* object) {
+            std::string range = _range_key(object);
+            return range.empty() ? range : object->schema_name() + "\n" + range;
+        },
+    };
+}
+
+// Marks the elements of values that are part of a longest increasing
+// subsequence.
+std::vector<bool>
+_longest_increasing(std::vector<int> const& values)
+{
+    std::vector<int> tails;
+    std::vector<int> previous(values.size(), -1);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        auto it = std::lower_bound(
+            tails.begin(),
+            tails.end(),
+            values[i],
+            [&values](int index, int value) { return values[index] < value; });
+        if (it != tails.begin())
+        {
+            previous[i] = *(it - 1);
+        }
+        if (it == tails.end())
+        {
+            tails.push_back(int(i));
+        }
+        else
+        {
+            *it = int(i);
+        }
+    }
+
+    std::vector<bool> result(values.size(), false);
+    for (int i = tails.empty() ? -1 : tails.back(); i >= 0; i = previous[i])
+    {
+        result[i] = true;
+    }
+    return result;
+}
+
+class Differ
+{
+public:
+    ems::val ops = ems::val::array();
+
+    void diff(
+        OTIO_NS::SerializableObject const* a,
+        OTIO_NS::SerializableObject const* b,
+        Path&                              path)
+    {
+        if (a == b || content_hash::hash(a) == content_hash::hash(b))
+        {
+            return;
+        }
+
+        Kind kind = _kind(a);
+        if (!a || !b || kind != _kind(b) || kind == Kind::leaf
+            || a->schema_name() != b->schema_name())
+        {
+            _diff_json(a, b, path);
+            return;
+        }
+
+        _diff_fields(_fields(*a), _fields(*b), path);
+        if (kind == Kind::timeline)
+        {
+            auto a_tracks = static_cast<OTIO_NS::Timeline const*>(a)->tracks();
+            auto b_tracks = static_cast<OTIO_NS::Timeline const*>(b)->tracks();
+            path.push_back({ "tracks", 0 });
+            diff(a_tracks, b_tracks, path);
+            path.pop_back();
+        }
+        else if (kind == Kind::composition)
+        {
+            _diff_children(
+                static_cast<OTIO_NS::Composition const*>(a)->children(),
+                static_cast<OTIO_NS::Composition const*>(b)->children(),
+                path);
+        }
+        else
+        {
+            _diff_children(
+                static_cast<OTIO_NS::SerializableCollection const*>(a)
+                    ->children(),
+                static_cast<OTIO_NS::SerializableCollection const*>(b)
+                    ->children(),
+                path);
+        }
+    }
+
+private:
+    ems::val _op(char const* name, Path const& path)
+    {
+        ems::val js_path = ems::val::array();
+        for (auto const& element: path)
+        {
+            if (element.key.empty())
+            {
+                js_path.call<void>("push", element.index);
+            }
+            else
+            {
+                js_path.call<void>("push", element.key);
+            }
+        }
+
+        ems::val op = ems::val::object();
+        op.set("op", std::string(name));
+        op.set("path", js_path);
+        ops.call<void>("push", op);
+        return op;
+    }
+
+    void _change(
+        Path const&        path,
+        std::string const& field,
+        ems::val const&    old_value,
+        ems::val const&    new_value)
+    {
+        ems::val op = _op("change", path);
+        op.set("field", field);
+        op.set("old", old_value);
+        op.set("new", new_value);
+    }
+
+    void
+    _diff_fields(Fields const& a_fields, Fields const& b_fields, Path& path)
+    {
+        std::unordered_map<std::string, std::string const*> a_values;
+        for (auto const& field: a_fields)
+        {
+            a_values.emplace(field.first, &field.second);
+        }
+
+        std::unordered_set<std::string> b_names;
+        for (auto const& field: b_fields)
+        {
+            b_names.insert(field.first);
+            auto it = a_values.find(field.first);
+            if (it == a_values.end())
+            {
+                _change(
+                    path,
+                    field.first,
+                    ems::val::undefined(),
+                    _parse(field.second));
+            }
+            else if (*it->second != field.second)
+            {
+                _change(
+                    path,
+                    field.first,
+                    _parse(*it->second),
+                    _parse(field.second));
+            }
+        }
+        for (auto const& field: a_fields)
+        {
+            if (!b_names.count(field.first))
+            {
+                _change(
+                    path,
+                    field.first,
+                    _parse(field.second),
+                    ems::val::undefined());
+            }
+        }
+    }
+
+    // Field by field comparison of the JSON of a and b.
+    void _diff_json(
+        OTIO_NS::SerializableObject const* a,
+        OTIO_NS::SerializableObject const* b,
+        Path&                              path)
+    {
+        ems::val a_value = _parse(_object_json(a));
+        ems::val b_value = _parse(_object_json(b));
+        if (!a || !b)
+        {
+            _change(path, std::string(), a_value, b_value);
+            return;
+        }
+
+        ems::val object = ems::val::global("Object");
+        auto     a_keys = ems::vecFromJSArray<std::string>(
+            object.call<ems::val>("keys", a_value));
+        auto b_keys = ems::vecFromJSArray<std::string>(
+            object.call<ems::val>("keys", b_value));
+
+        std::unordered_set<std::string> b_names(b_keys.begin(), b_keys.end());
+        for (auto const& key: b_keys)
+        {
+            bool     has_old   = a_value.call<bool>("hasOwnProperty", key);
+            ems::val old_field = has_old ? a_value[key] : ems::val::undefined();
+            ems::val new_field = b_value[key];
+            if (!has_old || _stringify(old_field) != _stringify(new_field))
+            {
+                _change(path, key, old_field, new_field);
+            }
+        }
+        for (auto const& key: a_keys)
+        {
+            if (!b_names.count(key))
+            {
+                _change(path, key, a_value[key], ems::val::undefined());
+            }
+        }
+    }
+
+    template <typename Children>
+    void _diff_children(Children const& a, Children const& b, Path& path)
+    {
+        std::vector<int> a_match(a.size(), -1);
+        std::vector<int> b_match(b.size(), -1);
+        size_t           matched = 0;
+
+        for (auto const& key: _match_keys())
+        {
+            if (matched == std::min(a.size(), b.size()))
+            {
+                break;
+            }
+
+            std::unordered_map<std::string, std::deque<int>> candidates;
+            for (size_t i = 0; i < a.size(); ++i)
+            {
+                if (a_match[i] < 0)
+                {
+                    std::string value = key(a[i].value);
+                    if (!value.empty())
+                    {
+                        candidates[value].push_back(int(i));
+                    }
+                }
+            }
+            if (candidates.empty())
+            {
+                continue;
+            }
+
+            for (size_t j = 0; j < b.size(); ++j)
+            {
+                if (b_match[j] >= 0)
+                {
+                    continue;
+                }
+                std::string value = key(b[j].value);
+                auto        it    = value.empty() ? candidates.end()
+                                                  : candidates.find(value);
+                if (it == candidates.end() || it->second.empty())
+                {
+                    continue;
+                }
+                int i = it->second.front();
+                it->second.pop_front();
+                a_match[i] = int(j);
+                b_match[j] = i;
+                ++matched;
+            }
+        }
+
+        // Matched children that keep their relative order stay, the others
+        // move.
+        std::vector<int> targets;
+        std::vector<int> sources;
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (a_match[i] >= 0)
+            {
+                targets.push_back(a_match[i]);
+                sources.push_back(int(i));
+            }
+        }
+        std::vector<bool> stays = _longest_increasing(targets);
+        std::vector<bool> moves(a.size(), false);
+        for (size_t k = 0; k < sources.size(); ++k)
+        {
+            moves[sources[k]] = !stays[k];
+        }
+
+        for (size_t i = a.size(); i-- > 0;)
+        {
+            if (a_match[i] < 0)
+            {
+                _op("delete", path).set("index", int(i));
+            }
+        }
+        for (size_t j = 0; j < b.size(); ++j)
+        {
+            int i = b_match[j];
+            if (i < 0)
+            {
+                ems::val op = _op("insert", path);
+                op.set("index", int(j));
+                op.set(
+                    "value",
+                    managing_ptr<OTIO_NS::SerializableObject>(b[j].value));
+            }
+            else if (moves[i])
+            {
+                ems::val op = _op("move", path);
+                op.set("from", i);
+                op.set("to", int(j));
+            }
+        }
+
+        for (size_t j = 0; j < b.size(); ++j)
+        {
+            if (b_match[j] >= 0)
+            {
+                path.push_back({ std::string(), int(j) });
+                diff(a[b_match[j]].value, b[j].value, path);
+                path.pop_back();
+            }
+        }
+    }
+};
+
+} // namespace
+
+ems::val
+diff(OTIO_NS::SerializableObject const* a, OTIO_NS::SerializableObject const* b)
+{
+    if (!a || !b)
+    {
+        throw ValueError("diff requires two objects");
+    }
+
+    Differ differ;
+    Path   path;
+    differ.diff(a, b, path);
+    return differ.ops;
+}
+
+} // namespace timeline_diff
+
+EMSCRIPTEN_BINDINGS(opentimelineio_timelineDiff)
+{
+    ems::function(
+        "diff",
+        &timeline_diff::diff,
+        ems::allow_raw_pointers());
+}
@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include <emscripten/val.h>
+#include <opentimelineio/serializableObject.h>
+
+/**
+ * Structural diff of two objects (usually two timelines), returned as an
+ * edit script: an array of
+ *
+ *   {op: 'delete', path, index}
+ *   {op: 'move',   path, from, to}
+ *   {op: 'insert', path, index, value}
+ *   {op: 'change', path, field, old, new}
+ *
+ * path locates an object, as the list of the keys to follow from the root:
+ * 'tracks' for the stack of a timeline and child indices for compositions
+ * and collections. delete, move and insert apply to the children of the
+ * object at path. index of delete and from of move are indices in a, index of
+ * insert and to of move are indices in b: applying them means removing the
+ * deleted and moved children of a (in descending order), then inserting the
+ * moved and inserted children at their index in b (in ascending order). The
+ * value of insert is the child of b, in a wrapper that retains it and that JS
+ * deletes. Paths of change are paths in b; old and new are the JSON values of
+ * the field.
+ *
+ * Children of a and b are matched by identity, then by content hash, then by
+ * schema, name and source range, then by schema and name and finally by
+ * schema and source range. Matched children that have the same content hash
+ * are not compared any further, which keeps the cost of the diff
+ * proportional to the size of the changes once the hashes are cached (see
+ * contentHash.h). Objects other than timelines, compositions and collections
+ * are compared field by field through their JSON serialization.
+ */
+namespace timeline_diff {
+
+emscripten::val
+diff(OTIO_NS::SerializableObject const* a, OTIO_NS::SerializableObject const* b);
+
+} // namespace timeline_diff
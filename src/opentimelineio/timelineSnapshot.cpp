@@ -0,0 +1,213 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+#include <opentimelineio/clip.h>
+#include <opentimelineio/composition.h>
+#include <opentimelineio/item.h>
+#include <opentimelineio/stack.h>
+#include <opentimelineio/timeline.h>
+
+#include "common_utils.h"
+#include "errorStatusHandler.h"
+#include "mutation.h"
+#include "timelineSnapshot.h"
+
+namespace ems = emscripten;
+
+namespace timeline_snapshot {
+
+namespace {
+
+class StringTable
+{
+public:
+    int32_t index(std::string const& value)
+    {
+        auto it = _indices.find(value);
+        if (it != _indices.end())
+        {
+            return it->second;
+        }
+        int32_t index = int32_t(_strings.size());
+        _indices.emplace(value, index);
+        _strings.push_back(value);
+        return index;
+    }
+
+    ems::val to_js() const
+    {
+        ems::val result = ems::val::array();
+        for (auto const& value: _strings)
+        {
+            result.call<void>("push", value);
+        }
+        return result;
+    }
+
+private:
+    std::unordered_map<std::string, int32_t> _indices;
+    std::vector<std::string>                 _strings;
+};
+
+struct Columns
+{
+    std::vector<int32_t> track;
+    std::vector<int32_t> index;
+    std::vector<double>  start;
+    std::vector<double>  duration;
+    std::vector<double>  rate;
+    std::vector<int32_t> schema;
+    std::vector<int32_t> name;
+    std::vector<int32_t> reference;
+    std::vector<int32_t> flags;
+    std::vector<int32_t> track_lengths;
+    StringTable          strings;
+
+    void add_row(
+        int32_t                   track_index,
+        int32_t                   child_index,
+        OTIO_NS::Composable*      child,
+        OTIO_NS::TimeRange const& range)
+    {
+        double row_rate = range.start_time().rate();
+        track.push_back(track_index);
+        index.push_back(child_index);
+        start.push_back(range.start_time().value());
+        duration.push_back(range.duration().value_rescaled_to(row_rate));
+        rate.push_back(row_rate);
+        schema.push_back(strings.index(child->schema_name()));
+        name.push_back(strings.index(child->name()));
+
+        auto clip = dynamic_cast<OTIO_NS::Clip*>(child);
+        auto media_reference = clip ? clip->media_reference() : nullptr;
+        reference.push_back(
+            media_reference ? strings.index(media_reference->schema_name())
+                            : -1);
+
+        auto    item      = dynamic_cast<OTIO_NS::Item*>(child);
+        int32_t row_flags = 0;
+        if (!item || item->enabled())
+        {
+            row_flags |= Flags::enabled;
+        }
+        if (child->visible())
+        {
+            row_flags |= Flags::visible;
+        }
+        if (child->overlapping())
+        {
+            row_flags |= Flags::overlapping;
+        }
+        flags.push_back(row_flags);
+    }
+
+    ems::val to_js(bool full) const
+    {
+        ems::val result = ems::val::object();
+        result.set("generation", double(mutation::generation()));
+        result.set("full", full);
+        result.set("track_lengths", to_js_typed_array(track_lengths));
+        result.set("strings", strings.to_js());
+        result.set("track", to_js_typed_array(track));
+        result.set("index", to_js_typed_array(index));
+        result.set("start", to_js_typed_array(start));
+        result.set("duration", to_js_typed_array(duration));
+        result.set("rate", to_js_typed_array(rate));
+        result.set("schema", to_js_typed_array(schema));
+        result.set("name", to_js_typed_array(name));
+        result.set("reference", to_js_typed_array(reference));
+        result.set("flags", to_js_typed_array(flags));
+        return result;
+    }
+};
+
+// since < 0 means everything.
+ems::val
+_snapshot(OTIO_NS::Timeline const& timeline, double since)
+{
+    OTIO_NS::Stack const* tracks = timeline.tracks();
+    bool                  full   = since < 0
+                  || double(mutation::detached_generation()) > since
+                  || double(mutation::own_stamp(tracks)) > since;
+
+    Columns columns;
+    if (!tracks)
+    {
+        return columns.to_js(true);
+    }
+
+    auto const& children = tracks->children();
+    for (size_t t = 0; t < children.size(); ++t)
+    {
+        auto track = dynamic_cast<OTIO_NS::Composition*>(children[t].value);
+        if (!track)
+        {
+            columns.track_lengths.push_back(0);
+            continue;
+        }
+
+        auto const& track_children = track->children();
+        columns.track_lengths.push_back(int32_t(track_children.size()));
+        if (!full && double(mutation::stamp(track)) <= since)
+        {
+            continue;
+        }
+
+        // A change of a child moves the children after it, so everything
+        // from the first changed child is returned. Changes of the track
+        // itself (its children for example) can move every child.
+        size_t first = 0;
+        if (!full && double(mutation::own_stamp(track)) <= since)
+        {
+            while (first < track_children.size()
+                   && double(mutation::stamp(track_children[first].value))
+                          <= since)
+            {
+                ++first;
+            }
+        }
+        if (first == track_children.size())
+        {
+            continue;
+        }
+
+        auto ranges = track->range_of_all_children(ErrorStatusHandler());
+        for (size_t c = first; c < track_children.size(); ++c)
+        {
+            OTIO_NS::Composable* child = track_children[c].value;
+            columns.add_row(int32_t(t), int32_t(c), child, ranges.at(child));
+        }
+    }
+    return columns.to_js(full);
+}
+
+} // namespace
+
+ems::val
+snapshot_columns(OTIO_NS::Timeline const& timeline)
+{
+    return _snapshot(timeline, -1);
+}
+
+ems::val
+snapshot_columns_since(OTIO_NS::Timeline const& timeline, double generation)
+{
+    return _snapshot(timeline, generation < 0 ? 0 : generation);
+}
+
+} // namespace timeline_snapshot
+
+EMSCRIPTEN_BINDINGS(opentimelineio_timelineSnapshot)
+{
+    ems::constant("SNAPSHOT_ENABLED", int(timeline_snapshot::Flags::enabled));
+    ems::constant("SNAPSHOT_VISIBLE", int(timeline_snapshot::Flags::visible));
+    ems::constant(
+        "SNAPSHOT_OVERLAPPING",
+        int(timeline_snapshot::Flags::overlapping));
+}
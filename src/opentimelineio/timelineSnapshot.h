@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include <emscripten/val.h>
+#include <opentimelineio/timeline.h>
+
+/**
+ * Columnar snapshot of the children of the tracks of a timeline, meant for
+ * drawing timeline views without reading every property one by one. Each row
+ * is a direct child of a track (clips, gaps, transitions and nested
+ * compositions) and the result is
+ *
+ *   {generation, full, track_lengths, strings,
+ *    track, index, start, duration, rate, schema, name, reference, flags}
+ *
+ * track and index locate the row (track is the index of the track in the
+ * timeline's stack, index the index of the child in the track). start and
+ * duration are the range of the child in its track, expressed at rate.
+ * schema, name and reference (the schema of the media reference of clips, -1
+ * otherwise) are indices into strings. flags is a combination of the
+ * SNAPSHOT_* constants. track_lengths has the number of children of every
+ * track.
+ */
+namespace timeline_snapshot {
+
+enum Flags
+{
+    enabled     = 1 << 0,
+    visible     = 1 << 1,
+    overlapping = 1 << 2
+};
+
+// Snapshot of every row.
+emscripten::val snapshot_columns(OTIO_NS::Timeline const& timeline);
+
+/**
+ * Snapshot of the rows that changed since generation (the generation of a
+ * previous snapshot). The other rows are the same as in that snapshot, except
+ * for the rows past the end of the tracks (see track_lengths), which were
+ * removed. When the changes can't be narrowed down, every row is returned and
+ * full is true.
+ */
+emscripten::val
+snapshot_columns_since(OTIO_NS::Timeline const& timeline, double generation);
+
+} // namespace timeline_snapshot
@@ -0,0 +1,165 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+#include <cstdint>
+#include <memory>
+
+#include "exceptions.h"
+#include "journal.h"
+#include "mutation.h"
+#include "transaction.h"
+
+namespace transaction {
+
+namespace {
+
+struct State
+{
+    OTIO_NS::SerializableObject* root  = nullptr;
+    size_t                       depth = 0;
+    // Records the modifications for rollback().
+    std::unique_ptr<Journal> journal;
+    // The journal that was recording when the transaction began.
+    Journal* previous = nullptr;
+};
+
+State&
+_state()
+{
+    static State state;
+    return state;
+}
+
+void
+_check_root(OTIO_NS::SerializableObject const* root)
+{
+    auto const& state = _state();
+    if (!state.root)
+    {
+        throw ValueError("No transaction is open");
+    }
+    if (state.root != root)
+    {
+        throw ValueError("The transaction was opened on another object");
+    }
+}
+
+// The transaction is closed first, so that it's closed even if an undo
+// throws during a rollback.
+std::vector<OTIO_NS::SerializableObject*>
+_close(bool commit)
+{
+    auto&                    state    = _state();
+    std::unique_ptr<Journal> journal  = std::move(state.journal);
+    Journal*                 previous = state.previous;
+    state.root                        = nullptr;
+    state.depth                       = 0;
+    state.previous                    = nullptr;
+
+    try
+    {
+        journal->stop();
+        if (!commit)
+        {
+            while (journal->undo())
+            {}
+        }
+        if (previous)
+        {
+            previous->start();
+            if (commit)
+            {
+                previous->absorb(*journal);
+            }
+        }
+    }
+    catch (...)
+    {
+        // The steps that weren't undone are dropped.
+        if (previous)
+        {
+            previous->start();
+        }
+        journal.reset();
+        mutation::end_deferred();
+        throw;
+    }
+
+    // The modified objects that only the journal retains are deleted here,
+    // before the touched objects that survive are collected.
+    journal.reset();
+    return mutation::end_deferred();
+}
+
+} // namespace
+
+void
+begin(OTIO_NS::SerializableObject* root)
+{
+    auto& state = _state();
+    if (state.root)
+    {
+        _check_root(root);
+        ++state.depth;
+        return;
+    }
+
+    state.root     = root;
+    state.depth    = 1;
+    state.previous = journal::active();
+    state.journal  = std::make_unique<Journal>(SIZE_MAX);
+    state.journal->start();
+    mutation::begin_deferred();
+}
+
+std::vector<OTIO_NS::SerializableObject*>
+commit(OTIO_NS::SerializableObject* root)
+{
+    _check_root(root);
+    auto& state = _state();
+    if (--state.depth > 0)
+    {
+        return {};
+    }
+    return _close(true);
+}
+
+void
+rollback(OTIO_NS::SerializableObject* root)
+{
+    _check_root(root);
+    _close(false);
+}
+
+bool
+is_open(OTIO_NS::SerializableObject const* root)
+{
+    return _state().root && _state().root == root;
+}
+
+Journal*
+recording_journal()
+{
+    // The journal is moved out of the state before the transaction closes, so
+    // that _close() can start the previous journal.
+    return _state().journal.get();
+}
+
+bool
+uses_journal(Journal const* journal)
+{
+    auto const& state = _state();
+    return journal && state.journal
+           && (journal == state.journal.get() || journal == state.previous);
+}
+
+void
+forget_journal(Journal const* journal) noexcept
+{
+    auto& state = _state();
+    if (journal && state.previous == journal)
+    {
+        state.previous = nullptr;
+    }
+}
+
+} // namespace transaction
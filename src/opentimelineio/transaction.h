@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include <vector>
+
+#include <opentimelineio/serializableObject.h>
+
+class Journal;
+
+/**
+ * Batched edits of an object graph.
+ *
+ * Between begin() and commit() on a root object, the bookkeeping that
+ * follows every modification made through the bindings is deferred and
+ * applied once per modified object at commit:
+ *
+ * - touches (see mutation.h): the stamps of a track are updated once
+ *   however many of its children are modified,
+ * - the change notification: commit() returns the objects that were
+ *   modified, once each.
+ *
+ * The modifications are recorded in a journal (see journal.h), so that
+ * rollback() can revert them. When a journal is recording, the whole
+ * transaction becomes a single step of it at commit.
+ *
+ * There is at most one transaction open at a time. Transactions on the same
+ * root can be nested, only the outermost commit() applies. Objects that
+ * nothing retains (root objects created from JS) must not be deleted during a
+ * transaction. No other journal can be started during a transaction, and the
+ * journal that was recording must not be deleted (see uses_journal()).
+ */
+namespace transaction {
+
+void begin(OTIO_NS::SerializableObject* root);
+
+std::vector<OTIO_NS::SerializableObject*>
+commit(OTIO_NS::SerializableObject* root);
+
+// Revert the modifications made since the outermost begin() and close the
+// transaction. If reverting a modification throws, the transaction is closed
+// before the exception is rethrown and the modifications that weren't
+// reverted yet are kept.
+void rollback(OTIO_NS::SerializableObject* root);
+
+bool is_open(OTIO_NS::SerializableObject const* root);
+
+// The journal that records the open transaction, nullptr if none.
+Journal* recording_journal();
+
+// Whether the open transaction uses journal: it records the transaction, or
+// it was recording when the transaction began and is started again when the
+// transaction closes.
+bool uses_journal(Journal const* journal);
+
+// Called when journal is deleted anyway, so that the transaction doesn't
+// start it again.
+void forget_journal(Journal const* journal) noexcept;
+
+} // namespace transaction
@@ -0,0 +1,225 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+#include <opentime/rationalTime.h>
+#include <opentime/timeTransform.h>
+#include <opentimelineio/composable.h>
+#include <opentimelineio/composition.h>
+#include <opentimelineio/item.h>
+
+#include "errorStatusHandler.h"
+#include "exceptions.h"
+#include "mutation.h"
+#include "opentime/timeArrays.h"
+#include "transformCache.h"
+
+namespace ems = emscripten;
+
+namespace transform_cache {
+
+namespace {
+
+struct Node
+{
+    OTIO_NS::SerializableObject::Retainer<OTIO_NS::Composable> composable;
+    OTIO_NS::Composition const*                                parent;
+    mutation::Stamp                                            stamp;
+};
+
+struct Entry
+{
+    opentime::TimeTransform transform;
+    std::vector<Node>       nodes;
+    mutation::Stamp         detached_generation;
+
+    bool valid() const
+    {
+        if (detached_generation != mutation::detached_generation())
+        {
+            return false;
+        }
+        for (auto const& node: nodes)
+        {
+            if (node.composable.value->parent() != node.parent
+                || mutation::stamp(node.composable.value) != node.stamp)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+using Key = std::pair<OTIO_NS::Item const*, OTIO_NS::Item const*>;
+
+struct KeyHash
+{
+    size_t operator()(Key const& key) const
+    {
+        size_t lhs = std::hash<void const*>()(key.first);
+        size_t rhs = std::hash<void const*>()(key.second);
+        return lhs ^ (rhs + 0x9e3779b9 + (lhs << 6) + (lhs >> 2));
+    }
+};
+
+std::unordered_map<Key, Entry, KeyHash>&
+_entries()
+{
+    static std::unordered_map<Key, Entry, KeyHash> entries;
+    return entries;
+}
+
+OTIO_NS::Composable const*
+_add_path(std::vector<Node>& nodes, OTIO_NS::Composable const* composable)
+{
+    OTIO_NS::Composable const* root = composable;
+    for (; composable; composable = composable->parent())
+    {
+        nodes.push_back(
+            { OTIO_NS::SerializableObject::Retainer<OTIO_NS::Composable>(
+                  const_cast<OTIO_NS::Composable*>(composable)),
+              composable->parent(),
+              mutation::stamp(composable) });
+        root = composable;
+    }
+    return root;
+}
+
+} // namespace
+
+opentime::TimeTransform
+transform(OTIO_NS::Item const* from, OTIO_NS::Item const* to)
+{
+    if (!from || !to)
+    {
+        throw ValueError("transformed_time requires two items");
+    }
+
+    auto& entries = _entries();
+    auto  it      = entries.find(Key(from, to));
+    if (it != entries.end() && it->second.valid())
+    {
+        return it->second.transform;
+    }
+
+    Entry entry;
+    entry.detached_generation = mutation::detached_generation();
+    if (_add_path(entry.nodes, from) != _add_path(entry.nodes, to))
+    {
+        throw NotAChildError("The items are not part of the same hierarchy");
+    }
+
+    // Item::transformed_time only adds and subtracts start times, so the
+    // transform of any time is the transform of 0 plus that time.
+    opentime::RationalTime offset = from->transformed_time(
+        opentime::RationalTime(0, 1),
+        to,
+        ErrorStatusHandler());
+    entry.transform = opentime::TimeTransform(offset);
+
+    if (it != entries.end())
+    {
+        it->second = std::move(entry);
+        return it->second.transform;
+    }
+    if (entries.size() >= max_size)
+    {
+        entries.clear();
+    }
+    return entries.emplace(Key(from, to), std::move(entry))
+        .first->second.transform;
+}
+
+void
+forget(std::unordered_set<OTIO_NS::SerializableObject const*> const& objects)
+{
+    auto& entries = _entries();
+    for (auto it = entries.begin(); it != entries.end();)
+    {
+        bool found = false;
+        for (auto const& node: it->second.nodes)
+        {
+            if (objects.count(node.composable.value))
+            {
+                found = true;
+                break;
+            }
+        }
+        it = found ? entries.erase(it) : std::next(it);
+    }
+}
+
+size_t
+retains(OTIO_NS::SerializableObject const* object)
+{
+    size_t count = 0;
+    for (auto const& entry: _entries())
+    {
+        for (auto const& node: entry.second.nodes)
+        {
+            if (node.composable.value == object)
+            {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+size_t
+size()
+{
+    return _entries().size();
+}
+
+void
+clear()
+{
+    _entries().clear();
+}
+
+} // namespace transform_cache
+
+EMSCRIPTEN_BINDINGS(opentimelineio_transformCache)
+{
+    ems::function(
+        "transformed_time_many",
+        ems::optional_override([](OTIO_NS::Item const* from,
+                                  OTIO_NS::Item const* to,
+                                  ems::val const&      values,
+                                  double               rate) {
+            return time_arrays::applied_to_many(
+                transform_cache::transform(from, to),
+                values,
+                rate,
+                ems::val::undefined());
+        }),
+        ems::allow_raw_pointers());
+    ems::function(
+        "transformed_time_many",
+        ems::optional_override([](OTIO_NS::Item const* from,
+                                  OTIO_NS::Item const* to,
+                                  ems::val const&      values,
+                                  double               rate,
+                                  ems::val             output) {
+            return time_arrays::applied_to_many(
+                transform_cache::transform(from, to),
+                values,
+                rate,
+                output);
+        }),
+        ems::allow_raw_pointers());
+    ems::function(
+        "transformed_time_cache_size",
+        &transform_cache::size);
+    ems::function("clear_transformed_time_cache", &transform_cache::clear);
+}
@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#pragma once
+
+#include <cstddef>
+#include <unordered_set>
+
+#include <opentime/timeTransform.h>
+#include <opentimelineio/item.h>
+
+/**
+ * Cache of the transforms used by Item::transformed_time. Converting a time
+ * from one item to another one only shifts it, by an amount that depends on
+ * the ranges of both items and of their ancestors. The shift is computed once
+ * per (from, to) pair and reused until one of the items on the two paths to
+ * the root is modified (see mutation.h).
+ *
+ * Cached entries retain the items of both paths, so that a reused address
+ * can't give a stale hit. The handle table makes the cache forget the tree of
+ * a root that JS released (see handleTable.h). The cache holds at most
+ * max_size entries and is emptied when it's full.
+ */
+namespace transform_cache {
+
+constexpr size_t max_size = 1024;
+
+// Transform that maps a time of from to the corresponding time of to. Throws
+// NotAChildError if the items don't share the same root.
+opentime::TimeTransform
+transform(OTIO_NS::Item const* from, OTIO_NS::Item const* to);
+
+// Drops the entries whose paths go through one of objects.
+void
+forget(std::unordered_set<OTIO_NS::SerializableObject const*> const& objects);
+
+// Number of references to object held by the cached entries.
+size_t retains(OTIO_NS::SerializableObject const* object);
+
+size_t size();
+void   clear();
+
+} // namespace transform_cache
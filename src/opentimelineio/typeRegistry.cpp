@@ -0,0 +1,795 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "any/any.hpp"
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+#include <opentime/rationalTime.h>
+#include <opentime/timeRange.h>
+#include <opentime/timeTransform.h>
+#include <opentimelineio/anyDictionary.h>
+#include <opentimelineio/anyVector.h>
+#include <opentimelineio/serializableObjectWithMetadata.h>
+#include <opentimelineio/typeRegistry.h>
+
+#include "exceptions.h"
+#include "js_anyDictionary.h" // Needed to support ems::val(AnyDictionary)
+#include "utils.h"
+
+namespace ems = emscripten;
+
+namespace {
+
+/**
+ * A single declarative field operation applied to the serialized fields of an
+ * object while it's being upgraded or downgraded. Paths are dotted, so
+ * "metadata.studio.shot" reaches into nested dictionaries.
+ */
+struct FieldOperation
+{
+    enum class Kind
+    {
+        rename,
+        move,
+        set_default,
+        drop
+    };
+
+    Kind                     kind;
+    std::vector<std::string> path;
+    std::vector<std::string> destination;
+    linb::any                value;
+};
+
+using FieldOperations = std::vector<FieldOperation>;
+
+std::vector<std::string>
+_split_path(std::string const& path)
+{
+    std::vector<std::string> parts;
+    size_t                   start = 0;
+    while (true)
+    {
+        size_t end = path.find('.', start);
+        parts.push_back(path.substr(start, end - start));
+        if (end == std::string::npos)
+        {
+            break;
+        }
+        start = end + 1;
+    }
+
+    for (auto const& part: parts)
+    {
+        if (part.empty())
+        {
+            throw ValueError("Invalid field path: '" + path + "'");
+        }
+    }
+    return parts;
+}
+
+/**
+ * Return the dictionary that holds the last component of path, or nullptr if
+ * one of the intermediate fields is missing or is not a dictionary. When
+ * create is true, missing intermediate dictionaries are created.
+ */
+OTIO_NS::AnyDictionary*
+_parent_dictionary(
+    OTIO_NS::AnyDictionary*         root,
+    std::vector<std::string> const& path,
+    bool                            create)
+{
+    OTIO_NS::AnyDictionary* d = root;
+    for (size_t i = 0; i + 1 < path.size(); ++i)
+    {
+        auto it = d->find(path[i]);
+        if (it == d->end())
+        {
+            if (!create)
+            {
+                return nullptr;
+            }
+            it = d->emplace(path[i], OTIO_NS::AnyDictionary()).first;
+        }
+
+        d = linb::any_cast<OTIO_NS::AnyDictionary>(&it->second);
+        if (!d)
+        {
+            return nullptr;
+        }
+    }
+    return d;
+}
+
+void
+_move_field(
+    OTIO_NS::AnyDictionary*         root,
+    std::vector<std::string> const& from,
+    std::vector<std::string> const& to)
+{
+    OTIO_NS::AnyDictionary* source = _parent_dictionary(root, from, false);
+    if (!source)
+    {
+        return;
+    }
+
+    auto it = source->find(from.back());
+    if (it == source->end())
+    {
+        return;
+    }
+
+    linb::any value = std::move(it->second);
+    source->erase(it);
+
+    OTIO_NS::AnyDictionary* destination = _parent_dictionary(root, to, true);
+    if (!destination)
+    {
+        throw ValueError(
+            "Cannot move field: an intermediate field of the destination is "
+            "not a dictionary");
+    }
+    (*destination)[to.back()] = std::move(value);
+}
+
+void
+_apply_operations(FieldOperations const& ops, OTIO_NS::AnyDictionary* d)
+{
+    for (auto const& op: ops)
+    {
+        switch (op.kind)
+        {
+            case FieldOperation::Kind::rename:
+            case FieldOperation::Kind::move:
+                _move_field(d, op.path, op.destination);
+                break;
+            case FieldOperation::Kind::set_default: {
+                OTIO_NS::AnyDictionary* parent =
+                    _parent_dictionary(d, op.path, true);
+                if (parent && parent->find(op.path.back()) == parent->end())
+                {
+                    (*parent)[op.path.back()] = op.value;
+                }
+                break;
+            }
+            case FieldOperation::Kind::drop: {
+                OTIO_NS::AnyDictionary* parent =
+                    _parent_dictionary(d, op.path, false);
+                if (parent)
+                {
+                    parent->erase(op.path.back());
+                }
+                break;
+            }
+        }
+    }
+}
+
+std::string
+_required_string(ems::val const& op, char const* key)
+{
+    ems::val value = op[key];
+    if (!value.isString())
+    {
+        throw TypeError(
+            std::string("Field operation is missing the '") + key
+            + "' string");
+    }
+    return value.as<std::string>();
+}
+
+linb::any
+_default_value(ems::val const& value)
+{
+    // js_to_any converts every number to an int.
+    if (value.isNumber())
+    {
+        double d = value.as<double>();
+        if (std::trunc(d) != d || std::abs(d) > 2147483647.0)
+        {
+            return linb::any(d);
+        }
+    }
+    return js_to_any(value);
+}
+
+/**
+ * Convert a JS array of operations into their native representation. This
+ * happens once at registration time, so loading files never calls into JS.
+ *
+ * Supported operations:
+ *   { op: 'rename', field: 'a.b', to: 'c' }   a.b becomes a.c
+ *   { op: 'move', field: 'a.b', to: 'c.d' }   a.b becomes c.d
+ *   { op: 'default', field: 'a.b', value: v } set a.b if it's missing
+ *   { op: 'drop', field: 'a.b' }              remove a.b
+ */
+std::shared_ptr<FieldOperations>
+_parse_operations(ems::val const& js_ops)
+{
+    if (!js_ops.isArray())
+    {
+        throw TypeError("Field operations must be an array");
+    }
+
+    auto   ops    = std::make_shared<FieldOperations>();
+    size_t length = js_ops["length"].as<size_t>();
+    for (size_t i = 0; i < length; ++i)
+    {
+        ems::val       js_op = js_ops[i];
+        std::string    kind  = _required_string(js_op, "op");
+        FieldOperation op;
+        op.path = _split_path(_required_string(js_op, "field"));
+
+        if (kind == "rename")
+        {
+            std::string to = _required_string(js_op, "to");
+            if (to.find('.') != std::string::npos)
+            {
+                throw ValueError(
+                    "rename only changes the name of a field, use move to "
+                    "change its location");
+            }
+            op.kind        = FieldOperation::Kind::rename;
+            op.destination = op.path;
+            op.destination.back() = to;
+        }
+        else if (kind == "move")
+        {
+            op.kind        = FieldOperation::Kind::move;
+            op.destination = _split_path(_required_string(js_op, "to"));
+        }
+        else if (kind == "default")
+        {
+            op.kind  = FieldOperation::Kind::set_default;
+            op.value = _default_value(js_op["value"]);
+        }
+        else if (kind == "drop")
+        {
+            op.kind = FieldOperation::Kind::drop;
+        }
+        else
+        {
+            throw ValueError("Unknown field operation: '" + kind + "'");
+        }
+
+        ops->push_back(std::move(op));
+    }
+    return ops;
+}
+
+/**
+ * Convert the fields given to an upgrade or downgrade function to JS. Unlike
+ * ems::val(AnyDictionary), this also converts the lists.
+ */
+ems::val
+_fields_to_js(linb::any const& value)
+{
+    if (auto d = linb::any_cast<OTIO_NS::AnyDictionary>(&value))
+    {
+        ems::val object = ems::val::object();
+        for (auto const& e: *d)
+        {
+            object.set(e.first, _fields_to_js(e.second));
+        }
+        return object;
+    }
+    if (auto v = linb::any_cast<OTIO_NS::AnyVector>(&value))
+    {
+        ems::val array = ems::val::array();
+        for (auto const& e: *v)
+        {
+            array.call<void>("push", _fields_to_js(e));
+        }
+        return array;
+    }
+    return any_to_js(value, false);
+}
+
+/**
+ * Convert fields modified by an upgrade or downgrade function back. JS only
+ * has one number type, so original (the value the field had before the call,
+ * if any) tells whether a whole number is a double. Numbers that aren't whole
+ * are always doubles.
+ */
+linb::any
+_fields_from_js(ems::val const& value, linb::any const* original)
+{
+    if (value.isNumber())
+    {
+        double d = value.as<double>();
+        if ((original && original->type() == typeid(double))
+            || std::trunc(d) != d)
+        {
+            return linb::any(d);
+        }
+        // An int64 field keeps its type even past the range of int.
+        if (original && original->type() == typeid(int64_t))
+        {
+            return linb::any(static_cast<int64_t>(d));
+        }
+        if (std::abs(d) > 2147483647.0)
+        {
+            return linb::any(d);
+        }
+        return linb::any(static_cast<int>(d));
+    }
+
+    if (value.isArray())
+    {
+        auto const* vector =
+            original ? linb::any_cast<OTIO_NS::AnyVector>(original) : nullptr;
+        OTIO_NS::AnyVector result;
+        size_t             length = value["length"].as<size_t>();
+        for (size_t i = 0; i < length; ++i)
+        {
+            result.push_back(_fields_from_js(
+                value[i],
+                vector && i < vector->size() ? &(*vector)[i] : nullptr));
+        }
+        return linb::any(std::move(result));
+    }
+
+    if (value.isNull() || value.isUndefined()
+        || value.typeOf().as<std::string>() != "object")
+    {
+        return js_to_any(value);
+    }
+
+    if (value.instanceof(ems::val::module_property("SerializableObject")))
+    {
+        return linb::any(OTIO_NS::SerializableObject::Retainer<>(
+            value.as<OTIO_NS::SerializableObject*>(ems::allow_raw_pointers())));
+    }
+
+    if (!value["constructor"].strictlyEquals(ems::val::global("Object")))
+    {
+        // Instances of the time classes.
+        return js_to_any(value);
+    }
+
+    // Plain objects are dictionaries, or time values in builds with
+    // OTIO_JS_TIME_VALUE_TYPES.
+    if (original)
+    {
+        if (original->type() == typeid(OTIO_NS::RationalTime))
+        {
+            return linb::any(value.as<OTIO_NS::RationalTime>());
+        }
+        if (original->type() == typeid(OTIO_NS::TimeRange))
+        {
+            return linb::any(value.as<OTIO_NS::TimeRange>());
+        }
+        if (original->type() == typeid(OTIO_NS::TimeTransform))
+        {
+            return linb::any(value.as<OTIO_NS::TimeTransform>());
+        }
+    }
+
+    auto const* dictionary =
+        original ? linb::any_cast<OTIO_NS::AnyDictionary>(original) : nullptr;
+    ems::val entries =
+        ems::val::global("Object").call<ems::val>("entries", value);
+    size_t                 length = entries["length"].as<size_t>();
+    OTIO_NS::AnyDictionary result;
+    for (size_t i = 0; i < length; ++i)
+    {
+        std::string      key   = entries[i][0].as<std::string>();
+        linb::any const* field = nullptr;
+        if (dictionary)
+        {
+            auto it = dictionary->find(key);
+            field   = it != dictionary->end() ? &it->second : nullptr;
+        }
+        result[key] = _fields_from_js(entries[i][1], field);
+    }
+    return linb::any(std::move(result));
+}
+
+std::function<void(OTIO_NS::AnyDictionary*)>
+_js_callback(ems::val const& callback)
+{
+    if (callback.typeOf().as<std::string>() != "function")
+    {
+        throw TypeError("Expected a function");
+    }
+
+    return [callback](OTIO_NS::AnyDictionary* d) {
+        // The fields are given back to d if the callback throws.
+        linb::any original(std::move(*d));
+        try
+        {
+            ems::val data   = _fields_to_js(original);
+            ems::val result = callback(data);
+            // The callback can either modify the object in place or return
+            // a new one.
+            linb::any fields = _fields_from_js(
+                result.isUndefined() ? data : result,
+                &original);
+            auto converted = linb::any_cast<OTIO_NS::AnyDictionary>(&fields);
+            if (!converted)
+            {
+                throw TypeError(
+                    "Upgrade and downgrade functions must return an object");
+            }
+            *d = std::move(*converted);
+        }
+        catch (...)
+        {
+            *d = std::move(
+                *linb::any_cast<OTIO_NS::AnyDictionary>(&original));
+            throw;
+        }
+    };
+}
+
+void
+_check_registered(
+    bool               registered,
+    char const*        kind,
+    std::string const& schema_name,
+    int                version)
+{
+    if (!registered)
+    {
+        throw ValueError(
+            std::string("The ") + kind + " function for " + schema_name
+            + " version " + std::to_string(version) + " is already registered");
+    }
+}
+
+/**
+ * Fields given to register_declared_schema: the declared type name and the
+ * default value of each field.
+ */
+struct DeclaredSchema
+{
+    std::map<std::string, std::string> types;
+    OTIO_NS::AnyDictionary             defaults;
+};
+
+/**
+ * Whether value, read from a file, has the declared type. Integers read for a
+ * double field are converted to double.
+ */
+bool
+_declared_field_matches(std::string const& type, linb::any& value)
+{
+    std::type_info const& read = value.type();
+    if (type == "any")
+    {
+        return true;
+    }
+    if (type == "object")
+    {
+        return value.empty()
+               || read == typeid(OTIO_NS::SerializableObject::Retainer<>);
+    }
+    if (type == "double")
+    {
+        if (read == typeid(int))
+        {
+            value = linb::any(double(linb::any_cast<int>(value)));
+        }
+        else if (read == typeid(int64_t))
+        {
+            value = linb::any(double(linb::any_cast<int64_t>(value)));
+        }
+        return value.type() == typeid(double);
+    }
+    if (type == "int")
+    {
+        return read == typeid(int) || read == typeid(int64_t);
+    }
+    if (type == "string")
+    {
+        return read == typeid(std::string);
+    }
+    if (type == "bool")
+    {
+        return read == typeid(bool);
+    }
+    if (type == "RationalTime")
+    {
+        return read == typeid(OTIO_NS::RationalTime);
+    }
+    if (type == "TimeRange")
+    {
+        return read == typeid(OTIO_NS::TimeRange);
+    }
+    if (type == "TimeTransform")
+    {
+        return read == typeid(OTIO_NS::TimeTransform);
+    }
+    if (type == "dictionary")
+    {
+        return read == typeid(OTIO_NS::AnyDictionary);
+    }
+    if (type == "list")
+    {
+        return read == typeid(OTIO_NS::AnyVector);
+    }
+    return false;
+}
+
+/**
+ * Object created for schemas registered with register_declared_schema. The
+ * declared fields are stored as dynamic fields. Reading fails if a declared
+ * field has another type, and defaults are applied again after reading so
+ * that fields missing from a file are still present.
+ */
+template <typename BASE>
+class DeclaredSchemaObject : public BASE
+{
+public:
+    explicit DeclaredSchemaObject(std::shared_ptr<DeclaredSchema const> schema)
+        : _schema(std::move(schema))
+    {
+        this->dynamic_fields() = _schema->defaults;
+    }
+
+protected:
+    ~DeclaredSchemaObject() override = default;
+
+    bool read_from(OTIO_NS::SerializableObject::Reader& reader) override
+    {
+        if (!BASE::read_from(reader))
+        {
+            return false;
+        }
+
+        OTIO_NS::AnyDictionary& fields = this->dynamic_fields();
+        for (auto const& e: _schema->types)
+        {
+            auto found = fields.find(e.first);
+            if (found == fields.end())
+            {
+                fields[e.first] = _schema->defaults.at(e.first);
+            }
+            else if (!_declared_field_matches(e.second, found->second))
+            {
+                reader.error(OTIO_NS::ErrorStatus(
+                    OTIO_NS::ErrorStatus::TYPE_MISMATCH,
+                    "Field '" + e.first + "' must be of type " + e.second));
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    std::shared_ptr<DeclaredSchema const> _schema;
+};
+
+/**
+ * Default value for a field declared with register_declared_schema. type is
+ * the declared type name, value the optional default given from JS.
+ */
+linb::any
+_declared_field_default(std::string const& type, ems::val const& value)
+{
+    bool has_value = !value.isUndefined();
+
+    if (type == "string")
+    {
+        return linb::any(has_value ? value.as<std::string>() : std::string());
+    }
+    if (type == "int")
+    {
+        return linb::any(has_value ? value.as<int>() : 0);
+    }
+    if (type == "double")
+    {
+        return linb::any(has_value ? value.as<double>() : 0.0);
+    }
+    if (type == "bool")
+    {
+        return linb::any(has_value ? value.as<bool>() : false);
+    }
+    if (type == "RationalTime")
+    {
+        return linb::any(
+            has_value ? value.as<OTIO_NS::RationalTime>()
+                      : OTIO_NS::RationalTime());
+    }
+    if (type == "TimeRange")
+    {
+        return linb::any(
+            has_value ? value.as<OTIO_NS::TimeRange>() : OTIO_NS::TimeRange());
+    }
+    if (type == "TimeTransform")
+    {
+        return linb::any(
+            has_value ? value.as<OTIO_NS::TimeTransform>()
+                      : OTIO_NS::TimeTransform());
+    }
+    if (type == "dictionary")
+    {
+        return linb::any(
+            has_value ? js_map_to_cpp(value) : OTIO_NS::AnyDictionary());
+    }
+    if (type == "list")
+    {
+        return linb::any(
+            has_value ? js_array_to_cpp(value) : OTIO_NS::AnyVector());
+    }
+    if (type == "object")
+    {
+        if (has_value && !value.isNull())
+        {
+            throw ValueError("Fields of type object can only default to null");
+        }
+        return linb::any(OTIO_NS::SerializableObject::Retainer<>());
+    }
+    if (type == "any")
+    {
+        return has_value ? _default_value(value) : linb::any();
+    }
+
+    throw ValueError("Unknown field type: '" + type + "'");
+}
+
+/**
+ * Parse the fields given to register_declared_schema. Each field is declared
+ * either with a type name or with an object { type, default }. name and
+ * metadata are reserved when the schema has metadata.
+ */
+DeclaredSchema
+_parse_declared_fields(ems::val const& js_fields, bool with_metadata)
+{
+    ems::val entries =
+        ems::val::global("Object").call<ems::val>("entries", js_fields);
+    size_t length = entries["length"].as<size_t>();
+
+    DeclaredSchema schema;
+    for (size_t i = 0; i < length; ++i)
+    {
+        std::string name = entries[i][0].as<std::string>();
+        ems::val    spec = entries[i][1];
+        if (name == "OTIO_SCHEMA")
+        {
+            throw ValueError("OTIO_SCHEMA can't be declared as a field");
+        }
+        if (with_metadata && (name == "name" || name == "metadata"))
+        {
+            throw ValueError(
+                name + " is reserved in a schema with metadata");
+        }
+
+        std::string type =
+            spec.isString() ? spec.as<std::string>()
+                            : _required_string(spec, "type");
+        schema.defaults[name] = _declared_field_default(
+            type,
+            spec.isString() ? ems::val::undefined() : spec["default"]);
+        schema.types[name] = type;
+    }
+    return schema;
+}
+
+} // namespace
+
+EMSCRIPTEN_BINDINGS(opentimelineio_typeRegistry)
+{
+    ems::function(
+        "register_upgrade_operations",
+        ems::optional_override([](std::string const& schema_name,
+                                  int                version_to_upgrade_to,
+                                  ems::val           operations) {
+            auto ops = _parse_operations(operations);
+            _check_registered(
+                OTIO_NS::TypeRegistry::instance().register_upgrade_function(
+                    schema_name,
+                    version_to_upgrade_to,
+                    [ops](OTIO_NS::AnyDictionary* d) {
+                        _apply_operations(*ops, d);
+                    }),
+                "upgrade",
+                schema_name,
+                version_to_upgrade_to);
+        }));
+
+    ems::function(
+        "register_downgrade_operations",
+        ems::optional_override([](std::string const& schema_name,
+                                  int                version_to_downgrade_from,
+                                  ems::val           operations) {
+            auto ops = _parse_operations(operations);
+            _check_registered(
+                OTIO_NS::TypeRegistry::instance().register_downgrade_function(
+                    schema_name,
+                    version_to_downgrade_from,
+                    [ops](OTIO_NS::AnyDictionary* d) {
+                        _apply_operations(*ops, d);
+                    }),
+                "downgrade",
+                schema_name,
+                version_to_downgrade_from);
+        }));
+
+    // Register a schema whose instances are entirely created and populated
+    // natively. Unlike register_serializable_object_type, loading a file
+    // doesn't call a JS constructor per object: JS wrappers are only created
+    // for the objects that are accessed from JS. Fields are stored as dynamic
+    // fields.
+    ems::function(
+        "register_declared_schema",
+        ems::optional_override([](std::string const& schema_name,
+                                  int                schema_version,
+                                  ems::val           fields,
+                                  bool               with_metadata) {
+            auto schema = std::make_shared<DeclaredSchema const>(
+                _parse_declared_fields(fields, with_metadata));
+
+            std::function<OTIO_NS::SerializableObject*()> create =
+                [schema_name, schema, with_metadata]() {
+                    OTIO_NS::SerializableObject* so = nullptr;
+                    if (with_metadata)
+                    {
+                        so = new DeclaredSchemaObject<
+                            OTIO_NS::SerializableObjectWithMetadata>(schema);
+                    }
+                    else
+                    {
+                        so = new DeclaredSchemaObject<
+                            OTIO_NS::SerializableObject>(schema);
+                    }
+                    OTIO_NS::TypeRegistry::instance().set_type_record(
+                        so,
+                        schema_name);
+                    return so;
+                };
+
+            if (!OTIO_NS::TypeRegistry::instance().register_type(
+                    schema_name,
+                    schema_version,
+                    nullptr,
+                    create,
+                    schema_name))
+            {
+                throw ValueError(
+                    "Schema " + schema_name + " is already registered");
+            }
+        }));
+
+    // Fallbacks for migrations that can't be expressed with operations. These
+    // call into JS once per object.
+    ems::function(
+        "register_upgrade_function",
+        ems::optional_override([](std::string const& schema_name,
+                                  int                version_to_upgrade_to,
+                                  ems::val           upgrade_function) {
+            _check_registered(
+                OTIO_NS::TypeRegistry::instance().register_upgrade_function(
+                    schema_name,
+                    version_to_upgrade_to,
+                    _js_callback(upgrade_function)),
+                "upgrade",
+                schema_name,
+                version_to_upgrade_to);
+        }));
+
+    ems::function(
+        "register_downgrade_function",
+        ems::optional_override([](std::string const& schema_name,
+                                  int                version_to_downgrade_from,
+                                  ems::val           downgrade_function) {
+            _check_registered(
+                OTIO_NS::TypeRegistry::instance().register_downgrade_function(
+                    schema_name,
+                    version_to_downgrade_from,
+                    _js_callback(downgrade_function)),
+                "downgrade",
+                schema_name,
+                version_to_downgrade_from);
+        }));
+}
@@ -14,6 +14,7 @@
 #include <emscripten.h>
 #include <emscripten/val.h>
 #include <functional>
+#include <memory>
 #include <typeinfo>
 
 #include "exceptions.h"
@@ -298,61 +299,3 @@ js_map_to_cpp(ems::val const& m)
 
     return d;
 }
-
-struct KeepaliveMonitor
-{
-    OTIO_NS::SerializableObject* _so;
-    ems::val                     _keep_alive;
-
-    KeepaliveMonitor(OTIO_NS::SerializableObject* so)
-        : _so(so)
-    {
-        // printf("Constructing KeepaliveMonitor for %s\n", typeid(*so).name());
-    }
-
-    void monitor()
-    {
-        // printf("KeepaliveMonitor::monitor\n");
-        if (_so->current_ref_count() > 1)
-        {
-            // printf("KeepaliveMonitor::monitor: current_ref_count > 1\n");
-            if (!_keep_alive)
-            {
-                // printf(
-                //     "KeepaliveMonitor::monitor: _keep_alive is empty, setting it\n");
-                _keep_alive = ems::val(_so);
-                // printf(
-                //     "KeepaliveMonitor::monitor: Successfully set _keep_alive\n");
-            }
-        }
-        else
-        {
-            // printf("KeepaliveMonitor::monitor: current_ref_count < 1\n");
-            // Note that ems::val works with ! only. SO double negate to get the truthy value.
-            if (!!_keep_alive)
-            {
-                // printf(
-                //     "KeepaliveMonitor::monitor: _keep_alive is truthy, trying to set to to undefined (clearing)\n");
-                _keep_alive =
-                    ems::val::undefined(); // this could cause destruction
-            }
-        }
-        // printf("KeepaliveMonitor::monitor: end\n");
-    }
-};
-
-void
-install_external_keepalive_monitor(
-    OTIO_NS::SerializableObject* so,
-    bool                         apply_now)
-{
-    KeepaliveMonitor m{ so };
-    using namespace std::placeholders;
-    // printf(
-    //     "Install external keep alive for %p: apply now is %d\n",
-    //     so,
-    //     apply_now);
-    so->install_external_keepalive_monitor(
-        std::bind(&KeepaliveMonitor::monitor, m),
-        apply_now);
-}
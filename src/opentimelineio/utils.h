@@ -6,6 +6,8 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -15,10 +17,13 @@
 #include <opentimelineio/any.h>
 #include <opentimelineio/anyDictionary.h>
 #include <opentimelineio/anyVector.h>
+#include <opentimelineio/item.h>
 #include <opentimelineio/serializableObject.h>
 #include <opentimelineio/vectorIndexing.h>
 
 #include "exceptions.h"
+#include "handleTable.h"
+#include "journal.h"
 
 namespace ems = emscripten;
 
@@ -35,65 +40,119 @@ OTIO_NS::AnyVector js_array_to_cpp(ems::val const& item);
 
 OTIO_NS::AnyDictionary js_map_to_cpp(ems::val const& item);
 
-void install_external_keepalive_monitor(
-    OTIO_NS::SerializableObject* so,
-    bool                         apply_now);
+/**
+ * Address of object as a number, 0 for null. The wrapper cache of pre.js
+ * looks the address up before embind creates a wrapper.
+ */
+inline size_t
+object_address(OTIO_NS::SerializableObject const* object)
+{
+    return reinterpret_cast<uintptr_t>(object);
+}
+
+// Address of the element at index of a vector bound with register_vector, 0
+// if there's none.
+template <typename T>
+size_t
+element_address(std::vector<T*> const& v, size_t index)
+{
+    return index < v.size() ? object_address(v[index]) : 0;
+}
 
+/**
+ * Smart pointer of the objects held by JS. It's an owner of the slot of the
+ * object in the handle table (see handleTable.h), which retains the object.
+ */
 template <typename T>
 struct managing_ptr
 {
+    managing_ptr() = default;
+
+    explicit managing_ptr(T* ptr)
+        : _ptr(ptr)
+        , _handle(ptr ? handle_table::acquire_wrapper(ptr) : handle_table::null)
+    {}
+
+    managing_ptr(managing_ptr const& other)
+        : _ptr(other._ptr)
+        , _handle(other._handle)
+    {
+        if (_handle != handle_table::null)
+        {
+            handle_table::retain_wrapper(_handle);
+        }
+    }
 
-    managing_ptr()
-        : _retainer(nullptr)
+    managing_ptr(managing_ptr&& other) noexcept
+        : _ptr(std::exchange(other._ptr, nullptr))
+        , _handle(std::exchange(other._handle, handle_table::null))
+    {}
+
+    managing_ptr& operator=(managing_ptr other) noexcept
     {
-        printf("Created managing_ptr (nullptr)\n");
+        std::swap(_ptr, other._ptr);
+        std::swap(_handle, other._handle);
+        return *this;
     }
 
-    explicit managing_ptr(T* ptr)
-        : _retainer(ptr)
+    ~managing_ptr()
     {
-        printf("Created managing_ptr (%s)\n", typeid(*_retainer.value).name());
-        install_external_keepalive_monitor(ptr, false);
+        if (_handle != handle_table::null)
+        {
+            handle_table::release_wrapper(_handle);
+        }
     }
 
-    T* get() const { return _retainer.value; }
+    T* get() const { return _ptr; }
+
+    handle_table::Handle handle() const { return _handle; }
 
-    OTIO_NS::SerializableObject::Retainer<T> _retainer;
+    T*                   _ptr    = nullptr;
+    handle_table::Handle _handle = handle_table::null;
 };
 
-template <typename V, typename VALUE_TYPE = typename V::value_type>
-struct JSMutableSequence : public V
+/**
+ * JS sequence of the effects (T = Effect) or the markers (T = Marker) of an
+ * item. Modifications go through journal.h, so they're recorded and touch the
+ * item. The proxy doesn't retain the item.
+ */
+template <typename T>
+struct JSMutableSequence
 {
     class Iterator
     {
     public:
-        Iterator(V& v)
-            : _v(v)
+        Iterator(OTIO_NS::Item* item)
+            : _item(item)
             , _it(0)
         {}
 
         ems::val next()
         {
+            auto&    v      = journal::elements_of<T>(*_item);
             ems::val result = ems::val::object();
-            if (_it == _v.size())
+            if (_it == v.size())
             {
                 result.set("done", true);
                 return result;
             }
 
-            result.set("value", _v[_it++].value);
+            result.set("value", v[_it++].value);
             return result;
         }
 
     private:
-        V&     _v;
-        size_t _it;
+        OTIO_NS::Item* _item;
+        size_t         _it;
     };
 
-    VALUE_TYPE
-    at(int index)
+    explicit JSMutableSequence(OTIO_NS::Item* item)
+        : _item(item)
+    {}
+
+    T* at(int index)
     {
-        V& v = static_cast<V&>(*this);
+        auto& v = journal::elements_of<T>(*_item);
         // adjusted_vector_index allows to support nagative values.
         index = OTIO_NS::adjusted_vector_index(index, v);
         if (index < 0 || index >= int(v.size()))
@@ -104,42 +163,52 @@ struct JSMutableSequence : public V
         return v[index];
     }
 
-    void set_item(int index, VALUE_TYPE value)
+    // Address of the element at index, 0 if there's none.
+    size_t at_address(int index)
+    {
+        auto& v = journal::elements_of<T>(*_item);
+        index   = OTIO_NS::adjusted_vector_index(index, v);
+        if (index < 0 || index >= int(v.size()))
+        {
+            return 0;
+        }
+        return object_address(v[index]);
+    }
+
+    void set_item(int index, T* value)
     {
-        V& v = static_cast<V&>(*this);
+        auto& v = journal::elements_of<T>(*_item);
         // adjusted_vector_index allows to support nagative values.
         index = OTIO_NS::adjusted_vector_index(index, v);
         if (index < 0 || index >= int(v.size()))
         {
             throw IndexError("asd");
         }
-        v[index] = value;
+        journal::set_element(*_item, size_t(index), value);
     }
 
-    void insert(int index, VALUE_TYPE value)
+    void insert(int index, T* value)
     {
-        V& v = static_cast<V&>(*this);
+        auto& v = journal::elements_of<T>(*_item);
         // adjusted_vector_index allows to support nagative values.
         index = OTIO_NS::adjusted_vector_index(index, v);
-        if (size_t(index) >= v.size())
-        {
-            v.emplace_back(std::move(value));
-        }
-        else
-        {
-            v.insert(v.begin() + std::max(index, 0), std::move(value));
-        }
+        journal::insert_element(
+            *_item,
+            size_t(index) >= v.size() ? v.size() : size_t(index),
+            value);
     }
 
-    void push(VALUE_TYPE value)
+    void push(T* value)
     {
-        V& v = static_cast<V&>(*this);
-        v.emplace_back(std::move(value));
+        journal::insert_element(
+            *_item,
+            journal::elements_of<T>(*_item).size(),
+            value);
     }
 
     void del_item(int index)
     {
-        V& v = static_cast<V&>(*this);
+        auto& v = journal::elements_of<T>(*_item);
         if (v.empty())
         {
             throw IndexError("asd");
@@ -147,20 +216,17 @@ struct JSMutableSequence : public V
 
         // adjusted_vector_index allows to support nagative values.
         index = OTIO_NS::adjusted_vector_index(index, v);
-
-        if (size_t(index) >= v.size())
-        {
-            v.pop_back();
-        }
-        else
-        {
-            v.erase(v.begin() + std::max(index, 0));
-        }
+        journal::remove_element<T>(
+            *_item,
+            size_t(index) >= v.size() ? v.size() - 1 : size_t(index));
     }
 
-    int length() const { return static_cast<int>(this->size()); }
+    int length() const
+    {
+        return static_cast<int>(journal::elements_of<T>(*_item).size());
+    }
 
-    Iterator* iter() { return new Iterator(static_cast<V&>(*this)); }
+    Iterator* iter() { return new Iterator(_item); }
 
     static void define_js_class(const char* name, const char* iteratorName)
     {
@@ -171,9 +237,9 @@ struct JSMutableSequence : public V
             .function("next", &This::Iterator::next);
 
         ems::class_<This>(name)
-            .template constructor<>()
             .property("length", &This::length)
             .function("at", &This::at, ems::allow_raw_pointers())
+            .function("_at_address", &This::at_address)
             .function("push", &This::push, ems::allow_raw_pointers())
             // TODO: Support concat
             // TODO: Support entries
@@ -184,6 +250,9 @@ struct JSMutableSequence : public V
             // TODO: Support values
             .function("@@iterator", &This::iter, ems::allow_raw_pointers());
     }
+
+private:
+    OTIO_NS::Item* _item;
 };
 
 /**
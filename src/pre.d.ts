@@ -15,6 +15,34 @@ type Int = number
  */
 export function serializable_field(klass: SerializableObject, name: string, required_type: any): void
 
+// The operators are installed on the prototypes at runtime (see
+// ADD_OPERATOR_DISPATCH in common_utils.h), they aren't bound functions.
+// Operands that aren't of the same type raise a TypeError.
+declare module "../install/opentimelineio" {
+    interface RationalTime {
+        equal(other: RationalTime): boolean
+        notEqual(other: RationalTime): boolean
+        lessThan(other: RationalTime): boolean
+        lessThanOrEqual(other: RationalTime): boolean
+        greaterThan(other: RationalTime): boolean
+        greaterThanOrEqual(other: RationalTime): boolean
+        add(other: RationalTime): RationalTime
+        subtract(other: RationalTime): RationalTime
+        compoundAdd(other: RationalTime): RationalTime
+        compoundSubstract(other: RationalTime): RationalTime
+    }
+
+    interface TimeRange {
+        equal(other: TimeRange): boolean
+        notEqual(other: TimeRange): boolean
+    }
+
+    interface TimeTransform {
+        equal(other: TimeTransform): boolean
+        notEqual(other: TimeTransform): boolean
+    }
+}
+
 export interface SerializeOptions {
     // Schema version to target.
     schema_version_target?: Map<string, Int>,
@@ -29,3 +57,37 @@ export interface SerializeOptions {
  * @param options Serialization options.
  */
 export function serialize_json_to_string(item: RationalTime | TimeRange | TimeTransform, options?: SerializeOptions): string
+
+export interface SinkOptions {
+    // Number of spaces to use as indentation.
+    indent?: Int,
+    // Size in bytes of the chunks given to the sink. Only the last chunk can be smaller.
+    chunk_size?: Int,
+}
+
+/**
+ * Serialize an object to JSON and hand the output to `sink` in fixed-size chunks
+ * while it's being written, instead of building the whole document in memory.
+ *
+ * The serializer is paused while the sink runs, so a sink can apply backpressure
+ * by consuming each chunk synchronously (fs.writeSync, zlib.deflateSync, etc).
+ * Each chunk is a new array owned by the sink. Errors thrown by the sink stop the
+ * serialization and are rethrown. Not available in NODERAWFS builds.
+ *
+ * @param item The object to serialize.
+ * @param sink Called with each chunk of UTF-8 encoded JSON.
+ * @param options Serialization options.
+ * @returns The total number of bytes written.
+ */
+export function serialize_json_to_sink(item: SerializableObject, sink: (chunk: Uint8Array) => void, options?: SinkOptions): Int
+
+/**
+ * Number of times parent(), media_reference(), tracks(), get() or at()
+ * returned a wrapper that already existed instead of creating a new one.
+ */
+export function wrapper_cache_hits(): Int
+
+/**
+ * Number of objects whose wrapper is in the identity cache.
+ */
+export function wrapper_cache_size(): Int
@@ -3,10 +3,143 @@
 
 /* global Module */
 Module.onRuntimeInitialized = function () {
+    // In builds with OTIO_JS_TIME_VALUE_TYPES, RationalTime, TimeRange and
+    // TimeTransform are plain JS objects. Calling (or using new on) the type
+    // creates a frozen value with the same defaults as the C++ constructors,
+    // and the bound _TYPE_NAME functions are exposed as TYPE.NAME. This comes
+    // first since it's the part that applies to the opentime module too.
+    const timeValueTypes = Module.time_representation() === 'value'
+    if (timeValueTypes) {
+        const factories = {
+            RationalTime: (value = 0, rate = 1) => ({ value, rate }),
+            TimeRange: (start_time = Module.RationalTime(), duration = Module.RationalTime(0, start_time.rate)) => ({ start_time, duration }),
+            TimeTransform: (offset = Module.RationalTime(), scale = 1, rate = -1) => ({ offset, scale, rate }),
+        }
+
+        for (const [type, create] of Object.entries(factories)) {
+            const factory = function (...args) {
+                return Object.freeze(create(...args))
+            }
+            Object.defineProperty(factory, 'name', { value: type })
+
+            const prefix = `_${type}_`
+            for (const key of Object.keys(Module)) {
+                if (key.startsWith(prefix)) {
+                    factory[key.slice(prefix.length)] = Module[key]
+                }
+            }
+            Module[type] = factory
+        }
+    }
+
+    function timeValueType(item) {
+        if (!timeValueTypes || typeof item !== 'object' || item === null) {
+            return null
+        }
+        if ('start_time' in item && 'duration' in item) {
+            return 'TimeRange'
+        }
+        if ('offset' in item && 'scale' in item) {
+            return 'TimeTransform'
+        }
+        if ('value' in item && 'rate' in item) {
+            return 'RationalTime'
+        }
+        return null
+    }
+
+    // pre.js is linked into the opentime module as well, which doesn't bind
+    // the serializer.
+    if (typeof Module.filesystem_backend === 'function') {
+        // Character device used by serialize_json_to_sink. The core
+        // serializer writes files through a std::ofstream, so pointing it at
+        // a device gives us the output while it's being produced instead of
+        // building the whole document in the WASM heap first. Devices are not
+        // available when the module is built with NODERAWFS.
+        const SINK_DEVICE_PATH = '/dev/otio-sink'
+        const EIO = 29
+        let activeSink = null
+
+        if (Module.filesystem_backend() !== 'NODERAWFS') {
+            const FS = Module.FS
+            const device = FS.makedev(240, 0)
+            FS.registerDevice(device, {
+                read() {
+                    throw new FS.ErrnoError(EIO)
+                },
+                write(stream, buffer, offset, length) {
+                    const sink = activeSink
+                    if (!sink || sink.error) {
+                        throw new FS.ErrnoError(EIO)
+                    }
+
+                    // buffer is a view of the WASM memory. Copy out of it
+                    // right away, the memory can grow (and be detached) once
+                    // we return.
+                    const bytes = new Uint8Array(buffer.buffer, buffer.byteOffset + offset, length)
+                    try {
+                        let position = 0
+                        while (position < length) {
+                            const count = Math.min(length - position, sink.chunk.length - sink.used)
+                            sink.chunk.set(bytes.subarray(position, position + count), sink.used)
+                            sink.used += count
+                            position += count
+
+                            if (sink.used === sink.chunk.length) {
+                                const chunk = sink.chunk
+                                sink.chunk = new Uint8Array(chunk.length)
+                                sink.used = 0
+                                sink.callback(chunk)
+                            }
+                        }
+                    } catch (err) {
+                        sink.error = err
+                        throw new FS.ErrnoError(EIO)
+                    }
+
+                    sink.written += length
+                    return length
+                }
+            })
+            FS.mkdev(SINK_DEVICE_PATH, device)
+        }
+
+        Module.serialize_json_to_sink = function (item, sink, { indent = 4, chunk_size = 65536 } = {}) {
+            if (!(item instanceof Module.SerializableObject)) {
+                throw new TypeError('serialize_json_to_sink: item must be a SerializableObject')
+            }
+            if (!Number.isInteger(chunk_size) || chunk_size <= 0) {
+                throw new RangeError('serialize_json_to_sink: chunk_size must be a positive integer')
+            }
+            if (Module.filesystem_backend() === 'NODERAWFS') {
+                throw new Error('serialize_json_to_sink is not available in NODERAWFS builds, use to_json_file instead')
+            }
+            if (activeSink) {
+                throw new Error('serialize_json_to_sink can\'t be called from inside a sink')
+            }
+
+            activeSink = { callback: sink, chunk: new Uint8Array(chunk_size), used: 0, written: 0, error: null }
+            try {
+                item.to_json_file(SINK_DEVICE_PATH, indent)
+
+                const state = activeSink
+                if (state.error) {
+                    throw state.error
+                }
+                if (state.used > 0) {
+                    sink(state.chunk.subarray(0, state.used))
+                }
+                return state.written
+            } finally {
+                activeSink = null
+            }
+        }
+    }
+
     Module.serializable_field = function (klass, name, required_type) {
         Object.defineProperty(klass.prototype, name, {
             get() {
-                return this._get_dynamic_fields()[name]
+                return this._get_dynamic_field(name)
             },
             set(value) {
                 // TODO: Test for null and undefined?
@@ -15,26 +148,123 @@ Module.onRuntimeInitialized = function () {
                         throw new Error('TODO: Error message')
                     }
                 }
-                const fields = this._get_dynamic_fields();
-                fields[name] = value;
-
-                this._set_dynamic_fields(fields)
-                // console.log(`${this.constructor.name}.set: Dynamic fields: ${this._get_dynamic_fields()}`)
+                this._set_dynamic_field(name, value)
             }
         })
     }
 
+    // Embind creates a new wrapper every time a bound function returns a
+    // pointer. The accessors below return the live wrapper they returned
+    // before for the same object instead, so walking a tree twice doesn't
+    // create new wrappers and === works. Each accessor has a native twin
+    // (_<name>_address) that only returns the address of the object, which
+    // is looked up before embind is asked for a wrapper. The dynamic type of
+    // the object must also match the one recorded with the wrapper, in case
+    // the address was reused by an object of another type. The wrappers are
+    // held weakly: one that is deleted or collected is replaced by the next
+    // one returned. A cached wrapper counts how many times it was returned,
+    // and delete() only deletes it when it was called as many times, so code
+    // that deletes every wrapper it gets keeps working. Only non-owning
+    // wrappers are cached, the wrappers that own their object (constructors,
+    // from_json_string, ...) are always returned as is. None of these types
+    // are bound in the opentime module.
+    const cachedAccessors = {
+        Composable: ['parent'],
+        Clip: ['media_reference'],
+        Timeline: ['tracks'],
+        SOVector: ['get'],
+        ComposableVector: ['get'],
+        EffectVector: ['get'],
+        MarkerVector: ['get'],
+        EffectVectorProxy: ['at'],
+        MarkerVectorProxy: ['at'],
+    }
+    // Address -> { ref: WeakRef of the wrapper, type: dynamic type }.
+    const wrappers = new Map()
+    const collectedWrappers = new FinalizationRegistry((ptr) => {
+        const entry = wrappers.get(ptr)
+        if (entry && !entry.ref.deref()) {
+            wrappers.delete(ptr)
+        }
+    })
+    const wrapperReturns = new WeakMap()
+    let wrapperCacheHits = 0
+
+    function deleteCachedWrapper() {
+        const returns = wrapperReturns.get(this) - 1
+        wrapperReturns.set(this, returns)
+        if (returns <= 0) {
+            Object.getPrototypeOf(this).delete.call(this)
+        }
+    }
+
+    function cachedWrapper(wrapper) {
+        if (!(wrapper instanceof Module.SerializableObject) || wrapper.$$.smartPtr) {
+            return wrapper
+        }
+
+        const ptr = wrapper.$$.ptr
+        wrapperReturns.set(wrapper, 1)
+        wrapper.delete = deleteCachedWrapper
+        wrappers.set(ptr, { ref: new WeakRef(wrapper), type: Module._dynamic_type(ptr) })
+        collectedWrappers.register(wrapper, ptr)
+        return wrapper
+    }
+
+    for (const [type, methods] of Object.entries(cachedAccessors)) {
+        if (typeof Module[type] !== 'function') {
+            continue
+        }
+        const prototype = Module[type].prototype
+        for (const method of methods) {
+            const accessor = prototype[method]
+            const address = prototype[`_${method}_address`]
+            prototype[method] = function (...args) {
+                const ptr = address.apply(this, args)
+                const entry = ptr ? wrappers.get(ptr) : undefined
+                const cached = entry?.ref.deref()
+                if (cached && !cached.isDeleted() && entry.type === Module._dynamic_type(ptr)) {
+                    wrapperReturns.set(cached, wrapperReturns.get(cached) + 1)
+                    wrapperCacheHits++
+                    return cached
+                }
+                return cachedWrapper(accessor.apply(this, args))
+            }
+        }
+    }
+
+    // The open transaction starts the journal that was recording again when
+    // it closes, so that journal can't be deleted before.
+    if (typeof Module.Journal === 'function') {
+        const deleteJournal = Module.Journal.prototype.delete
+        Module.Journal.prototype.delete = function () {
+            if (!this.isDeleted() && this.is_used_by_transaction()) {
+                throw new Error('Can\'t delete a journal used by the open transaction')
+            }
+            deleteJournal.call(this)
+        }
+    }
+
+    Module.wrapper_cache_hits = function () {
+        return wrapperCacheHits
+    }
+
+    Module.wrapper_cache_size = function () {
+        return wrappers.size
+    }
+
     // TODO: Add to TypeScript definitions.
     Module.serialize_json_to_string = function (item, { schema_version_target = {}, indent = 4 } = {}) {
         let jsitem;
         let func;
-        if (item instanceof Module.RationalTime) {
+        const valueType = timeValueType(item)
+        if (valueType === 'RationalTime' || item instanceof Module.RationalTime) {
             jsitem = new Module.JSAnyRationalTime(item)
             func = Module._serialize_RationalTime_to_string
-        } else if (item instanceof Module.TimeRange) {
+        } else if (valueType === 'TimeRange' || item instanceof Module.TimeRange) {
             jsitem = new Module.JSAnyTimeRange(item)
             func = Module._serialize_TimeRange_to_string
-        } else if (item instanceof Module.TimeTransform) {
+        } else if (valueType === 'TimeTransform' || item instanceof Module.TimeTransform) {
             jsitem = new Module.JSAnyTimeTransform(item)
             func = Module._serialize_TimeTransform_to_string
         } else if (item instanceof Module.SerializableObject) {
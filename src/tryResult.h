@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+#ifndef JS_TRY_RESULT_H
+#define JS_TRY_RESULT_H
+
+#include <emscripten/val.h>
+
+/**
+ * Build the object returned by the try_* bindings: {ok, value, status, details}.
+ * status is the numeric outcome of the error status (0 when ok) and value is
+ * null when the call failed. The try_* bindings never throw, which avoids the
+ * cost of unwinding when failures are expected (validating user input, etc).
+ * @param value Value to return if the call succeeded.
+ * @param error_status opentime or opentimelineio ErrorStatus filled by the call.
+*/
+template <typename STATUS>
+emscripten::val
+try_result(emscripten::val const& value, STATUS const& error_status)
+{
+    bool ok = !is_error(error_status);
+
+    emscripten::val result = emscripten::val::object();
+    result.set("ok", ok);
+    result.set("value", ok ? value : emscripten::val::null());
+    result.set("status", static_cast<int>(error_status.outcome));
+    result.set("details", error_status.details);
+    return result;
+}
+
+#endif // JS_TRY_RESULT_H
@@ -0,0 +1,107 @@
+const opentimelineioFactory = require('../../install/opentimelineio');
+const { expect, test, beforeAll } = require('@jest/globals');
+const fixtures = require('./fixtures');
+
+/**
+ * @type {opentimelineioFactory.CustomEmbindModule}
+ */
+let opentimelineio;
+
+
+beforeAll(async () => {
+    opentimelineio = await opentimelineioFactory();
+});
+
+const { external, gap, load, range, reference, time, timeline, track } = fixtures
+
+function clip(name) {
+    const json = fixtures.clip(name, range(0, 24), external(`file:///${name}.mov`, { 'available_range': range(0, 240) }), {
+        'metadata': { 'shot': { 'name': name, 'takes': [1, 2] } },
+        'effects': [{
+            'OTIO_SCHEMA': 'LinearTimeWarp.1',
+            'name': '',
+            'metadata': {},
+            'effect_name': 'LinearTimeWarp',
+            'time_scalar': 2,
+        }],
+        'markers': [{
+            'OTIO_SCHEMA': 'Marker.2',
+            'name': 'note',
+            'metadata': {},
+            'marked_range': range(2, 1),
+            'color': 'RED',
+        }],
+    })
+    json['media_references']['PROXY'] = reference('MissingReference.1')
+    return json
+}
+
+function makeTimeline() {
+    const video = track('V1', [
+        clip('a'),
+        gap(12),
+        {
+            'OTIO_SCHEMA': 'Transition.1',
+            'name': 'dissolve',
+            'metadata': {},
+            'transition_type': 'SMPTE_Dissolve',
+            'in_offset': time(6),
+            'out_offset': time(6),
+        },
+        clip('b'),
+    ])
+    return load(opentimelineio, timeline([video], {
+        'metadata': { 'project': 'test' },
+        'global_start_time': time(86400),
+    }))
+}
+
+test('test_clone_otio', () => {
+    const timeline = makeTimeline()
+    const copy = timeline.clone_otio()
+
+    expect(copy.is_equivalent_to(timeline)).toBe(true)
+    expect(copy.to_json_string()).toEqual(timeline.to_json_string())
+
+    // The copy doesn't share anything with the original.
+    const clip = copy.tracks().get_children().get(0).get_children().get(0)
+    clip.media_reference().target_url = 'file:///other.mov'
+    expect(copy.is_equivalent_to(timeline)).toBe(false)
+
+    timeline.delete()
+    copy.delete()
+})
+
+test('test_snapshot_store', () => {
+    const timeline = makeTimeline()
+    const store = new opentimelineio.SnapshotStore()
+
+    const first = store.take(timeline)
+    const nodeCount = store.node_count()
+    expect(first.content_hash()).toEqual(timeline.content_hash())
+
+    // Taking the same state again doesn't copy anything.
+    const same = store.take(timeline)
+    expect(store.node_count()).toEqual(nodeCount)
+
+    // Only the path to the modified clip is copied: the clip, its track, the
+    // stack and the timeline.
+    const track = timeline.tracks().get_children().get(0)
+    track.get_children().get(3).name = 'renamed'
+    const second = store.take(timeline)
+    expect(store.node_count()).toEqual(nodeCount + 4)
+
+    const restored = first.restore()
+    expect(restored.content_hash()).toEqual(first.content_hash())
+    expect(restored.tracks().get_children().get(0).get_children().get(3).name).toEqual('b')
+    const current = second.restore()
+    expect(current.is_equivalent_to(timeline)).toBe(true)
+
+    restored.delete()
+    current.delete()
+    first.delete()
+    same.delete()
+    second.delete()
+    store.delete()
+    timeline.delete()
+})
@@ -0,0 +1,116 @@
+const opentimelineioFactory = require('../../install/opentimelineio');
+const { expect, test, beforeAll } = require('@jest/globals');
+const { clip, external, load, range, timeline, track } = require('./fixtures');
+
+/**
+ * @type {opentimelineioFactory.CustomEmbindModule}
+ */
+let opentimelineio;
+
+
+beforeAll(async () => {
+    opentimelineio = await opentimelineioFactory();
+});
+
+function timelineWith(sourceRange) {
+    return timeline([track('V1', [clip('a'), clip('b', sourceRange)])])
+}
+
+function makeTimeline() {
+    const video = track('V1', [
+        clip('a', range(0, 24), external('file:///a.mov')),
+        clip('b', range(0, 24), external('file:///b.mov')),
+    ])
+    const audio = track('A1', [clip('c', range(0, 24), external('file:///c.wav'))], 'Audio')
+    return load(opentimelineio, timeline([video, audio], { 'metadata': { 'project': 'test' } }))
+}
+
+test('test_content_hash', () => {
+    const timeline = makeTimeline()
+    const same = makeTimeline()
+
+    const hash = timeline.content_hash()
+    expect(hash).toMatch(/^[0-9a-f]{16}$/)
+    expect(timeline.content_hash()).toEqual(hash)
+    expect(same.content_hash()).toEqual(hash)
+    expect(timeline.is_equivalent_to(same)).toBe(true)
+
+    const video = same.tracks().get_children().get(0)
+    const audio = same.tracks().get_children().get(1)
+    const audioHash = audio.content_hash()
+
+    video.get_children().get(1).name = 'renamed'
+    expect(same.content_hash()).not.toEqual(hash)
+    expect(timeline.is_equivalent_to(same)).toBe(false)
+    // Only the path to the renamed clip changed.
+    expect(audio.content_hash()).toEqual(audioHash)
+
+    video.get_children().get(1).name = 'b'
+    expect(same.content_hash()).toEqual(hash)
+    expect(timeline.is_equivalent_to(same)).toBe(true)
+
+    timeline.delete()
+    same.delete()
+})
+
+test('test_content_hash_equivalence', () => {
+    // Times are compared once rescaled to the same rate, like in the core.
+    const timeline = load(opentimelineio, timelineWith(range(1, 24)))
+    const rescaled = load(opentimelineio, timelineWith({
+        'OTIO_SCHEMA': 'TimeRange.1',
+        'start_time': { 'OTIO_SCHEMA': 'RationalTime.1', 'rate': 48, 'value': 2 },
+        'duration': { 'OTIO_SCHEMA': 'RationalTime.1', 'rate': 48, 'value': 48 },
+    }))
+    expect(timeline.content_hash()).not.toEqual(rescaled.content_hash())
+    expect(timeline.is_equivalent_to(rescaled)).toBe(true)
+
+    const other = load(opentimelineio, timelineWith(range(2, 24)))
+    expect(timeline.is_equivalent_to(other)).toBe(false)
+
+    timeline.delete()
+    rescaled.delete()
+    other.delete()
+})
+
+test('test_content_hash_modifications', () => {
+    const timeline = makeTimeline()
+    const hash = timeline.content_hash()
+    const video = timeline.tracks().get_children().get(0)
+    const first = video.get_children().get(0)
+
+    // Objects without an owner, like media references.
+    first.media_reference().target_url = 'file:///other.mov'
+    const referenceHash = timeline.content_hash()
+    expect(referenceHash).not.toEqual(hash)
+
+    // Metadata.
+    timeline.set_metadata({ 'project': 'other' })
+    expect(timeline.content_hash()).not.toEqual(referenceHash)
+    timeline.set_metadata({ 'project': 'test' })
+    expect(timeline.content_hash()).toEqual(referenceHash)
+
+    // Children.
+    video.remove_child(1)
+    expect(timeline.content_hash()).not.toEqual(referenceHash)
+
+    timeline.delete()
+})
+
+test('test_content_hash_cache', () => {
+    const timeline = makeTimeline()
+    timeline.content_hash()
+    // The stack, the two tracks and the three clips. Timelines aren't cached
+    // and clips are hashed together with their media references.
+    expect(opentimelineio.content_hash_cache_size()).toEqual(6)
+
+    opentimelineio.clear_content_hash_cache()
+    expect(opentimelineio.content_hash_cache_size()).toEqual(0)
+
+    // Deleting the timeline makes the cache forget its objects.
+    timeline.content_hash()
+    const tracks = timeline.tracks()
+    tracks.delete()
+    expect(opentimelineio.content_hash_cache_size()).toEqual(6)
+    timeline.delete()
+    expect(opentimelineio.content_hash_cache_size()).toEqual(0)
+})
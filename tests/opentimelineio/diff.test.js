@@ -0,0 +1,89 @@
+const opentimelineioFactory = require('../../install/opentimelineio');
+const { expect, test, beforeAll } = require('@jest/globals');
+const fixtures = require('./fixtures');
+
+/**
+ * @type {opentimelineioFactory.CustomEmbindModule}
+ */
+let opentimelineio;
+
+
+beforeAll(async () => {
+    opentimelineio = await opentimelineioFactory();
+});
+
+const { external, load, range, timeline, track } = fixtures
+
+function clip(name, start = 0) {
+    return fixtures.clip(name, range(start, 24), external(`file:///${name}.mov`))
+}
+
+function makeTimeline(children, name = 'timeline') {
+    return load(opentimelineio, timeline([track('V1', children)], { 'name': name }))
+}
+
+function ops(script) {
+    return script.map(op => {
+        const { value, old: oldValue, new: newValue, ...rest } = op
+        if (value === undefined) {
+            return rest
+        }
+        const name = value.name
+        value.delete()
+        return { ...rest, value: name }
+    })
+}
+
+test('test_diff_equal', () => {
+    const a = makeTimeline([clip('a'), clip('b')])
+    const b = makeTimeline([clip('a'), clip('b')])
+    expect(opentimelineio.diff(a, b)).toEqual([])
+    expect(opentimelineio.diff(a, a)).toEqual([])
+    a.delete()
+    b.delete()
+})
+
+test('test_diff_children', () => {
+    const a = makeTimeline([clip('a'), clip('b'), clip('c'), clip('d')])
+    const b = makeTimeline([clip('d'), clip('a'), clip('c'), clip('e', 48)])
+
+    expect(ops(opentimelineio.diff(a, b))).toEqual([
+        { op: 'delete', path: ['tracks', 0], index: 1 },
+        { op: 'move', path: ['tracks', 0], from: 3, to: 0 },
+        { op: 'insert', path: ['tracks', 0], index: 3, value: 'e' },
+    ])
+
+    a.delete()
+    b.delete()
+})
+
+test('test_diff_insert_value', () => {
+    const a = makeTimeline([clip('a')])
+    const b = makeTimeline([clip('a'), clip('b')])
+
+    // The inserted child is retained by its wrapper.
+    const [insert] = opentimelineio.diff(a, b)
+    b.delete()
+    expect(insert.value.name).toEqual('b')
+    insert.value.delete()
+
+    a.delete()
+})
+
+test('test_diff_fields', () => {
+    const a = makeTimeline([clip('a'), clip('b')])
+    const b = makeTimeline([clip('a'), clip('b', 12)], 'renamed')
+
+    const script = opentimelineio.diff(a, b)
+    expect(ops(script)).toEqual([
+        { op: 'change', path: [], field: 'name' },
+        { op: 'change', path: ['tracks', 0, 1], field: 'source_range' },
+    ])
+    expect(script[0].old).toEqual('timeline')
+    expect(script[0].new).toEqual('renamed')
+    expect(script[1].old.start_time.value).toEqual(0)
+    expect(script[1].new.start_time.value).toEqual(12)
+
+    a.delete()
+    b.delete()
+})
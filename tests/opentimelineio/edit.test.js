@@ -0,0 +1,214 @@
+const opentimelineioFactory = require('../../install/opentimelineio');
+const { expect, test, beforeAll } = require('@jest/globals');
+const fixtures = require('./fixtures');
+
+/**
+ * @type {opentimelineioFactory.CustomEmbindModule}
+ */
+let opentimelineio;
+
+
+beforeAll(async () => {
+    opentimelineio = await opentimelineioFactory();
+});
+
+const { children, gap, load, names, range, reference, track } = fixtures
+
+function clip(name, duration = 24, available = null) {
+    return fixtures.clip(name, range(0, duration), reference('MissingReference.1', { 'available_range': available }))
+}
+
+function makeTrack(children) {
+    return load(opentimelineio, track('V1', children))
+}
+
+function makeClip(name, duration) {
+    return load(opentimelineio, clip(name, duration))
+}
+
+function time(value) {
+    return new opentimelineio.RationalTime(value, 24)
+}
+
+function durations(track) {
+    return children(track).map((child) => child.source_range.duration.value)
+}
+
+test('test_slice', () => {
+    const track = makeTrack([clip('a'), clip('b'), clip('c')])
+    const affected = track.slice(time(30))
+    expect(affected.size()).toEqual(2)
+    affected.delete()
+    expect(names(track)).toEqual(['a', 'b', 'b', 'c'])
+    expect(durations(track)).toEqual([24, 6, 18, 24])
+    expect(children(track)[2].source_range.start_time.value).toEqual(6)
+
+    // Slicing at the start of a child does nothing.
+    const none = track.slice(time(24))
+    expect(none.size()).toEqual(0)
+    none.delete()
+    expect(names(track)).toEqual(['a', 'b', 'b', 'c'])
+
+    track.delete()
+})
+
+test('test_insert', () => {
+    const track = makeTrack([clip('a'), clip('b'), clip('c')])
+    track.insert(makeClip('x', 12), time(30)).delete()
+    expect(names(track)).toEqual(['a', 'b', 'x', 'b', 'c'])
+    expect(durations(track)).toEqual([24, 6, 12, 18, 24])
+    expect(track.trimmed_range().duration.value).toEqual(84)
+
+    // Past the end of the track, a gap is inserted first.
+    track.insert(makeClip('y', 12), time(100)).delete()
+    expect(names(track)).toEqual(['a', 'b', 'x', 'b', 'c', '', 'y'])
+    expect(durations(track).slice(5)).toEqual([16, 12])
+
+    track.delete()
+})
+
+test('test_overwrite', () => {
+    const track = makeTrack([clip('a'), clip('b'), clip('c')])
+    track.overwrite(makeClip('x', 12), time(18)).delete()
+    expect(names(track)).toEqual(['a', 'x', 'b', 'c'])
+    expect(durations(track)).toEqual([18, 12, 18, 24])
+    expect(track.trimmed_range().duration.value).toEqual(72)
+
+    // The clips covered by the new one are removed.
+    track.overwrite(makeClip('y', 60), time(0)).delete()
+    expect(names(track)).toEqual(['y', 'c'])
+    expect(durations(track)).toEqual([60, 12])
+
+    track.delete()
+})
+
+test('test_trims', () => {
+    const track = makeTrack([clip('a'), clip('b', 24, range(0, 240)), clip('c')])
+    const [a, b, c] = children(track)
+
+    track.slip(b, time(10)).delete()
+    expect(b.source_range.start_time.value).toEqual(10)
+    // The source range stays within the available range.
+    track.slip(b, time(-100)).delete()
+    expect(b.source_range.start_time.value).toEqual(0)
+
+    track.ripple(b, time(0), time(-12)).delete()
+    expect(durations(track)).toEqual([24, 12, 24])
+    expect(track.trimmed_range().duration.value).toEqual(60)
+
+    track.roll(b, time(6), time(6)).delete()
+    expect(durations(track)).toEqual([30, 12, 18])
+    expect(b.source_range.start_time.value).toEqual(6)
+    expect(c.source_range.start_time.value).toEqual(6)
+    expect(track.trimmed_range().duration.value).toEqual(60)
+
+    track.slide(b, time(-6)).delete()
+    expect(durations(track)).toEqual([24, 12, 18])
+    expect(track.trimmed_range().duration.value).toEqual(54)
+
+    expect(() => { track.slip(makeClip('x', 12), time(1)) }).toThrow()
+    expect(a.name).toEqual('a')
+
+    track.delete()
+})
+
+test('test_fill', () => {
+    const source = makeTrack([clip('a'), gap(24), clip('c')])
+    source.fill(makeClip('x', 48), time(30), opentimelineio.ReferencePoint.source).delete()
+    expect(names(source)).toEqual(['a', '', 'x', 'c'])
+    expect(durations(source)).toEqual([24, 6, 18, 24])
+    source.delete()
+
+    const sequence = makeTrack([clip('a'), gap(24), clip('c')])
+    sequence.fill(makeClip('x', 12), time(30), opentimelineio.ReferencePoint.sequence).delete()
+    expect(names(sequence)).toEqual(['a', 'x', '', 'c'])
+    expect(durations(sequence)).toEqual([24, 12, 12, 24])
+    expect(() => {
+        sequence.fill(makeClip('y', 12), time(0), opentimelineio.ReferencePoint.sequence)
+    }).toThrow()
+    sequence.delete()
+
+    const fit = makeTrack([clip('a'), gap(24), clip('c')])
+    fit.fill(makeClip('x', 48), time(30), opentimelineio.ReferencePoint.fit).delete()
+    expect(names(fit)).toEqual(['a', 'x', 'c'])
+    expect(durations(fit)).toEqual([24, 24, 24])
+    const json = JSON.parse(children(fit)[1].to_json_string())
+    expect(json.effects[0].time_scalar).toEqual(2)
+    fit.delete()
+})
+
+test('test_add_child_item', () => {
+    const track = makeTrack([clip('a'), gap(24), clip('c')])
+    const original = track.to_json_string()
+    const [a] = children(track)
+
+    // A child of a track can't be added again, and the track is left as is.
+    expect(() => { track.overwrite(a, time(30)) }).toThrow()
+    expect(() => { track.insert(a, time(30)) }).toThrow()
+    expect(() => { track.fill(a, time(30), opentimelineio.ReferencePoint.fit) }).toThrow()
+    expect(() => { track.insert(null, time(30)) }).toThrow()
+    expect(track.to_json_string()).toEqual(original)
+    expect(JSON.parse(a.to_json_string()).effects).toEqual([])
+
+    track.delete()
+})
+
+test('test_negative_time', () => {
+    const track = makeTrack([clip('a'), gap(24), clip('c')])
+    const original = track.to_json_string()
+    const x = makeClip('x', 12)
+
+    // Negative times are rejected instead of adding the item at the end.
+    expect(() => { track.overwrite(x, time(-1)) }).toThrow()
+    expect(() => { track.insert(x, time(-1)) }).toThrow()
+    expect(() => { track.fill(x, time(-1), opentimelineio.ReferencePoint.source) }).toThrow()
+    expect(() => { track.slice(time(-1)) }).toThrow()
+    expect(track.to_json_string()).toEqual(original)
+    expect(x.parent()).toBeNull()
+
+    x.delete()
+    track.delete()
+})
+
+test('test_edit_undo', () => {
+    const track = makeTrack([clip('a'), clip('b'), clip('c')])
+    const original = track.to_json_string()
+    const journal = new opentimelineio.Journal()
+    journal.start()
+
+    track.overwrite(makeClip('x', 12), time(18)).delete()
+    track.insert(makeClip('y', 12), time(6)).delete()
+    expect(journal.undo_count()).toEqual(2)
+
+    journal.undo()
+    expect(names(track)).toEqual(['a', 'x', 'b', 'c'])
+    journal.undo()
+    expect(track.to_json_string()).toEqual(original)
+    journal.redo()
+    expect(names(track)).toEqual(['a', 'x', 'b', 'c'])
+
+    journal.delete()
+    track.delete()
+})
+
+test('test_fill_fit_undo', () => {
+    const track = makeTrack([clip('a'), gap(24), clip('c')])
+    const original = track.to_json_string()
+    const x = makeClip('x', 48)
+    const journal = new opentimelineio.Journal()
+    journal.start()
+
+    track.fill(x, time(30), opentimelineio.ReferencePoint.fit).delete()
+    expect(journal.undo_count()).toEqual(1)
+
+    // The time warp is removed along with the rest of the fill.
+    journal.undo()
+    expect(track.to_json_string()).toEqual(original)
+    expect(JSON.parse(x.to_json_string()).effects).toEqual([])
+    journal.redo()
+    expect(JSON.parse(x.to_json_string()).effects[0].time_scalar).toEqual(2)
+
+    journal.delete()
+    x.delete()
+    track.delete()
+})
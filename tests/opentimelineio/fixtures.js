@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Contributors to the OpenTimelineIO project
+
+// Builders for the OTIO JSON documents used by the tests. The builders return
+// plain JSON objects, load() turns one into the OTIO object. Times are at 24
+// fps.
+
+function time(value) {
+    return { 'OTIO_SCHEMA': 'RationalTime.1', 'rate': 24, 'value': value }
+}
+
+function range(start, duration) {
+    return { 'OTIO_SCHEMA': 'TimeRange.1', 'start_time': time(start), 'duration': time(duration) }
+}
+
+function item(schema, name, extra = {}) {
+    return {
+        'OTIO_SCHEMA': schema,
+        'name': name,
+        'metadata': {},
+        'source_range': null,
+        'effects': [],
+        'markers': [],
+        'enabled': true,
+        ...extra,
+    }
+}
+
+function reference(schema, extra = {}) {
+    return {
+        'OTIO_SCHEMA': schema,
+        'name': '',
+        'metadata': {},
+        'available_range': null,
+        'available_image_bounds': null,
+        ...extra,
+    }
+}
+
+function external(url, extra = {}) {
+    return reference('ExternalReference.1', { 'target_url': url, ...extra })
+}
+
+function clip(name, sourceRange = range(0, 24), media = reference('MissingReference.1'), extra = {}) {
+    return item('Clip.2', name, {
+        'source_range': sourceRange,
+        'media_references': { 'DEFAULT_MEDIA': media },
+        'active_media_reference_key': 'DEFAULT_MEDIA',
+        ...extra,
+    })
+}
+
+function gap(duration) {
+    return item('Gap.1', '', { 'source_range': range(0, duration) })
+}
+
+function track(name, children, kind = 'Video') {
+    return item('Track.1', name, { 'kind': kind, 'children': children })
+}
+
+function timeline(tracks, extra = {}) {
+    return {
+        'OTIO_SCHEMA': 'Timeline.1',
+        'name': 'timeline',
+        'metadata': {},
+        'global_start_time': null,
+        'tracks': item('Stack.1', '', { 'children': tracks }),
+        ...extra,
+    }
+}
+
+function load(opentimelineio, json) {
+    return opentimelineio.SerializableObject.from_json_string(JSON.stringify(json))
+}
+
+// Children of a composition, as an array.
+function children(composition) {
+    const vector = composition.get_children()
+    const result = []
+    for (let i = 0; i < vector.size(); i++) {
+        result.push(vector.get(i))
+    }
+    vector.delete()
+    return result
+}
+
+function names(composition) {
+    return children(composition).map((child) => child.name)
+}
+
+module.exports = {
+    time,
+    range,
+    item,
+    reference,
+    external,
+    clip,
+    gap,
+    track,
+    timeline,
+    load,
+    children,
+    names,
+}
@@ -0,0 +1,81 @@
+const opentimelineioFactory = require('../../install/opentimelineio');
+const { expect, test, beforeAll } = require('@jest/globals');
+
+/**
+ * @type {opentimelineioFactory.CustomEmbindModule}
+ */
+let opentimelineio;
+
+
+beforeAll(async () => {
+    opentimelineio = await opentimelineioFactory();
+});
+
+test('test_handle_ownership', () => {
+    const size = opentimelineio.handle_table_size()
+    const clip = new opentimelineio.Clip('a')
+    expect(opentimelineio.handle_table_size()).toEqual(size + 1)
+
+    // The wrapper and the handle both own the slot.
+    const handle = clip.acquire_handle()
+    expect(opentimelineio.handle_count(handle)).toEqual(2)
+    expect(opentimelineio.is_handle_shared(handle)).toBe(false)
+
+    const object = opentimelineio.object_from_handle(handle)
+    expect(object.name).toEqual('a')
+    expect(opentimelineio.handle_count(handle)).toEqual(2)
+    object.delete()
+
+    // The handle keeps the clip alive after its wrapper is deleted.
+    clip.delete()
+    expect(opentimelineio.handle_count(handle)).toEqual(1)
+    expect(opentimelineio.object_from_handle(handle).name).toEqual('a')
+
+    opentimelineio.retain_handle(handle)
+    opentimelineio.release_handle(handle)
+    opentimelineio.release_handle(handle)
+    expect(opentimelineio.handle_count(handle)).toEqual(0)
+    expect(opentimelineio.handle_table_size()).toEqual(size)
+    expect(() => { opentimelineio.object_from_handle(handle) }).toThrow()
+    expect(() => { opentimelineio.release_handle(handle) }).toThrow()
+})
+
+test('test_handle_release_keeps_wrappers', () => {
+    const size = opentimelineio.handle_table_size()
+    const clip = new opentimelineio.Clip('a')
+    const handle = clip.acquire_handle()
+    opentimelineio.release_handle(handle)
+
+    // Releasing more handles than were taken can't release the wrapper.
+    expect(() => { opentimelineio.release_handle(handle) }).toThrow()
+    expect(opentimelineio.handle_count(handle)).toEqual(1)
+    expect(clip.name).toEqual('a')
+
+    clip.delete()
+    expect(opentimelineio.handle_table_size()).toEqual(size)
+})
+
+test('test_handle_shared', () => {
+    const clip = new opentimelineio.Clip('a')
+    const handle = clip.acquire_handle()
+    const sovec = new opentimelineio.SOVector()
+    sovec.push_back(clip)
+    const collection = new opentimelineio.SerializableCollection('test', sovec, {})
+    expect(opentimelineio.is_handle_shared(handle)).toBe(true)
+
+    collection.remove_child(0)
+    expect(opentimelineio.is_handle_shared(handle)).toBe(false)
+
+    // A slot that is reused gets a new handle.
+    opentimelineio.release_handle(handle)
+    clip.delete()
+    const other = new opentimelineio.Clip('b')
+    const otherHandle = other.acquire_handle()
+    expect(otherHandle).not.toEqual(handle)
+    expect(opentimelineio.handle_count(handle)).toEqual(0)
+    opentimelineio.release_handle(otherHandle)
+
+    other.delete()
+    collection.delete()
+    sovec.delete()
+})
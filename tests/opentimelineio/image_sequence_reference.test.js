@@ -0,0 +1,108 @@
+const opentimelineioFactory = require('../../install/opentimelineio');
+const { expect, test, beforeAll } = require('@jest/globals');
+const { TextDecoder } = require('util');
+
+/**
+ * @type {opentimelineioFactory.CustomEmbindModule}
+ */
+let opentimelineio;
+
+
+beforeAll(async () => {
+    opentimelineio = await opentimelineioFactory();
+});
+
+function makeReference() {
+    const range = new opentimelineio.TimeRange(
+        new opentimelineio.RationalTime(0, 24),
+        new opentimelineio.RationalTime(10, 24)
+    )
+    const bounds = new opentimelineio.Box2d()
+    const ref = new opentimelineio.ImageSequenceReference(
+        'file:///shots/sh010',
+        'sh010.',
+        '.exr',
+        1001,
+        1,
+        24,
+        4,
+        opentimelineio.MissingFramePolicy.error,
+        range,
+        {},
+        bounds
+    )
+    range.delete()
+    bounds.delete()
+    return ref
+}
+
+function unpackUrls({ data, offsets }) {
+    const decoder = new TextDecoder()
+    const urls = []
+    for (let i = 0; i + 1 < offsets.length; i++) {
+        urls.push(decoder.decode(data.subarray(offsets[i], offsets[i + 1])))
+    }
+    return urls
+}
+
+test('test_target_urls_for_range', () => {
+    const ref = makeReference()
+
+    const result = ref.target_urls_for_range(0, 10)
+    const urls = unpackUrls(result)
+    expect(urls.length).toEqual(10)
+    for (let i = 0; i < urls.length; i++) {
+        expect(urls[i]).toEqual(ref.target_url_for_image_number(i))
+    }
+    expect(urls[0]).toEqual('file:///shots/sh010/sh010.1001.exr')
+    expect(Array.from(result.missing)).toEqual([])
+    expect(unpackUrls(ref.target_urls_for_range(3, 0))).toEqual([])
+
+    expect(() => ref.target_urls_for_range(8, 4)).toThrow()
+    expect(() => ref.target_urls_for_range(-1, 2)).toThrow()
+
+    ref.missing_frame_policy = opentimelineio.MissingFramePolicy.hold
+    const held = ref.target_urls_for_range(8, 4)
+    expect(unpackUrls(held)).toEqual([
+        'file:///shots/sh010/sh010.1009.exr',
+        'file:///shots/sh010/sh010.1010.exr',
+        'file:///shots/sh010/sh010.1010.exr',
+        'file:///shots/sh010/sh010.1010.exr',
+    ])
+    expect(Array.from(held.missing)).toEqual([10, 11])
+
+    ref.missing_frame_policy = opentimelineio.MissingFramePolicy.black
+    const black = ref.target_urls_for_range(-1, 3)
+    expect(unpackUrls(black)).toEqual([
+        '',
+        'file:///shots/sh010/sh010.1001.exr',
+        'file:///shots/sh010/sh010.1002.exr',
+    ])
+    expect(Array.from(black.missing)).toEqual([-1])
+
+    ref.delete()
+})
+
+test('test_frames_for_times', () => {
+    const ref = makeReference()
+
+    const result = ref.frames_for_times(new Float64Array([0, 5, 9]), 24)
+    expect(Array.from(result.frames)).toEqual([1001, 1006, 1010])
+    expect(Array.from(result.missing)).toEqual([])
+    // Times are rescaled to the rate of the sequence.
+    expect(Array.from(ref.frames_for_times([10], 48).frames)).toEqual([1006])
+
+    expect(() => ref.frames_for_times([0, 12], 24)).toThrow()
+
+    ref.missing_frame_policy = opentimelineio.MissingFramePolicy.hold
+    const held = ref.frames_for_times([-1, 3, 12], 24)
+    expect(Array.from(held.frames)).toEqual([1001, 1004, 1010])
+    expect(Array.from(held.missing)).toEqual([0, 2])
+
+    ref.missing_frame_policy = opentimelineio.MissingFramePolicy.black
+    const black = ref.frames_for_times([-1, 3, 12], 24)
+    expect(Array.from(black.frames)).toEqual([0, 1004, 0])
+    expect(Array.from(black.missing)).toEqual([0, 2])
+
+    ref.delete()
+})
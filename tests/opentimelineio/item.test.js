@@ -26,6 +26,26 @@ test('test_contructors', () => {
     tr.delete()
 })
 
+test('test_try_trimmed_range', () => {
+    const tr = new opentimelineio.TimeRange(new opentimelineio.RationalTime(0, 1), new opentimelineio.RationalTime(10, 1))
+    const item = new opentimelineio.Item('foo', tr)
+    const result = item.try_trimmed_range()
+    expect(result.ok).toBe(true)
+    expect(result.value).toEqual(tr)
+
+    // Without a source range, the available range is needed and Item doesn't implement it.
+    const empty = new opentimelineio.Item('bar')
+    const failure = empty.try_trimmed_range()
+    expect(failure.ok).toBe(false)
+    expect(failure.value).toBeNull()
+    expect(failure.status).not.toEqual(0)
+    expect(() => empty.trimmed_range()).toThrow()
+
+    empty.delete()
+    item.delete()
+    tr.delete()
+})
+
 test('test_copy_arguments', () => {
     const tr = new opentimelineio.TimeRange(new opentimelineio.RationalTime(0, 1), new opentimelineio.RationalTime(10, 1))
 
@@ -51,6 +71,7 @@ test('test_effects', () => {
     console.log(effects)
     console.log(effects.length)
     console.log(effects.at(-1).name)
+    effects.delete()
     item.delete()
     vec.delete()
 })
@@ -0,0 +1,168 @@
+const opentimelineioFactory = require('../../install/opentimelineio');
+const { expect, test, beforeAll } = require('@jest/globals');
+const { clip, load, names, timeline, track } = require('./fixtures');
+
+/**
+ * @type {opentimelineioFactory.CustomEmbindModule}
+ */
+let opentimelineio;
+
+
+beforeAll(async () => {
+    opentimelineio = await opentimelineioFactory();
+});
+
+function makeTimeline() {
+    const json = timeline([track('V1', [clip('a'), clip('b')])], { 'metadata': { 'project': 'test' } })
+    return load(opentimelineio, json)
+}
+
+test('test_journal_properties', () => {
+    const timeline = makeTimeline()
+    const original = timeline.to_json_string()
+    const journal = new opentimelineio.Journal()
+    journal.start()
+
+    const track = timeline.tracks().get_children().get(0)
+    const a = track.get_children().get(0)
+    a.name = 'renamed'
+    a.source_range = new opentimelineio.TimeRange(
+        new opentimelineio.RationalTime(12, 24),
+        new opentimelineio.RationalTime(6, 24))
+    timeline.set_metadata({ 'project': 'other' })
+    expect(journal.undo_count()).toEqual(3)
+    const modified = timeline.to_json_string()
+
+    expect(journal.undo()).toBe(true)
+    expect(timeline.get_metadata()).toEqual({ 'project': 'test' })
+    expect(journal.undo()).toBe(true)
+    expect(a.source_range.start_time.value).toEqual(0)
+    expect(journal.undo()).toBe(true)
+    expect(journal.undo()).toBe(false)
+    expect(timeline.to_json_string()).toEqual(original)
+
+    while (journal.redo()) { }
+    expect(journal.redo_count()).toEqual(0)
+    expect(timeline.to_json_string()).toEqual(modified)
+
+    // Recording after an undo drops the steps that could be redone.
+    journal.undo()
+    a.enabled = false
+    expect(journal.can_redo()).toBe(false)
+
+    journal.stop()
+    a.name = 'not recorded'
+    expect(journal.undo_count()).toEqual(3)
+
+    journal.delete()
+    timeline.delete()
+})
+
+test('test_journal_children', () => {
+    const timeline = makeTimeline()
+    const journal = new opentimelineio.Journal()
+    journal.start()
+
+    const track = timeline.tracks().get_children().get(0)
+    track.remove_child(0)
+    track.append_child(new opentimelineio.Clip('c'))
+    track.insert_child(0, new opentimelineio.Clip('d'))
+    expect(names(track)).toEqual(['d', 'b', 'c'])
+
+    journal.undo()
+    expect(names(track)).toEqual(['b', 'c'])
+    journal.undo()
+    journal.undo()
+    // The removed clip is retained by the journal.
+    expect(names(track)).toEqual(['a', 'b'])
+    journal.redo()
+    journal.redo()
+    journal.redo()
+    expect(names(track)).toEqual(['d', 'b', 'c'])
+
+    journal.delete()
+    timeline.delete()
+})
+
+test('test_journal_effects_markers', () => {
+    const timeline = makeTimeline()
+    const original = timeline.to_json_string()
+    const journal = new opentimelineio.Journal()
+    journal.start()
+
+    const a = timeline.tracks().get_children().get(0).get_children().get(0)
+    const effects = a.get_effects()
+    const markers = a.get_markers()
+    const hash = a.content_hash()
+    effects.push(new opentimelineio.Effect('blur'))
+    markers.push(new opentimelineio.Marker('note'))
+    expect(journal.undo_count()).toEqual(2)
+    // The item is touched, so its cached hash is computed again.
+    expect(a.content_hash()).not.toEqual(hash)
+
+    journal.undo()
+    expect(markers.length).toEqual(0)
+    journal.undo()
+    expect(effects.length).toEqual(0)
+    expect(timeline.to_json_string()).toEqual(original)
+    expect(a.content_hash()).toEqual(hash)
+
+    journal.redo()
+    journal.redo()
+    expect(effects.at(0).name).toEqual('blur')
+    expect(markers.at(0).name).toEqual('note')
+
+    effects.delete()
+    markers.delete()
+    journal.delete()
+    timeline.delete()
+})
+
+test('test_journal_group', () => {
+    const timeline = makeTimeline()
+    const original = timeline.to_json_string()
+    const journal = new opentimelineio.Journal()
+    journal.start()
+
+    const track = timeline.tracks().get_children().get(0)
+    journal.begin_group()
+    track.get_children().get(1).name = 'b2'
+    track.remove_child(0)
+    track.kind = 'Audio'
+    journal.end_group()
+    expect(journal.undo_count()).toEqual(1)
+
+    journal.undo()
+    expect(timeline.to_json_string()).toEqual(original)
+    expect(() => { journal.end_group() }).toThrow()
+
+    journal.delete()
+    timeline.delete()
+})
+
+test('test_journal_capacity', () => {
+    const timeline = makeTimeline()
+    const journal = new opentimelineio.Journal(4096)
+    journal.start()
+
+    const a = timeline.tracks().get_children().get(0).get_children().get(0)
+    for (let i = 0; i < 1000; i++) {
+        a.name = `name ${i}`
+    }
+    expect(journal.memory_usage()).toBeLessThanOrEqual(4096)
+    expect(journal.undo_count()).toBeGreaterThan(0)
+    expect(journal.undo_count()).toBeLessThan(1000)
+
+    // The last step is kept even if it's larger than the capacity.
+    journal.capacity = 0
+    expect(journal.undo_count()).toEqual(1)
+    journal.undo()
+    expect(a.name).toEqual('name 998')
+
+    journal.clear()
+    expect(journal.memory_usage()).toEqual(0)
+    expect(journal.can_undo()).toBe(false)
+
+    journal.delete()
+    timeline.delete()
+})
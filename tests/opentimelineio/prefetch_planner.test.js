@@ -0,0 +1,147 @@
+const opentimelineioFactory = require('../../install/opentimelineio');
+const { expect, test, beforeAll } = require('@jest/globals');
+const { clip, external, load, range, reference, timeline, track } = require('./fixtures');
+
+/**
+ * @type {opentimelineioFactory.CustomEmbindModule}
+ */
+let opentimelineio;
+
+
+beforeAll(async () => {
+    opentimelineio = await opentimelineioFactory();
+});
+
+function movie(url) {
+    return external(url, { 'available_range': range(0, 240) })
+}
+
+function imageSequence() {
+    return reference('ImageSequenceReference.1', {
+        'available_range': range(0, 48),
+        'target_url_base': 'file:///shots/sh010/',
+        'name_prefix': 'sh010.',
+        'name_suffix': '.exr',
+        'start_frame': 1,
+        'frame_step': 1,
+        'rate': 24,
+        'frame_zero_padding': 4,
+        'missing_frame_policy': 'error',
+    })
+}
+
+function generator() {
+    return reference('GeneratorReference.1', {
+        'available_range': range(0, 240),
+        'generator_kind': 'SMPTEBars',
+        'parameters': {},
+    })
+}
+
+// A track with four one second clips: a movie, an image sequence, color bars
+// and the same movie again.
+function makeTimeline() {
+    return load(opentimelineio, timeline([track('', [
+        clip('a', range(0, 24), movie('file:///a.mov')),
+        clip('b', range(10, 24), imageSequence()),
+        clip('c', range(0, 24), generator()),
+        clip('d', range(48, 24), movie('file:///a.mov')),
+    ])]))
+}
+
+function plan(planner, playhead, speed, lookAhead) {
+    const playheadTime = new opentimelineio.RationalTime(playhead, 24)
+    const lookAheadTime = new opentimelineio.RationalTime(lookAhead, 24)
+    const requests = planner.plan(playheadTime, speed, lookAheadTime)
+    playheadTime.delete()
+    lookAheadTime.delete()
+    for (const request of requests) {
+        request.clip_name = request.clip.name
+        request.reference.delete()
+        request.clip.delete()
+    }
+    return requests
+}
+
+function summarize(requests) {
+    return requests.map(request => {
+        if (request.kind === 'image_sequence') {
+            return Array.from(request.frames)
+        }
+        return request.kind === 'external' ? request.url : request.generator_kind
+    })
+}
+
+test('test_plan', () => {
+    const timeline = makeTimeline()
+    const planner = new opentimelineio.PrefetchPlanner(timeline)
+    expect(planner.clip_count()).toEqual(4)
+
+    const requests = plan(planner, 0, 1, 36)
+    expect(requests.map(request => request.kind)).toEqual(['external', 'image_sequence'])
+    expect(summarize(requests)).toEqual([
+        'file:///a.mov',
+        [11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22],
+    ])
+    expect(requests.map(request => request.clip_name)).toEqual(['a', 'b'])
+    expect(requests[0].delay).toBeCloseTo(0)
+    expect(requests[1].delay).toBeCloseTo(1)
+    expect(requests[1].source_range.start_time.value).toBeCloseTo(10)
+    expect(requests[1].source_range.duration.value).toBeCloseTo(12)
+
+    // Only what wasn't returned yet.
+    expect(summarize(plan(planner, 12, 1, 36))).toEqual([
+        [23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34],
+    ])
+    // The second use of a.mov was already requested.
+    expect(summarize(plan(planner, 40, 1, 36))).toEqual(['SMPTEBars'])
+
+    // Seeking starts over.
+    expect(summarize(plan(planner, 0, 1, 36))).toEqual([
+        'file:///a.mov',
+        [11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22],
+    ])
+
+    planner.delete()
+    timeline.delete()
+})
+
+test('test_plan_speed', () => {
+    const timeline = makeTimeline()
+    const planner = new opentimelineio.PrefetchPlanner(timeline)
+
+    // Backwards, from the last frame of the image sequence.
+    expect(summarize(plan(planner, 47, -1, 12))).toEqual([
+        [34, 33, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23],
+    ])
+
+    // Twice as fast covers twice as much of the timeline, in the same time.
+    planner.reset()
+    const requests = plan(planner, 0, 2, 24)
+    expect(summarize(requests)).toEqual([
+        'file:///a.mov',
+        [11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34],
+    ])
+    expect(requests[1].delay).toBeCloseTo(0.5)
+
+    planner.delete()
+    timeline.delete()
+})
+
+test('test_plan_retains', () => {
+    const timeline = makeTimeline()
+    const planner = new opentimelineio.PrefetchPlanner(timeline)
+    const playhead = new opentimelineio.RationalTime(0, 24)
+    const lookAhead = new opentimelineio.RationalTime(12, 24)
+    const [request] = planner.plan(playhead, 1, lookAhead)
+    playhead.delete()
+    lookAhead.delete()
+    planner.delete()
+    timeline.delete()
+
+    // The clip and its reference outlive the timeline until they're deleted.
+    expect(request.clip.name).toEqual('a')
+    expect(request.reference.target_url).toEqual('file:///a.mov')
+    request.clip.delete()
+    request.reference.delete()
+})
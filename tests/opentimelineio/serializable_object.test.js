@@ -1,5 +1,6 @@
 const opentimelineioFactory = require('../../install/opentimelineio');
 const { expect, test, beforeAll } = require('@jest/globals');
+const { TextDecoder, TextEncoder } = require('util');
 
 /**
  * @type {opentimelineioFactory.CustomEmbindModule}
@@ -34,6 +35,82 @@ test('test_serialize_object', () => {
     so.delete()
 })
 
+test('test_serialize_to_bytes', () => {
+    const so = new opentimelineio.SerializableObjectWithMetadata('name', { 'foo': 'bar' })
+    const expected = so.to_json_string(4)
+
+    const buffer = so.to_json_bytes()
+    expect(buffer.size).toEqual(new TextEncoder().encode(expected).length)
+    expect(new TextDecoder().decode(buffer.view())).toEqual(expected)
+
+    const copy = buffer.copy()
+    buffer.release()
+    expect(buffer.released).toBe(true)
+    expect(buffer.size).toEqual(0)
+    // The copy doesn't point into the WASM memory, so it survives the release.
+    expect(new TextDecoder().decode(copy)).toEqual(expected)
+    expect(() => buffer.view()).toThrow()
+    buffer.delete()
+
+    const indented = so.to_json_bytes(0)
+    expect(new TextDecoder().decode(indented.view())).toEqual(so.to_json_string(0))
+    indented.delete()
+    so.delete()
+})
+
+test('test_serialize_to_sink', () => {
+    const so = new opentimelineio.SerializableObjectWithMetadata('name', { 'foo': 'bar'.repeat(100) })
+    const expected = new TextEncoder().encode(so.to_json_string(4))
+
+    const chunks = []
+    const written = opentimelineio.serialize_json_to_sink(so, (chunk) => chunks.push(chunk), { chunk_size: 64 })
+    expect(written).toEqual(expected.length)
+    expect(chunks.length).toEqual(Math.ceil(expected.length / 64))
+    chunks.slice(0, -1).forEach((chunk) => expect(chunk.length).toEqual(64))
+
+    const output = new Uint8Array(written)
+    let offset = 0
+    for (const chunk of chunks) {
+        output.set(chunk, offset)
+        offset += chunk.length
+    }
+    expect(output).toEqual(expected)
+
+    // Errors raised by the sink stop the serialization and are given back to the caller.
+    expect(() => opentimelineio.serialize_json_to_sink(so, () => {
+        throw new Error('sink is full')
+    }, { chunk_size: 64 })).toThrow('sink is full')
+
+    expect(() => opentimelineio.serialize_json_to_sink(so, () => {}, { chunk_size: 0 })).toThrow(RangeError)
+    so.delete()
+})
+
+test('test_binary_round_trip', () => {
+    const mr = new opentimelineio.ExternalReference('/var/tmp/test.mov')
+    const clip = new opentimelineio.Clip(
+        'clip',
+        mr,
+        new opentimelineio.TimeRange(new opentimelineio.RationalTime(1, 24), new opentimelineio.RationalTime(48, 24)),
+        { 'int': 1, 'string': 'value', 'nested': { 'list': [1, 'two', null] } }
+    )
+
+    const binary = clip.to_binary()
+    const bytes = binary.copy()
+    binary.delete()
+    expect(Array.from(bytes.subarray(0, 4))).toEqual([79, 84, 73, 66]) // OTIB
+
+    const decoded = opentimelineio.SerializableObject.from_binary(bytes)
+    expect(decoded.is_equivalent_to(clip)).toBe(true)
+    expect(decoded.to_json_string(4)).toEqual(clip.to_json_string(4))
+
+    expect(() => opentimelineio.SerializableObject.from_binary(new Uint8Array([1, 2, 3]))).toThrow()
+    expect(() => opentimelineio.SerializableObject.from_binary(bytes.subarray(0, bytes.length - 1))).toThrow()
+
+    decoded.delete()
+    clip.delete()
+    mr.delete()
+})
+
 // This can look weird, but serialization and deserialization is part of
 // opentimelineio, not opentime.
 test('test_serialize_time', () => {
@@ -80,6 +157,20 @@ test('test_serialize', () => {
     })
 })
 
+test('test_try_from_json_string', () => {
+    const result = opentimelineio.SerializableObject.try_from_json_string('{"OTIO_SCHEMA": "SerializableObject.1"}')
+    expect(result.ok).toBe(true)
+    expect(result.status).toEqual(0)
+    expect(result.value).toBeInstanceOf(opentimelineio.SerializableObject)
+    result.value.delete()
+
+    const invalid = opentimelineio.SerializableObject.try_from_json_string('aasd')
+    expect(invalid.ok).toBe(false)
+    expect(invalid.value).toBeNull()
+    expect(invalid.status).not.toEqual(0)
+    expect(invalid.details).toEqual('JSON parse error on input string: Invalid value. (line 1, column 0)')
+})
+
 // TODO: Add more metadata (cover all possible types)
 test('test_metadata', () => {
     const so = new opentimelineio.SerializableObjectWithMetadata()
@@ -115,7 +206,14 @@ test('test_subclass', () => {
     let instance1 = new MyFoo1();
     instance1.invoke();
 
+    expect(instance1.myprop1).toBeUndefined()
     instance1.myprop1 = '1234'
+    expect(instance1.myprop1).toEqual('1234')
+    instance1.myprop2 = 5
+    instance1.myprop2 = 6
+    expect(instance1.myprop2).toEqual(6)
+    expect(instance1._get_dynamic_fields()).toEqual({ 'myprop1': '1234', 'myprop2': 6 })
+    instance1._set_dynamic_fields({ 'myprop1': '1234' })
 
     expect(instance1.to_json_string(4)).toEqual(`{
     "OTIO_SCHEMA": "MyFoo1.1",
@@ -175,7 +273,7 @@ test('test_constructors', () => {
     soMetadata3.delete()
 })
 
-test.skip('test_copy_lib', () => {
+test('test_copy_lib', () => {
     const so = new opentimelineio.SerializableObjectWithMetadata('', { 'foo': 'bar' })
 
     const so_copy = so.clone_otio()
@@ -0,0 +1,102 @@
+const opentimelineioFactory = require('../../install/opentimelineio');
+const { expect, test, beforeAll } = require('@jest/globals');
+
+/**
+ * @type {opentimelineioFactory.CustomEmbindModule}
+ */
+let opentimelineio;
+
+
+beforeAll(async () => {
+    opentimelineio = await opentimelineioFactory();
+});
+
+function makeItem(name, start, duration) {
+    const range = new opentimelineio.TimeRange(
+        new opentimelineio.RationalTime(start, 24),
+        new opentimelineio.RationalTime(duration, 24)
+    )
+    const item = new opentimelineio.Item(name, range)
+    range.delete()
+    return item
+}
+
+function expectCloseTo(actual, expected) {
+    expect(actual.length).toEqual(expected.length)
+    expected.forEach((value, i) => expect(actual[i]).toBeCloseTo(value, 9))
+}
+
+test('test_map_through_parent', () => {
+    const track = new opentimelineio.Track()
+    const first = makeItem('first', 0, 24)
+    const second = makeItem('second', 100, 48)
+    track.append_child(first)
+    track.append_child(second)
+
+    const mapper = new opentimelineio.TimeMapper(second)
+    expect(mapper.scale).toEqual(1)
+    expectCloseTo(mapper.map([24, 30, 48], 24), [100, 106, 124])
+    expectCloseTo(mapper.map([24, 30], 24, 48), [200, 212])
+
+    // The mapping is cached until update() is called.
+    second.get_effects().push(new opentimelineio.LinearTimeWarp('speed', 2))
+    expectCloseTo(mapper.map([30], 24), [106])
+    mapper.update()
+    expect(mapper.scale).toEqual(2)
+    expectCloseTo(mapper.map([24, 30, 48], 24), [100, 112, 148])
+
+    const values = new Float64Array([24, 30, 48])
+    const result = mapper.map_into(values, 24, 24, values)
+    expect(result).toBe(values)
+    expectCloseTo(values, [100, 112, 148])
+    expect(() => mapper.map_into([1, 2], 24, 24, new Float64Array(1))).toThrow()
+
+    // FreezeFrame holds the first frame of the item.
+    second.get_effects().push(new opentimelineio.FreezeFrame())
+    mapper.update()
+    expect(mapper.scale).toEqual(0)
+    expectCloseTo(mapper.map([24, 30, 48], 24), [100, 100, 100])
+
+    mapper.delete()
+    first.delete()
+    second.delete()
+    track.delete()
+})
+
+test('test_map_through_nested_effects', () => {
+    const stack = new opentimelineio.Stack()
+    const track = new opentimelineio.Track()
+    const first = makeItem('first', 0, 24)
+    const second = makeItem('second', 100, 48)
+    track.append_child(first)
+    track.append_child(second)
+    track.get_effects().push(new opentimelineio.LinearTimeWarp('slow', 0.5))
+    second.get_effects().push(new opentimelineio.LinearTimeWarp('speed', 2))
+    stack.append_child(track)
+
+    // Stack time 60 is track time 30 because of the slow down, which is
+    // frame 6 of the second item, played twice as fast.
+    const mapper = new opentimelineio.TimeMapper(second, stack)
+    expectCloseTo(mapper.map([48, 60], 24), [100, 112])
+
+    const other = new opentimelineio.Stack()
+    expect(() => new opentimelineio.TimeMapper(second, other)).toThrow()
+
+    mapper.delete()
+    other.delete()
+    first.delete()
+    second.delete()
+    track.delete()
+    stack.delete()
+})
+
+test('test_map_without_parent', () => {
+    const item = makeItem('item', 10, 10)
+    item.get_effects().push(new opentimelineio.LinearTimeWarp('speed', 2))
+
+    const mapper = new opentimelineio.TimeMapper(item)
+    expectCloseTo(mapper.map([10, 12], 24), [10, 14])
+
+    mapper.delete()
+    item.delete()
+})
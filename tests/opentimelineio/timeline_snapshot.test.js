@@ -0,0 +1,88 @@
+const opentimelineioFactory = require('../../install/opentimelineio');
+const { expect, test, beforeAll } = require('@jest/globals');
+const { clip, external, gap, load, range, reference, timeline, track } = require('./fixtures');
+
+/**
+ * @type {opentimelineioFactory.CustomEmbindModule}
+ */
+let opentimelineio;
+
+
+beforeAll(async () => {
+    opentimelineio = await opentimelineioFactory();
+});
+
+function makeTimeline() {
+    const video = track('V1', [
+        clip('a', range(0, 24), external('file:///a.mov')),
+        gap(12),
+        clip('b', range(0, 24), reference('MissingReference.1')),
+    ])
+    const audio = track('A1', [clip('c', range(0, 48), external('file:///c.wav'))], 'Audio')
+    return load(opentimelineio, timeline([video, audio]))
+}
+
+function rows(snapshot) {
+    return Array.from(snapshot.track).map((track, i) => [track, snapshot.index[i]])
+}
+
+function strings(snapshot, column) {
+    return Array.from(snapshot[column]).map(index => index < 0 ? null : snapshot.strings[index])
+}
+
+test('test_snapshot_columns', () => {
+    const timeline = makeTimeline()
+    const snapshot = timeline.snapshot_columns()
+
+    expect(snapshot.full).toBe(true)
+    expect(Array.from(snapshot.track_lengths)).toEqual([3, 1])
+    expect(rows(snapshot)).toEqual([[0, 0], [0, 1], [0, 2], [1, 0]])
+    expect(Array.from(snapshot.start)).toEqual([0, 24, 36, 0])
+    expect(Array.from(snapshot.duration)).toEqual([24, 12, 24, 48])
+    expect(Array.from(snapshot.rate)).toEqual([24, 24, 24, 24])
+    expect(strings(snapshot, 'schema')).toEqual(['Clip', 'Gap', 'Clip', 'Clip'])
+    expect(strings(snapshot, 'name')).toEqual(['a', '', 'b', 'c'])
+    expect(strings(snapshot, 'reference')).toEqual(['ExternalReference', null, 'MissingReference', 'ExternalReference'])
+
+    const visibleClip = opentimelineio.SNAPSHOT_ENABLED | opentimelineio.SNAPSHOT_VISIBLE
+    expect(Array.from(snapshot.flags)).toEqual([visibleClip, opentimelineio.SNAPSHOT_ENABLED, visibleClip, visibleClip])
+
+    timeline.delete()
+})
+
+test('test_snapshot_columns_since', () => {
+    const timeline = makeTimeline()
+    const stack = timeline.tracks()
+    const video = stack.get_children().get(0)
+    const audio = stack.get_children().get(1)
+
+    let generation = timeline.snapshot_columns().generation
+    let changes = timeline.snapshot_columns_since(generation)
+    expect(changes.full).toBe(false)
+    expect(rows(changes)).toEqual([])
+    expect(Array.from(changes.track_lengths)).toEqual([3, 1])
+
+    // Renaming only changes that row and the ones after it in the track.
+    video.get_children().get(2).name = 'renamed'
+    changes = timeline.snapshot_columns_since(generation)
+    expect(rows(changes)).toEqual([[0, 2]])
+    expect(strings(changes, 'name')).toEqual(['renamed'])
+
+    // A new duration moves the following children.
+    generation = changes.generation
+    const longer = new opentimelineio.TimeRange(new opentimelineio.RationalTime(0, 24), new opentimelineio.RationalTime(48, 24))
+    video.get_children().get(0).source_range = longer
+    longer.delete()
+    changes = timeline.snapshot_columns_since(generation)
+    expect(rows(changes)).toEqual([[0, 0], [0, 1], [0, 2]])
+    expect(Array.from(changes.start)).toEqual([0, 48, 60])
+
+    // Removed children are reported through track_lengths.
+    generation = changes.generation
+    audio.remove_child(0)
+    changes = timeline.snapshot_columns_since(generation)
+    expect(rows(changes)).toEqual([])
+    expect(Array.from(changes.track_lengths)).toEqual([3, 0])
+
+    timeline.delete()
+})
@@ -0,0 +1,133 @@
+const opentimelineioFactory = require('../../install/opentimelineio');
+const { expect, test, beforeAll } = require('@jest/globals');
+const { clip, load, names, timeline, track } = require('./fixtures');
+
+/**
+ * @type {opentimelineioFactory.CustomEmbindModule}
+ */
+let opentimelineio;
+
+
+beforeAll(async () => {
+    opentimelineio = await opentimelineioFactory();
+});
+
+function makeTimeline() {
+    const json = timeline([track('V1', [clip('a'), clip('b')])], { 'metadata': { 'project': 'test' } })
+    return load(opentimelineio, json)
+}
+
+test('test_transaction_commit', () => {
+    const timeline = makeTimeline()
+    const track = timeline.tracks().get_children().get(0)
+    const hash = timeline.content_hash()
+
+    timeline.begin_transaction()
+    expect(timeline.in_transaction()).toBe(true)
+    for (let i = 0; i < 10; i++) {
+        track.append_child(new opentimelineio.Clip(`c${i}`))
+    }
+    track.get_children().get(0).name = 'renamed'
+    // Caches see the modifications made during the transaction.
+    expect(timeline.content_hash()).not.toEqual(hash)
+    const modified = timeline.commit()
+
+    // The track and the renamed clip, once each.
+    expect(modified.size()).toEqual(2)
+    expect(timeline.in_transaction()).toBe(false)
+    expect(names(track)).toEqual(['renamed', 'b', 'c0', 'c1', 'c2', 'c3', 'c4', 'c5', 'c6', 'c7', 'c8', 'c9'])
+
+    modified.delete()
+    timeline.delete()
+})
+
+test('test_transaction_rollback', () => {
+    const timeline = makeTimeline()
+    const original = timeline.to_json_string()
+    const track = timeline.tracks().get_children().get(0)
+
+    timeline.begin_transaction()
+    track.remove_child(0)
+    track.append_child(new opentimelineio.Clip('c'))
+    track.get_children().get(0).source_range = new opentimelineio.TimeRange(
+        new opentimelineio.RationalTime(1, 24),
+        new opentimelineio.RationalTime(2, 24))
+    timeline.set_metadata({ 'project': 'other' })
+    timeline.rollback()
+
+    expect(timeline.in_transaction()).toBe(false)
+    expect(timeline.to_json_string()).toEqual(original)
+
+    timeline.delete()
+})
+
+test('test_transaction_nested', () => {
+    const timeline = makeTimeline()
+    const other = makeTimeline()
+    const track = timeline.tracks().get_children().get(0)
+
+    timeline.begin_transaction()
+    expect(() => { other.begin_transaction() }).toThrow()
+    timeline.begin_transaction()
+    track.kind = 'Audio'
+    expect(timeline.commit().size()).toEqual(0)
+    expect(timeline.in_transaction()).toBe(true)
+    expect(timeline.commit().size()).toEqual(1)
+    expect(() => { timeline.commit() }).toThrow()
+
+    other.delete()
+    timeline.delete()
+})
+
+test('test_transaction_journal', () => {
+    const timeline = makeTimeline()
+    const original = timeline.to_json_string()
+    const track = timeline.tracks().get_children().get(0)
+    const journal = new opentimelineio.Journal()
+    journal.start()
+
+    timeline.begin_transaction()
+    track.remove_child(1)
+    track.remove_child(0)
+    track.name = 'empty'
+    timeline.commit()
+
+    // The transaction is a single step of the journal.
+    expect(journal.is_recording()).toBe(true)
+    expect(journal.undo_count()).toEqual(1)
+    journal.undo()
+    expect(timeline.to_json_string()).toEqual(original)
+
+    journal.delete()
+    timeline.delete()
+})
+
+test('test_transaction_journal_in_use', () => {
+    const timeline = makeTimeline()
+    const track = timeline.tracks().get_children().get(0)
+    const journal = new opentimelineio.Journal()
+    const other = new opentimelineio.Journal()
+    journal.start()
+
+    timeline.begin_transaction()
+    expect(journal.is_used_by_transaction()).toBe(true)
+    expect(other.is_used_by_transaction()).toBe(false)
+    // Another journal can't take over the recording, and the journal that is
+    // started again at commit can't be deleted.
+    expect(() => { other.start() }).toThrow()
+    expect(() => { journal.start() }).toThrow()
+    expect(() => { journal.delete() }).toThrow()
+    expect(journal.isDeleted()).toBe(false)
+    track.name = 'renamed'
+    timeline.commit()
+
+    expect(journal.is_used_by_transaction()).toBe(false)
+    expect(journal.is_recording()).toBe(true)
+    expect(journal.undo_count()).toEqual(1)
+    other.start()
+    expect(journal.is_recording()).toBe(false)
+
+    other.delete()
+    journal.delete()
+    timeline.delete()
+})
@@ -0,0 +1,92 @@
+const opentimelineioFactory = require('../../install/opentimelineio');
+const { expect, test, beforeAll } = require('@jest/globals');
+
+/**
+ * @type {opentimelineioFactory.CustomEmbindModule}
+ */
+let opentimelineio;
+
+
+beforeAll(async () => {
+    opentimelineio = await opentimelineioFactory();
+});
+
+function makeRange(start, duration) {
+    return new opentimelineio.TimeRange(
+        new opentimelineio.RationalTime(start, 24),
+        new opentimelineio.RationalTime(duration, 24)
+    )
+}
+
+function makeItem(name, start, duration) {
+    const range = makeRange(start, duration)
+    const item = new opentimelineio.Item(name, range)
+    range.delete()
+    return item
+}
+
+test('test_transformed_time_many', () => {
+    const stack = new opentimelineio.Stack()
+    const track = new opentimelineio.Track()
+    const first = makeItem('first', 0, 24)
+    const second = makeItem('second', 100, 48)
+    track.append_child(first)
+    track.append_child(second)
+    stack.append_child(track)
+
+    expect(Array.from(opentimelineio.transformed_time_many(second, track, [100, 110], 24))).toEqual([24, 34])
+    expect(Array.from(opentimelineio.transformed_time_many(track, second, [24, 34], 24))).toEqual([100, 110])
+    expect(Array.from(opentimelineio.transformed_time_many(second, stack, [100, 110], 24))).toEqual([24, 34])
+    expect(Array.from(opentimelineio.transformed_time_many(second, first, [100], 24))).toEqual([24])
+    // Results are in the larger of the rate of the input and the one of the items.
+    expect(Array.from(opentimelineio.transformed_time_many(second, track, [200], 48))).toEqual([48])
+
+    const output = new Float64Array(2)
+    expect(opentimelineio.transformed_time_many(second, track, [100, 110], 24, output)).toBe(output)
+    expect(Array.from(output)).toEqual([24, 34])
+
+    expect(opentimelineio.transformed_time_cache_size()).toEqual(4)
+
+    const other = makeItem('other', 0, 10)
+    expect(() => opentimelineio.transformed_time_many(second, other, [0], 24)).toThrow()
+    other.delete()
+
+    first.delete()
+    second.delete()
+    track.delete()
+    expect(opentimelineio.transformed_time_cache_size()).toEqual(4)
+    // Releasing the root releases the entries that retain its tree.
+    stack.delete()
+    expect(opentimelineio.transformed_time_cache_size()).toEqual(0)
+})
+
+test('test_transformed_time_invalidation', () => {
+    const track = new opentimelineio.Track()
+    const first = makeItem('first', 0, 24)
+    const second = makeItem('second', 100, 48)
+    track.append_child(first)
+    track.append_child(second)
+
+    expect(Array.from(opentimelineio.transformed_time_many(second, track, [100], 24))).toEqual([24])
+
+    // Changing the duration of a sibling moves the item in its parent.
+    const longer = makeRange(0, 48)
+    first.source_range = longer
+    longer.delete()
+    expect(Array.from(opentimelineio.transformed_time_many(second, track, [100], 24))).toEqual([48])
+
+    // Changing the range of the item itself.
+    const trimmed = makeRange(90, 48)
+    second.source_range = trimmed
+    trimmed.delete()
+    expect(Array.from(opentimelineio.transformed_time_many(second, track, [100], 24))).toEqual([58])
+
+    // Changing the children.
+    track.remove_child(0)
+    expect(Array.from(opentimelineio.transformed_time_many(second, track, [100], 24))).toEqual([10])
+    expect(opentimelineio.transformed_time_cache_size()).toEqual(1)
+
+    first.delete()
+    second.delete()
+    track.delete()
+})
@@ -0,0 +1,229 @@
+const opentimelineioFactory = require('../../install/opentimelineio');
+const { expect, test, beforeAll } = require('@jest/globals');
+
+/**
+ * @type {opentimelineioFactory.CustomEmbindModule}
+ */
+let opentimelineio;
+
+beforeAll(async () => {
+    opentimelineio = await opentimelineioFactory();
+});
+
+function registerType(name, version) {
+    var klass = opentimelineio.SerializableObject.extend('SerializableObject', {
+        __construct: function () {
+            this.__parent.__construct.call(this);
+            opentimelineio.set_type_record(this, name)
+        }
+    });
+    opentimelineio.register_serializable_object_type(klass, name, version)
+}
+
+test('test_upgrade_operations', () => {
+    registerType('MigratedOps', 3)
+
+    opentimelineio.register_upgrade_operations('MigratedOps', 2, [
+        { op: 'rename', field: 'old_name', to: 'name' },
+        { op: 'move', field: 'info.shot', to: 'studio.shot.id' },
+        { op: 'drop', field: 'obsolete' },
+    ])
+    opentimelineio.register_upgrade_operations('MigratedOps', 3, [
+        { op: 'default', field: 'rate', value: 23.976 },
+        { op: 'default', field: 'studio.shot.id', value: 'unused' },
+        { op: 'drop', field: 'info' },
+    ])
+
+    const so = opentimelineio.SerializableObject.from_json_string(JSON.stringify({
+        'OTIO_SCHEMA': 'MigratedOps.1',
+        'old_name': 'a',
+        'obsolete': true,
+        'info': { 'shot': 'sh010', 'other': 1 }
+    }))
+
+    expect(JSON.parse(so.to_json_string(4))).toEqual({
+        'OTIO_SCHEMA': 'MigratedOps.3',
+        'name': 'a',
+        'rate': 23.976,
+        'studio': { 'shot': { 'id': 'sh010' } }
+    })
+    so.delete()
+
+    // Only one upgrade function can be registered per version.
+    expect(() => opentimelineio.register_upgrade_operations('MigratedOps', 3, [])).toThrow()
+
+    expect(() => opentimelineio.register_upgrade_operations('MigratedOps', 4, [{ op: 'nope', field: 'a' }])).toThrow()
+    expect(() => opentimelineio.register_upgrade_operations('MigratedOps', 4, [{ op: 'rename', field: 'a', to: 'b.c' }])).toThrow()
+    expect(() => opentimelineio.register_upgrade_operations('MigratedOps', 4, [{ op: 'drop', field: 'a..b' }])).toThrow()
+})
+
+test('test_downgrade_operations', () => {
+    registerType('DowngradedOps', 2)
+
+    opentimelineio.register_downgrade_operations('DowngradedOps', 2, [
+        { op: 'rename', field: 'name', to: 'old_name' },
+    ])
+
+    const so = opentimelineio.SerializableObject.from_json_string(JSON.stringify({
+        'OTIO_SCHEMA': 'DowngradedOps.2',
+        'name': 'a'
+    }))
+
+    const downgraded = opentimelineio.serialize_json_to_string(so, { schema_version_target: { 'DowngradedOps': 1 } })
+    expect(JSON.parse(downgraded)).toEqual({
+        'OTIO_SCHEMA': 'DowngradedOps.1',
+        'old_name': 'a'
+    })
+    so.delete()
+})
+
+test('test_upgrade_function', () => {
+    registerType('MigratedCallback', 2)
+
+    opentimelineio.register_upgrade_function('MigratedCallback', 2, (data) => {
+        data['names'] = data['name'].split(',')
+        delete data['name']
+    })
+
+    const so = opentimelineio.SerializableObject.from_json_string(JSON.stringify({
+        'OTIO_SCHEMA': 'MigratedCallback.1',
+        'name': 'a,b'
+    }))
+
+    expect(JSON.parse(so.to_json_string(4))).toEqual({
+        'OTIO_SCHEMA': 'MigratedCallback.2',
+        'names': ['a', 'b']
+    })
+    so.delete()
+
+    expect(() => opentimelineio.register_upgrade_function('MigratedCallback', 3, 'not a function')).toThrow()
+})
+
+test('test_upgrade_function_field_types', () => {
+    registerType('MigratedTypes', 2)
+
+    opentimelineio.register_upgrade_function('MigratedTypes', 2, (data) => {
+        data['frames'].push(4)
+        data['scale'] = data['scale'] * 2
+        data['nested']['offsets'] = data['nested']['offsets'].map((v) => v + 0.5)
+    })
+
+    // Written by hand, JSON.stringify would write 2.0 as 2.
+    const so = opentimelineio.SerializableObject.from_json_string(`{
+        "OTIO_SCHEMA": "MigratedTypes.1",
+        "scale": 1.25,
+        "ratio": 2.0,
+        "count": 3,
+        "frames": [1, 2.5, "three"],
+        "nested": { "offsets": [0.25, 1] }
+    }`)
+
+    expect(JSON.parse(so.to_json_string(4))).toEqual({
+        'OTIO_SCHEMA': 'MigratedTypes.2',
+        'scale': 2.5,
+        'ratio': 2.0,
+        'count': 3,
+        'frames': [1, 2.5, 'three', 4],
+        'nested': { 'offsets': [0.75, 1.5] },
+    })
+    // Whole doubles stay doubles.
+    expect(so.to_json_string(4)).toMatch(/"ratio": 2\.0/)
+    so.delete()
+})
+
+test('test_upgrade_function_int64', () => {
+    registerType('MigratedInt64', 2)
+
+    opentimelineio.register_upgrade_function('MigratedInt64', 2, (data) => {
+        data['big'] = data['big'] + 1
+        data['small'] = data['small'] + 1
+    })
+
+    const so = opentimelineio.SerializableObject.from_json_string(JSON.stringify({
+        'OTIO_SCHEMA': 'MigratedInt64.1',
+        'big': 3000000000,
+        'small': 1
+    }))
+
+    // Integers past the range of int stay integers.
+    expect(so.to_json_string(4)).toMatch(/"big": 3000000001[,\s]/)
+    expect(so.to_json_string(4)).toMatch(/"small": 2[,\s]/)
+    so.delete()
+})
+
+test('test_upgrade_function_throws', () => {
+    registerType('MigratedThrows', 2)
+
+    opentimelineio.register_upgrade_function('MigratedThrows', 2, () => {
+        throw new Error('upgrade failed')
+    })
+
+    expect(() => opentimelineio.SerializableObject.from_json_string(JSON.stringify({
+        'OTIO_SCHEMA': 'MigratedThrows.1',
+        'name': 'a'
+    }))).toThrow()
+})
+
+test('test_declared_schema', () => {
+    opentimelineio.register_declared_schema('StudioShot', 1, {
+        'shot_id': 'string',
+        'frame_count': 'int',
+        'fps': { type: 'double', default: 24 },
+        'approved': { type: 'bool', default: false },
+        'tags': 'list',
+        'extra': { type: 'dictionary', default: { 'department': 'comp' } },
+    }, true)
+
+    const collection = opentimelineio.SerializableObject.from_json_string(JSON.stringify({
+        'OTIO_SCHEMA': 'SerializableCollection.1',
+        'name': 'shots',
+        'metadata': {},
+        'children': [
+            { 'OTIO_SCHEMA': 'StudioShot.1', 'name': 'a', 'metadata': {}, 'shot_id': 'sh010', 'frame_count': 10 },
+            { 'OTIO_SCHEMA': 'StudioShot.1', 'name': 'b', 'metadata': {}, 'approved': true },
+        ]
+    }))
+
+    const children = JSON.parse(collection.to_json_string(4))['children']
+    expect(children[0]).toEqual({
+        'OTIO_SCHEMA': 'StudioShot.1',
+        'name': 'a',
+        'metadata': {},
+        'shot_id': 'sh010',
+        'frame_count': 10,
+        'fps': 24,
+        'approved': false,
+        'tags': [],
+        'extra': { 'department': 'comp' },
+    })
+    expect(children[1]['approved']).toBe(true)
+    expect(children[1]['shot_id']).toEqual('')
+    collection.delete()
+
+    expect(() => opentimelineio.register_declared_schema('StudioShot', 1, {}, false)).toThrow()
+    expect(() => opentimelineio.register_declared_schema('BadFieldType', 1, { 'a': 'float128' }, false)).toThrow()
+    expect(() => opentimelineio.register_declared_schema('ReservedName', 1, { 'name': 'string' }, true)).toThrow()
+    expect(() => opentimelineio.register_declared_schema('ReservedMetadata', 1, { 'metadata': 'dictionary' }, true)).toThrow()
+})
+
+test('test_declared_schema_field_types', () => {
+    opentimelineio.register_declared_schema('StudioTake', 1, {
+        'take': 'int',
+        'fps': 'double',
+        'name': 'string',
+    }, false)
+
+    // Integers are accepted for double fields.
+    const take = opentimelineio.SerializableObject.from_json_string(JSON.stringify({
+        'OTIO_SCHEMA': 'StudioTake.1', 'take': 3, 'fps': 24, 'name': 'a',
+    }))
+    expect(take.to_json_string(4)).toMatch(/"fps": 24\.0/)
+    take.delete()
+
+    expect(() => opentimelineio.SerializableObject.from_json_string(JSON.stringify({
+        'OTIO_SCHEMA': 'StudioTake.1', 'take': 'three',
+    }))).toThrow()
+    expect(() => opentimelineio.SerializableObject.from_json_string(JSON.stringify({
+        'OTIO_SCHEMA': 'StudioTake.1', 'fps': '24',
+    }))).toThrow()
+})
@@ -0,0 +1,86 @@
+const opentimelineioFactory = require('../../install/opentimelineio');
+const { expect, test, beforeAll } = require('@jest/globals');
+const { clip, load, timeline, track } = require('./fixtures');
+
+/**
+ * @type {opentimelineioFactory.CustomEmbindModule}
+ */
+let opentimelineio;
+
+
+beforeAll(async () => {
+    opentimelineio = await opentimelineioFactory();
+});
+
+function makeTimeline() {
+    return load(opentimelineio, timeline([
+        track('V1', [clip('a'), clip('b')]),
+        track('V2', [clip('c')]),
+    ]))
+}
+
+function walk(timeline) {
+    const wrappers = [timeline.tracks()]
+    const tracks = timeline.tracks().get_children()
+    for (let i = 0; i < tracks.size(); i++) {
+        const track = tracks.get(i)
+        wrappers.push(track)
+        const clips = track.get_children()
+        for (let j = 0; j < clips.size(); j++) {
+            const clip = clips.get(j)
+            wrappers.push(clip, clip.parent(), clip.media_reference())
+        }
+        clips.delete()
+    }
+    tracks.delete()
+    return wrappers
+}
+
+test('test_wrapper_identity', () => {
+    const timeline = makeTimeline()
+    const first = walk(timeline)
+    const size = opentimelineio.wrapper_cache_size()
+    const hits = opentimelineio.wrapper_cache_hits()
+
+    // Walking the tree again returns the same wrappers.
+    const second = walk(timeline)
+    expect(second.length).toEqual(first.length)
+    for (let i = 0; i < first.length; i++) {
+        expect(second[i]).toBe(first[i])
+    }
+    expect(opentimelineio.wrapper_cache_size()).toEqual(size)
+    // Plus the stack that get_children() is called on.
+    expect(opentimelineio.wrapper_cache_hits() - hits).toEqual(second.length + 1)
+
+    const track = first[1]
+    const clip = first[2]
+    expect(clip.parent()).toBe(track)
+
+    timeline.delete()
+})
+
+test('test_wrapper_delete', () => {
+    const timeline = makeTimeline()
+    const tracks = timeline.tracks().get_children()
+    const track = tracks.get(0)
+    const clips = track.get_children()
+    const clip = clips.get(0)
+
+    // The wrapper is only deleted by the last delete() of its owners.
+    const parent = clip.parent()
+    expect(parent).toBe(track)
+    parent.delete()
+    expect(track.isDeleted()).toBe(false)
+    track.delete()
+    expect(track.isDeleted()).toBe(true)
+
+    // A deleted wrapper is replaced by a new one.
+    const replaced = clip.parent()
+    expect(replaced).not.toBe(track)
+    expect(replaced.name).toEqual('V1')
+    expect(clip.parent()).toBe(replaced)
+
+    clips.delete()
+    tracks.delete()
+    timeline.delete()
+})
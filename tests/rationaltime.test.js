@@ -88,6 +88,56 @@ test('comparison', () => {
     expect(t1.lessThanOrEqual(t2)).toBeFalsy()
 })
 
+test('operators', () => {
+    const t1 = new lib.RationalTime(10, 24)
+    const t2 = new lib.RationalTime(5, 24)
+    expect(t1.add(t2).value).toEqual(15)
+    expect(t1.subtract(t2).value).toEqual(5)
+
+    // Both the typed and dynamic paths must agree.
+    expect(t1._add_dynamic(t2).equal(t1._add_typed(t2))).toBe(true)
+    expect(t1._lessThan_dynamic(t2)).toEqual(t1._lessThan_typed(t2))
+
+    expect(t1.compoundAdd(t2).value).toEqual(15)
+    expect(t1.compoundSubstract(t2).value).toEqual(5)
+    expect(t1._compoundAdd_dynamic(t2).equal(t1._compoundAdd_typed(t2))).toBe(true)
+    expect(() => t1.compoundAdd(5)).toThrow()
+
+    // Foreign operands go through the dynamic path and raise a TypeError.
+    expect(() => t1.add(5)).toThrow()
+    expect(() => t1.lessThan('foo')).toThrow()
+    const range = new lib.TimeRange()
+    expect(() => t1.equal(range)).toThrow()
+    range.delete()
+})
+
+test('try_timecode', () => {
+    const ok = lib.RationalTime.try_from_timecode('00:06:56:17', 24)
+    expect(ok.ok).toBe(true)
+    expect(ok.status).toEqual(0)
+    expect(ok.value.equal(lib.RationalTime.from_timecode('00:06:56:17', 24))).toBe(true)
+    expect(ok.value.try_to_timecode()).toEqual({ ok: true, value: '00:06:56:17', status: 0, details: '' })
+
+    const bogus = lib.RationalTime.try_from_timecode('pink elephants', 13)
+    expect(bogus.ok).toBe(false)
+    expect(bogus.value).toBeNull()
+    expect(bogus.status).not.toEqual(0)
+    expect(bogus.details).not.toEqual('')
+
+    const negative = new lib.RationalTime(-1, 25).try_to_timecode(25, lib.IsDropFrameRate.InferFromRate)
+    expect(negative.ok).toBe(false)
+
+    expect(lib.RationalTime.try_from_time_string('00:00:01.0', 24).value.value).toEqual(24)
+
+    const values = new Float64Array(3)
+    const statuses = new Int32Array(3)
+    const errors = lib.RationalTime.try_from_timecodes(['00:00:01:00', 'bogus', '00:00:00:12'], 24, values, statuses)
+    expect(errors).toEqual(1)
+    expect(values[0]).toEqual(24)
+    expect(values[2]).toEqual(12)
+    expect(Array.from(statuses).map((s) => s === 0)).toEqual([true, false, true])
+})
+
 //     def test_copy(self):
 //         t1 = otio.opentime.RationalTime(18, 24)
 
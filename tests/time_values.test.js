@@ -0,0 +1,62 @@
+/* global process */
+const factory = require('../install/opentime');
+const { expect, test, beforeAll } = require('@jest/globals');
+
+/**
+ * @type {factory.CustomEmbindModule}
+ */
+let lib;
+
+beforeAll(async () => {
+    lib = await factory();
+});
+
+// These tests only apply to builds made with TIME_VALUE_TYPES=ON.
+function valueTypesOnly(name, callback) {
+    test(name, () => {
+        if (lib.time_representation() !== 'value') {
+            return
+        }
+        callback()
+    })
+}
+
+test('time_representation', () => {
+    expect(['class', 'value']).toContain(lib.time_representation())
+    // Set by CI when it runs these tests against a TIME_VALUE_TYPES=ON build.
+    if (process.env.OTIO_JS_TIME_VALUE_TYPES === 'ON') {
+        expect(lib.time_representation()).toEqual('value')
+    }
+})
+
+valueTypesOnly('rational_time_values', () => {
+    const t1 = lib.RationalTime(10, 24)
+    expect(t1).toEqual({ value: 10, rate: 24 })
+    expect(Object.isFrozen(t1)).toBe(true)
+    expect(new lib.RationalTime()).toEqual({ value: 0, rate: 1 })
+
+    const t2 = lib.RationalTime.add(t1, lib.RationalTime(5, 24))
+    expect(t2).toEqual({ value: 15, rate: 24 })
+    expect(lib.RationalTime.lessThan(t1, t2)).toBe(true)
+    expect(lib.RationalTime.rescaled_to(t1, 48)).toEqual({ value: 20, rate: 48 })
+    expect(lib.RationalTime.to_timecode(lib.RationalTime.from_timecode('00:06:56:17', 24))).toEqual('00:06:56:17')
+    expect(() => lib.RationalTime.from_timecode('pink elephants', 13)).toThrow()
+})
+
+valueTypesOnly('time_range_values', () => {
+    const range = lib.TimeRange(lib.RationalTime(0, 24), lib.RationalTime(48, 24))
+    expect(lib.TimeRange()).toEqual({ start_time: { value: 0, rate: 1 }, duration: { value: 0, rate: 1 } })
+    expect(lib.TimeRange.end_time_exclusive(range)).toEqual({ value: 48, rate: 24 })
+    expect(lib.TimeRange.contains_time(range, lib.RationalTime(12, 24))).toBe(true)
+    expect(lib.TimeRange.clamped_time(range, lib.RationalTime(100, 24))).toEqual({ value: 47, rate: 24 })
+
+    const other = lib.TimeRange(lib.RationalTime(24, 24), lib.RationalTime(48, 24))
+    expect(lib.TimeRange.overlaps(range, other)).toBe(true)
+    expect(lib.TimeRange.extended_by(range, other)).toEqual({
+        start_time: { value: 0, rate: 24 },
+        duration: { value: 72, rate: 24 }
+    })
+
+    const transform = lib.TimeTransform(lib.RationalTime(10, 24), 2)
+    expect(lib.TimeTransform.applied_to_time(transform, lib.RationalTime(1, 24))).toEqual({ value: 12, rate: 24 })
+})
@@ -0,0 +1,114 @@
+const factory = require('../install/opentime');
+const { expect, test, beforeAll } = require('@jest/globals');
+
+/**
+ * @type {factory.CustomEmbindModule}
+ */
+let lib;
+
+beforeAll(async () => {
+    lib = await factory();
+});
+
+// Same as opentime's DEFAULT_EPSILON_s.
+const epsilon = 1 / (2 * 192000)
+
+function range(start, duration, rate = 24) {
+    return new lib.TimeRange(new lib.RationalTime(start, rate), new lib.RationalTime(duration, rate))
+}
+
+test('create', () => {
+    const buffer = lib.TimeRangeBuffer.from_arrays([0, 10, 20], [5, 5, 5], 24)
+    expect(buffer.length).toEqual(3)
+    expect(Array.from(buffer.starts())).toEqual([0, 10, 20])
+    expect(Array.from(buffer.rates())).toEqual([24, 24, 24])
+    expect(buffer.at(1).equal(range(10, 5))).toBe(true)
+    expect(() => buffer.at(3)).toThrow()
+
+    // Durations are stored in the rate of the start time.
+    buffer.push(new lib.TimeRange(new lib.RationalTime(48, 48), new lib.RationalTime(1, 24)))
+    expect(buffer.durations()[3]).toEqual(2)
+
+    expect(() => lib.TimeRangeBuffer.from_arrays([0, 1], [1], 24)).toThrow()
+    buffer.delete()
+})
+
+test('pairwise', () => {
+    const lhs = lib.TimeRangeBuffer.from_arrays([0, 10, 20], [5, 5, 5], 24)
+    const rhs = lib.TimeRangeBuffer.from_arrays([4, 15, 21], [5, 5, 2], 24)
+
+    expect(Array.from(lhs.overlaps_pairwise(rhs, epsilon))).toEqual([1, 0, 1])
+    expect(Array.from(lhs.contains_pairwise(rhs, epsilon))).toEqual([0, 0, 1])
+    for (let i = 0; i < lhs.length; i++) {
+        expect(lhs.overlaps_pairwise(rhs, 0)[i] === 1).toEqual(lhs.at(i).overlaps(rhs.at(i), 0))
+        expect(lhs.intersects_pairwise(rhs, 0)[i] === 1).toEqual(lhs.at(i).intersects(rhs.at(i), 0))
+    }
+
+    const clamped = lhs.clamped_pairwise(rhs)
+    for (let i = 0; i < lhs.length; i++) {
+        expect(clamped.at(i).equal(lhs.at(i).clamped(rhs.at(i)))).toBe(true)
+    }
+    clamped.delete()
+
+    const intersection = lhs.intersection_pairwise(rhs)
+    expect(Array.from(intersection.starts())).toEqual([4, 15, 21])
+    expect(Array.from(intersection.durations())).toEqual([1, 0, 2])
+    intersection.delete()
+
+    lhs.delete()
+    rhs.delete()
+})
+
+test('against_range', () => {
+    const buffer = lib.TimeRangeBuffer.from_arrays([0, 10, 20], [5, 5, 5], 24)
+    expect(Array.from(buffer.overlaps_range(range(8, 4), epsilon))).toEqual([0, 1, 0])
+    expect(Array.from(buffer.contains_time(new lib.RationalTime(22, 24)))).toEqual([0, 0, 1])
+
+    const limits = range(2, 20)
+    const clamped = buffer.clamped_to(limits)
+    for (let i = 0; i < buffer.length; i++) {
+        expect(clamped.at(i).equal(buffer.at(i).clamped(limits))).toBe(true)
+    }
+    clamped.delete()
+    buffer.delete()
+})
+
+test('overlapping_pairs', () => {
+    const lhs = lib.TimeRangeBuffer.from_arrays([30, 0, 10], [5, 12, 5], 24)
+    const rhs = lib.TimeRangeBuffer.from_arrays([11, 100, 0, 31], [1, 1, 1, 1], 24)
+
+    const pairs = lhs.overlapping_pairs(rhs, 0)
+    const found = []
+    for (let k = 0; k < pairs.length; k += 2) {
+        found.push([pairs[k], pairs[k + 1]])
+    }
+
+    // Compare with the brute force result.
+    const expected = []
+    for (let i = 0; i < lhs.length; i++) {
+        for (let j = 0; j < rhs.length; j++) {
+            if (lhs.at(i).overlaps(rhs.at(j), 0)) {
+                expected.push([i, j])
+            }
+        }
+    }
+    const byPair = (a, b) => a[0] - b[0] || a[1] - b[1]
+    expect(found.sort(byPair)).toEqual(expected.sort(byPair))
+
+    lhs.delete()
+    rhs.delete()
+})
+
+test('sort_and_merge', () => {
+    const buffer = lib.TimeRangeBuffer.from_arrays([20, 0, 3, 10, 15], [5, 5, 4, 5, 1], 24)
+    expect(Array.from(buffer.sorted_indices())).toEqual([1, 2, 3, 4, 0])
+
+    const merged = buffer.merged(0)
+    expect(Array.from(merged.starts())).toEqual([0, 10, 20])
+    expect(Array.from(merged.durations())).toEqual([7, 6, 5])
+    merged.delete()
+
+    buffer.sort()
+    expect(Array.from(buffer.starts())).toEqual([0, 3, 10, 15, 20])
+    buffer.delete()
+})
@@ -0,0 +1,68 @@
+const factory = require('../install/opentime');
+const { expect, test, beforeAll } = require('@jest/globals');
+
+/**
+ * @type {factory.CustomEmbindModule}
+ */
+let lib;
+
+beforeAll(async () => {
+    lib = await factory();
+});
+
+test('applied_to_many', () => {
+    const tt = new lib.TimeTransform(new lib.RationalTime(10, 24), 2)
+    const values = new Float64Array([0, 1, 2.5, -4])
+
+    const expected = Array.from(values).map((v) => tt.applied_to(new lib.RationalTime(v, 24)).value)
+    expect(Array.from(tt.applied_to_many(values, 24))).toEqual(expected)
+    // The input is not modified.
+    expect(Array.from(values)).toEqual([0, 1, 2.5, -4])
+
+    // Results are in the rate of the transform when it has one.
+    const rescaling = new lib.TimeTransform(new lib.RationalTime(0, 24), 1, 48)
+    expect(Array.from(rescaling.applied_to_many([1, 2], 24))).toEqual([2, 4])
+
+    // Without a rate, results are in the larger of the input and offset rates.
+    const offset48 = new lib.TimeTransform(new lib.RationalTime(10, 48), 2)
+    const at48 = [0, 1, 2.5].map((v) => offset48.applied_to(new lib.RationalTime(v, 24)))
+    expect(at48.map((t) => t.rate)).toEqual([48, 48, 48])
+    expect(Array.from(offset48.applied_to_many([0, 1, 2.5], 24))).toEqual(at48.map((t) => t.value))
+
+    // In place.
+    expect(tt.applied_to_many(values, 24, values)).toBe(values)
+    expect(Array.from(values)).toEqual(expected)
+
+    expect(() => tt.applied_to_many(values, 24, new Float64Array(1))).toThrow()
+})
+
+test('compose', () => {
+    const a = new lib.TimeTransform(new lib.RationalTime(10, 24), 2)
+    const b = new lib.TimeTransform(new lib.RationalTime(5, 24), 0.5)
+    const c = new lib.TimeTransform(new lib.RationalTime(1, 24), 3)
+    const chain = (t) => a.applied_to(b.applied_to(c.applied_to(t)))
+
+    // The composed transform is the same as applying the chain in sequence.
+    const composed = lib.TimeTransform.compose([a, b, c])
+    expect(composed.applied_to(new lib.RationalTime(0, 24)).value).toEqual(21)
+    for (const value of [0, 1, 12.5, -24]) {
+        const t = new lib.RationalTime(value, 24)
+        expect(composed.applied_to(t).value).toBeCloseTo(chain(t).value)
+    }
+    expect(lib.TimeTransform.compose([]).equal(new lib.TimeTransform())).toBe(true)
+    expect(lib.TimeTransform.compose([c]).equal(c)).toBe(true)
+
+    // The rate is the one of the outermost transform that has one.
+    const rescaling = new lib.TimeTransform(new lib.RationalTime(0, 48), 1, 48)
+    const rescaled = lib.TimeTransform.compose([a, rescaling, c])
+    expect(rescaled.rate).toEqual(48)
+    const t = new lib.RationalTime(12, 24)
+    expect(rescaled.applied_to(t).value)
+        .toBeCloseTo(a.applied_to(rescaling.applied_to(c.applied_to(t))).value)
+
+    const values = [0, 12, 24]
+    const composedValues = Array.from(lib.TimeTransform.applied_to_many_composed([a, b, c], values, 24))
+    for (let i = 0; i < values.length; i++) {
+        expect(composedValues[i]).toBeCloseTo(chain(new lib.RationalTime(values[i], 24)).value)
+    }
+})